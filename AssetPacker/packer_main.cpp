@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+//           Name: packer_main.cpp
+//    Description: Data 폴더들을 하나의 에셋 팩(.pak)으로 묶는 오프라인 도구
+//-----------------------------------------------------------------------------
+// 사용법: AssetPacker [-o 출력=../Data/Assets.pak] [Data 폴더 ... (기본 ../Data Data)]
+//   폴더 아래 모든 파일을 하위 폴더까지 "Data/<상대 경로>" 키로 넣음 (.pak 제외).
+//   같은 키가 여러 폴더에 있으면 앞 폴더 것을 쓰고, 내용이 같은 파일은 한 번만 저장.
+//   TextureBaker 의 Cache/*.txc 도 함께 들어가므로 팩을 만들기 전에 굽는 것을 권장.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include "mapped_file.h"
+#include "asset_pack.h"
+
+static std::string ToLower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+// dir 아래 모든 파일의 상대 경로 ('/' 구분, 이름순)
+static void ListFilesRecursive(const std::string& dir, const std::string& prefix, std::vector<std::string>& out)
+{
+    std::vector<std::string> files, dirs;
+#ifdef _WIN32
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA((dir + "\\*").c_str(), &fd);
+    if (h != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (fd.cFileName[0] == '.') continue;
+            if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) dirs.push_back(fd.cFileName);
+            else files.push_back(fd.cFileName);
+        } while (FindNextFileA(h, &fd));
+        FindClose(h);
+    }
+#else
+    DIR* d = opendir(dir.c_str());
+    if (d)
+    {
+        while (dirent* e = readdir(d))
+        {
+            if (e->d_name[0] == '.') continue;
+            struct stat st;
+            if (stat((dir + "/" + e->d_name).c_str(), &st) != 0) continue;
+            if (S_ISDIR(st.st_mode)) dirs.push_back(e->d_name);
+            else files.push_back(e->d_name);
+        }
+        closedir(d);
+    }
+#endif
+
+    std::sort(files.begin(), files.end());
+    std::sort(dirs.begin(), dirs.end());
+    for (auto& f : files) out.push_back(prefix + f);
+    for (auto& sub : dirs) ListFilesRecursive(dir + "/" + sub, prefix + sub + "/", out);
+}
+
+int main(int argc, char** argv)
+{
+    std::string output = "../Data/Assets.pak";
+    std::vector<std::string> roots;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) output = argv[++i];
+        else roots.push_back(argv[i]);
+    }
+    if (roots.empty())
+    {
+        roots.push_back("../Data");
+        roots.push_back("Data");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    AssetPackWriter writer;
+    int failed = 0;
+    for (auto& root : roots)
+    {
+        std::vector<std::string> files;
+        ListFilesRecursive(root, "", files);
+        printf("%s: %zu files\n", root.c_str(), files.size());
+
+        for (auto& rel : files)
+        {
+            std::string ext = ToLower(rel.substr(rel.find_last_of('.') == std::string::npos ? rel.size() : rel.find_last_of('.')));
+            if (ext == ".pak") continue;
+
+            MappedFile file;
+            std::string path = root + "/" + rel;
+            if (!file.open(path.c_str()))
+            {
+                // 빈 파일은 매핑할 수 없으므로 빈 항목으로
+                FILE* fp = fopen(path.c_str(), "rb");
+                if (!fp)
+                {
+                    printf("  %-32s FAILED\n", rel.c_str());
+                    failed++;
+                    continue;
+                }
+                fclose(fp);
+                writer.add(("Data/" + rel).c_str(), NULL, 0, path.c_str());
+                continue;
+            }
+            writer.add(("Data/" + rel).c_str(), file.data(), file.size(), path.c_str());
+        }
+    }
+
+    if (!writer.write(output.c_str()))
+    {
+        printf("failed to write %s\n", output.c_str());
+        return 1;
+    }
+
+    const AssetPackWriter::Stats& s = writer.stats();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("%s: %zu names, %zu unique blobs, %.1f MB read -> %.1f MB stored (%zu same-name duplicates, %zu conflicts) %.0f ms\n",
+           output.c_str(), s.entries, s.uniqueEntries, s.inputBytes / 1048576.0, s.uniqueBytes / 1048576.0,
+           s.sameNameSkipped, s.conflicts, ms);
+    return failed ? 1 : 0;
+}
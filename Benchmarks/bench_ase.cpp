@@ -0,0 +1,139 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_ase.cpp
+//    Description: ASE 파싱 처리량(MB/s) 및 정점 용접 결과
+//-----------------------------------------------------------------------------
+// Data 폴더의 .ASE 파일 각각에 대해:
+//   baseline : getline + istringstream 으로 읽고 면 모서리마다 정점을 펼치는 단순 구현
+//   loader   : AseLoader (매핑 + 포인터 토큰 + 해시 용접)
+// 정점 수는 펼친 모서리 수 -> 용접 후 정점 수로 표시합니다.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include "bench_common.h"
+#include "ase_loader.h"
+
+// 단순 구현: 행 단위로 키워드를 비교해 위치 목록과 면 목록을 모은 뒤 삼각형 수프로 펼침
+static size_t BaselineLoadAse(const std::string& path, std::vector<float>& soup)
+{
+    std::ifstream in(path.c_str());
+    std::string line;
+    std::vector<float> positions, tverts;
+    std::vector<unsigned int> faces, tfaces;
+    while (std::getline(in, line))
+    {
+        std::istringstream ss(line);
+        std::string key;
+        ss >> key;
+        if (key == "*MESH_VERTEX")
+        {
+            int i;
+            float x, y, z;
+            ss >> i >> x >> y >> z;
+            positions.push_back(x); positions.push_back(z); positions.push_back(-y);
+        }
+        else if (key == "*MESH_FACE")
+        {
+            std::string label;
+            unsigned int a, b, c;
+            ss >> label >> label >> a >> label >> b >> label >> c;
+            faces.push_back(a); faces.push_back(b); faces.push_back(c);
+        }
+        else if (key == "*MESH_TVERT")
+        {
+            int i;
+            float u, v, w;
+            ss >> i >> u >> v >> w;
+            tverts.push_back(u); tverts.push_back(v);
+        }
+        else if (key == "*MESH_TFACE")
+        {
+            int i;
+            unsigned int a, b, c;
+            ss >> i >> a >> b >> c;
+            tfaces.push_back(a); tfaces.push_back(b); tfaces.push_back(c);
+        }
+    }
+
+    soup.clear();
+    for (size_t i = 0; i < faces.size(); i++)
+    {
+        if ((size_t)faces[i] * 3 + 2 >= positions.size()) return 0;
+        soup.insert(soup.end(), &positions[faces[i] * 3], &positions[faces[i] * 3] + 3);
+        if (i < tfaces.size() && (size_t)tfaces[i] * 2 + 1 < tverts.size())
+            soup.insert(soup.end(), &tverts[tfaces[i] * 2], &tverts[tfaces[i] * 2] + 2);
+        else
+        {
+            soup.push_back(0.0f);
+            soup.push_back(0.0f);
+        }
+    }
+    return faces.size() / 3;
+}
+
+static size_t FileSize(const std::string& path)
+{
+    MappedFile f;
+    return f.open(path.c_str()) ? f.size() : 0;
+}
+
+int BenchAse(const std::string& dataDir)
+{
+    std::vector<std::string> files = ListFiles(dataDir, ".ase");
+    if (files.empty())
+    {
+        printf("no .ASE files in %s\n", dataDir.c_str());
+        return 1;
+    }
+
+    const int iterations = 10;
+    int failures = 0;
+
+    printf("%-16s %7s %7s %6s | %10s %10s | %9s %9s\n", "file", "MB", "tris", "parts",
+           "baseline", "loader", "corners", "welded");
+
+    for (auto& path : files)
+    {
+        double mb = FileSize(path) / (1024.0 * 1024.0);
+
+        double baselineMs = 1e30;
+        size_t baselineTris = 0;
+        for (int i = 0; i < iterations; i++)
+        {
+            std::vector<float> soup;
+            BenchTimer t;
+            baselineTris = BaselineLoadAse(path, soup);
+            baselineMs = std::min(baselineMs, t.ms());
+        }
+
+        ModelMesh mesh;
+        double loaderMs = 1e30;
+        for (int i = 0; i < iterations; i++)
+        {
+            BenchTimer t;
+            if (AseLoader::load(path.c_str(), mesh) != AseLoader::ASE_NO_ERROR) { failures++; break; }
+            loaderMs = std::min(loaderMs, t.ms());
+        }
+        if (mesh.triangleCount() != baselineTris)
+        {
+            printf("%s: triangle count differs from baseline (%zu vs %zu)\n", path.c_str(), mesh.triangleCount(), baselineTris);
+            failures++;
+        }
+        for (size_t i = 0; i < mesh.indices.size(); i++)
+        {
+            if (mesh.indices[i] >= mesh.vertexCount())
+            {
+                printf("%s: index out of range\n", path.c_str());
+                failures++;
+                break;
+            }
+        }
+
+        std::string name = path.substr(path.find_last_of('/') + 1);
+        printf("%-16s %7.2f %7zu %6zu | %5.1f MB/s %5.1f MB/s | %9zu %9zu\n", name.c_str(), mb, mesh.triangleCount(),
+               mesh.subMeshes.size(), mb / (baselineMs / 1000.0), mb / (loaderMs / 1000.0), mesh.indices.size(), mesh.vertexCount());
+    }
+    return failures;
+}
@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_bmp.cpp
+//    Description: 기존 LoadBMP(fread + BGR->RGB 스왑) 와 메모리 매핑 BmpView 비교
+//-----------------------------------------------------------------------------
+// 두 경로 모두 "glTexImage2D 에 넘길 수 있는 픽셀이 준비될 때까지" 의 시간을 잽니다.
+// 매핑 경로는 페이지를 한 번씩 건드려서 실제 디스크/캐시 읽기 비용을 포함시킵니다.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include "bench_common.h"
+#include "bmp_view.h"
+
+// 변경 전 main.cpp 의 LoadBMP 그대로 (비교 기준)
+static unsigned char* LegacyLoadBMP(const char* filename, int* width, int* height)
+{
+    FILE* file = fopen(filename, "rb");
+    if (!file) return NULL;
+    unsigned char header[54];
+    if (fread(header, 1, 54, file) != 54) { fclose(file); return NULL; }
+    *width = *(int*)&(header[0x12]);
+    *height = *(int*)&(header[0x16]);
+    int imageSize = *(int*)&(header[0x22]);
+    if (imageSize == 0) imageSize = (*width) * (*height) * 3;
+    unsigned char* data = new unsigned char[imageSize];
+    fread(data, 1, imageSize, file);
+    fclose(file);
+    for (int i = 0; i < imageSize - 2; i += 3) {
+        unsigned char temp = data[i]; data[i] = data[i + 2]; data[i + 2] = temp;
+    }
+    return data;
+}
+
+static unsigned int TouchPages(const unsigned char* p, size_t size)
+{
+    unsigned int sum = 0;
+    for (size_t i = 0; i < size; i += 4096) sum += p[i];
+    return sum;
+}
+
+int BenchBmp(const std::string& dataDir)
+{
+    std::vector<std::string> files = ListFiles(dataDir, ".bmp");
+    if (files.empty())
+    {
+        printf("No .bmp files found in %s\n", dataDir.c_str());
+        return 1;
+    }
+
+    const int ITERATIONS = 20;
+    double legacyTotal = 0.0, mappedTotal = 0.0;
+    size_t totalBytes = 0;
+    unsigned int sink = 0;
+
+    printf("%-28s %11s %11s %11s %8s\n", "file", "size", "legacy ms", "mapped ms", "speedup");
+    for (const auto& path : files)
+    {
+        BmpView probe;
+        if (probe.open(path.c_str()) != BmpView::BMP_NO_ERROR)
+        {
+            printf("%-28s (skipped: unsupported)\n", path.c_str());
+            continue;
+        }
+        size_t bytes = probe.pixelBytes();
+
+        // 각 경로의 최솟값(캐시가 따뜻한 상태)을 비교
+        double legacyBest = 1e30, mappedBest = 1e30;
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            BenchTimer t;
+            int w, h;
+            unsigned char* data = LegacyLoadBMP(path.c_str(), &w, &h);
+            if (data) sink += data[0];
+            delete[] data;
+            legacyBest = std::min(legacyBest, t.ms());
+
+            t.reset();
+            BmpView bmp;
+            if (bmp.open(path.c_str()) == BmpView::BMP_NO_ERROR)
+            {
+                bmp.normalize();
+                sink += TouchPages(bmp.pixels(), bmp.pixelBytes());
+            }
+            mappedBest = std::min(mappedBest, t.ms());
+        }
+
+        size_t slash = path.find_last_of("/\\");
+        printf("%-28s %8zu KB %11.3f %11.3f %7.2fx\n", path.substr(slash + 1).c_str(), bytes / 1024,
+               legacyBest, mappedBest, legacyBest / std::max(mappedBest, 1e-6));
+        legacyTotal += legacyBest;
+        mappedTotal += mappedBest;
+        totalBytes += bytes;
+    }
+
+    double mb = totalBytes / (1024.0 * 1024.0);
+    printf("total %.1f MB: legacy %.2f ms (%.0f MB/s), mapped %.2f ms (%.0f MB/s), %.2fx\n",
+           mb, legacyTotal, mb / (legacyTotal / 1000.0), mappedTotal, mb / (mappedTotal / 1000.0),
+           legacyTotal / std::max(mappedTotal, 1e-6));
+    printf("(checksum %u)\n", sink);
+    return 0;
+}
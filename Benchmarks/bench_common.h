@@ -0,0 +1,77 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_common.h
+//    Description: 벤치마크 공용 유틸 (타이머, 파일 목록)
+//-----------------------------------------------------------------------------
+
+#ifndef BENCH_COMMON_H_INCLUDED
+#define BENCH_COMMON_H_INCLUDED
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+// 벤치마크 함수: 데이터 폴더 경로를 받아 결과를 출력, 실패 시 0이 아닌 값 반환
+typedef int (*BenchFunc)(const std::string& dataDir);
+
+class BenchTimer
+{
+public:
+    BenchTimer() { reset(); }
+    void reset() { m_start = std::chrono::steady_clock::now(); }
+    double ms() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count(); }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// dir 안에서 확장자가 ext 인 파일 경로 목록 (대소문자 무시, 이름순)
+inline std::vector<std::string> ListFiles(const std::string& dir, const std::string& ext)
+{
+    std::vector<std::string> files;
+    std::string lowerExt = ext;
+    std::transform(lowerExt.begin(), lowerExt.end(), lowerExt.begin(), ::tolower);
+
+    std::vector<std::string> names;
+#ifdef _WIN32
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA((dir + "\\*").c_str(), &fd);
+    if (h != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) names.push_back(fd.cFileName);
+        } while (FindNextFileA(h, &fd));
+        FindClose(h);
+    }
+#else
+    DIR* d = opendir(dir.c_str());
+    if (d)
+    {
+        while (dirent* e = readdir(d))
+            if (e->d_name[0] != '.') names.push_back(e->d_name);
+        closedir(d);
+    }
+#endif
+
+    for (auto& name : names)
+    {
+        if (name.size() < lowerExt.size()) continue;
+        std::string tail = name.substr(name.size() - lowerExt.size());
+        std::transform(tail.begin(), tail.end(), tail.begin(), ::tolower);
+        if (tail == lowerExt) files.push_back(dir + "/" + name);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+#endif // BENCH_COMMON_H_INCLUDED
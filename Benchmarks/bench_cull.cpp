@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_cull.cpp
+//    Description: 경계 구 + AABB 절두체 컬링 처리량 (ns / 오브젝트)
+//-----------------------------------------------------------------------------
+// 200 x 200 월드에 무작위 크기/위치 경계 256K 개를 흩어 두고, 원점에서 +z 를 보는 60도 절두체
+// (가까운 0.1, 먼 100) 로 CullSet::cull 을 경로별로 반복합니다. 방을 키웠을 때 매 프레임 드는 비용.
+//   scalar : 칸 하나씩
+//   sse2   : 4칸씩
+//   avx2   : 8칸씩 (CPU 가 지원할 때만)
+// 보이는 칸 목록은 세 경로가 같아야 함. 마지막 열은 60 Hz 프레임에 한 코어로 컬링할 수 있는 오브젝트 수.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "bench_common.h"
+#include "frustum_cull.h"
+
+// gluPerspective + 원점에서 +z 를 보는 카메라 평면 (안쪽이 양수)
+static void MakeFrustum(float planes[6][4])
+{
+    const float halfFov = 30.0f * 3.14159265f / 180.0f, aspect = 1.25f, zNear = 0.1f, zFar = 100.0f;
+    float ty = tanf(halfFov), tx = ty * aspect;
+    const float p[6][4] =
+    {
+        { 1.0f, 0.0f, tx, 0.0f }, { -1.0f, 0.0f, tx, 0.0f },    // 왼, 오른
+        { 0.0f, 1.0f, ty, 0.0f }, { 0.0f, -1.0f, ty, 0.0f },    // 아래, 위
+        { 0.0f, 0.0f, 1.0f, -zNear }, { 0.0f, 0.0f, -1.0f, zFar }
+    };
+    memcpy(planes, p, sizeof(p));
+}
+
+int BenchCull(const std::string&)
+{
+    const CpuFeatures& cpu = CpuFeatures::get();
+    printf("cpu: sse2=%d avx2=%d\n", cpu.sse2, cpu.avx2);
+
+    const int count = 1 << 18;
+    CullSet set;
+    unsigned int seed = 2024;
+    for (int i = 0; i < count; i++)
+    {
+        float v[4];
+        for (int k = 0; k < 4; k++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            v[k] = (seed >> 8) / 16777216.0f;
+        }
+        float center[3] = { -100.0f + 200.0f * v[0], -10.0f + 20.0f * v[1], -100.0f + 200.0f * v[2] };
+        float half = 0.25f + 2.0f * v[3];
+        float boxMin[3] = { center[0] - half, center[1] - half, center[2] - half };
+        float boxMax[3] = { center[0] + half, center[1] + half, center[2] + half };
+        set.set(set.add(), center, half * 1.7320508f, boxMin, boxMax);
+    }
+
+    float planes[6][4];
+    MakeFrustum(planes);
+
+    const CullSet::Path paths[3] = { CullSet::PATH_SCALAR, CullSet::PATH_SSE2, CullSet::PATH_AVX2 };
+    std::vector<unsigned char> reference(count), visible(count);
+    int failures = 0;
+    printf("%-8s %10s %12s %14s\n", "path", "visible", "ns/object", "objects/16ms");
+    for (int p = 0; p < 3; p++)
+    {
+        if (paths[p] == CullSet::PATH_SSE2 && !cpu.sse2) continue;
+        if (paths[p] == CullSet::PATH_AVX2 && !cpu.avx2) continue;
+
+        const int iterations = 20;
+        double best = 1e30;
+        size_t n = 0;
+        for (int it = 0; it < iterations; it++)
+        {
+            BenchTimer t;
+            n = set.cull(planes, (p == 0 ? reference : visible).data(), paths[p]);
+            best = std::min(best, t.ms());
+        }
+        if (p > 0 && visible != reference)
+        {
+            printf("%s: visibility differs from scalar\n", CullSet::pathName(paths[p]));
+            failures++;
+        }
+        double ns = best * 1e6 / count;
+        printf("%-8s %10zu %12.2f %13.1fM\n", CullSet::pathName(paths[p]), n, ns, 16.7e6 / ns / 1e6);
+    }
+    return failures;
+}
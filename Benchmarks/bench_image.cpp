@@ -0,0 +1,161 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_image.cpp
+//    Description: 픽셀 변환 커널(스칼라 vs SIMD) 및 TGA/PPM 디코딩 시간 비교
+//-----------------------------------------------------------------------------
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "tga.h"
+#include "ppm.h"
+
+// 변경 전 tga.h 의 getRGBA 방식 (fread 후 픽셀 단위 스왑, 비교 기준)
+static unsigned char* LegacyLoadTGA32(const char* name, int* w, int* h)
+{
+    FILE* s = fopen(name, "rb");
+    if (!s) return NULL;
+    unsigned char header[18];
+    if (fread(header, 1, 18, s) != 18 || header[2] != 2 || header[16] != 32) { fclose(s); return NULL; }
+    *w = header[12] + header[13] * 256;
+    *h = header[14] + header[15] * 256;
+    fseek(s, 18 + header[0], SEEK_SET);
+
+    int size = (*w) * (*h);
+    unsigned char* rgba = (unsigned char*)malloc(size * 4);
+    if ((int)fread(rgba, 1, size * 4, s) != size * 4) { free(rgba); fclose(s); return NULL; }
+    fclose(s);
+    for (int i = 0; i < size * 4; i += 4)
+    {
+        unsigned char temp = rgba[i];
+        rgba[i] = rgba[i + 2];
+        rgba[i + 2] = temp;
+    }
+    return rgba;
+}
+
+static double BestOf(int iterations, void (*fn)(void*), void* arg)
+{
+    double best = 1e30;
+    for (int i = 0; i < iterations; i++)
+    {
+        BenchTimer t;
+        fn(arg);
+        best = std::min(best, t.ms());
+    }
+    return best;
+}
+
+struct KernelArgs
+{
+    std::vector<unsigned char>* src;
+    std::vector<unsigned char>* dst;
+    size_t pixels;
+};
+
+static void RunSwap24Scalar(void* a) { KernelArgs* k = (KernelArgs*)a; PixelConvert::SwapRB24Scalar(k->src->data(), k->dst->data(), k->pixels); }
+static void RunSwap24(void* a)       { KernelArgs* k = (KernelArgs*)a; PixelConvert::SwapRB24(k->src->data(), k->dst->data(), k->pixels); }
+static void RunSwap32Scalar(void* a) { KernelArgs* k = (KernelArgs*)a; PixelConvert::SwapRB32Scalar(k->src->data(), k->dst->data(), k->pixels); }
+static void RunSwap32(void* a)       { KernelArgs* k = (KernelArgs*)a; PixelConvert::SwapRB32(k->src->data(), k->dst->data(), k->pixels); }
+static void RunGrayScalar(void* a)   { KernelArgs* k = (KernelArgs*)a; PixelConvert::ExpandGrayScalar(k->src->data(), k->dst->data(), k->pixels, 4); }
+static void RunGray(void* a)         { KernelArgs* k = (KernelArgs*)a; PixelConvert::ExpandGray(k->src->data(), k->dst->data(), k->pixels, 4); }
+
+int BenchImage(const std::string& dataDir)
+{
+    const CpuFeatures& cpu = CpuFeatures::get();
+    printf("cpu: ssse3=%d sse4.1=%d avx2=%d fma=%d\n", cpu.ssse3, cpu.sse41, cpu.avx2, cpu.fma);
+
+    // 1) 커널 단독 (1024x1024)
+    const size_t PIXELS = 1024 * 1024;
+    std::vector<unsigned char> src(PIXELS * 4), dst(PIXELS * 4), ref(PIXELS * 4);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (unsigned char)(i * 131 + 7);
+    KernelArgs args = { &src, &dst, PIXELS };
+
+    struct { const char* name; void (*scalar)(void*); void (*simd)(void*); size_t bytes; } kernels[] =
+    {
+        { "swap BGR->RGB",     RunSwap24Scalar, RunSwap24, PIXELS * 3 },
+        { "swap BGRA->RGBA",   RunSwap32Scalar, RunSwap32, PIXELS * 4 },
+        { "gray->RGBA",        RunGrayScalar,   RunGray,   PIXELS * 4 },
+    };
+
+    int failures = 0;
+    printf("%-18s %10s %10s %8s\n", "kernel (1 Mpx)", "scalar ms", "simd ms", "speedup");
+    for (auto& k : kernels)
+    {
+        double scalar = BestOf(20, k.scalar, &args);
+        ref = dst;
+        double simd = BestOf(20, k.simd, &args);
+        bool same = memcmp(ref.data(), dst.data(), k.bytes) == 0;
+        failures += !same;
+        printf("%-18s %10.3f %10.3f %7.2fx%s\n", k.name, scalar, simd, scalar / std::max(simd, 1e-6), same ? "" : "  MISMATCH");
+    }
+
+    // 2) 나무 TGA: 디코딩 단계(메모리 상의 BGRA -> RGBA) 와 파일 로드 전체를 따로 측정
+    printf("\n%-18s %11s %11s %8s %11s %11s\n", "tga file", "legacy dec", "simd dec", "speedup", "legacy load", "new load");
+    std::vector<std::string> tgas = ListFiles(dataDir, ".tga");
+    for (const auto& path : tgas)
+    {
+        MappedFile file;
+        if (!file.open(path.c_str()) || file.size() < 18) continue;
+        const unsigned char* header = file.data();
+        int w = header[12] + header[13] * 256, h = header[14] + header[15] * 256;
+        if (header[2] != 2 || header[16] != 32) continue;
+        const unsigned char* pixels = header + 18 + header[0];
+        size_t bytes = (size_t)w * h * 4;
+        if (18 + header[0] + bytes > file.size()) continue;
+
+        std::vector<unsigned char> out(bytes);
+        double legacyDec = 1e30, simdDec = 1e30, legacyLoad = 1e30, newLoad = 1e30;
+        bool same = true;
+        for (int i = 0; i < 20; i++)
+        {
+            // 기존: 버퍼로 복사(fread) 후 픽셀 단위 스왑
+            BenchTimer t;
+            memcpy(out.data(), pixels, bytes);
+            for (size_t k = 0; k < bytes; k += 4)
+            {
+                unsigned char temp = out[k];
+                out[k] = out[k + 2];
+                out[k + 2] = temp;
+            }
+            legacyDec = std::min(legacyDec, t.ms());
+            std::vector<unsigned char> ref = out;
+
+            // 신규: 매핑된 원본에서 결과 버퍼로 한 번에 스왑
+            t.reset();
+            PixelConvert::SwapRB32(pixels, out.data(), (size_t)w * h);
+            simdDec = std::min(simdDec, t.ms());
+            if (i == 0) same = (ref == out);
+
+            t.reset();
+            int lw = 0, lh = 0;
+            unsigned char* legacy = LegacyLoadTGA32(path.c_str(), &lw, &lh);
+            legacyLoad = std::min(legacyLoad, t.ms());
+            free(legacy);
+
+            t.reset();
+            tgaImageFile tga;
+            if (tga.load(path.c_str()) != tgaImageFile::TGA_NO_ERROR) same = false;
+            newLoad = std::min(newLoad, t.ms());
+        }
+        failures += !same;
+        size_t slash = path.find_last_of("/\\");
+        printf("%-18s %11.3f %11.3f %7.2fx %11.3f %11.3f%s\n", path.substr(slash + 1).c_str(), legacyDec, simdDec,
+               legacyDec / std::max(simdDec, 1e-6), legacyLoad, newLoad, same ? "" : "  MISMATCH");
+    }
+
+    // 3) PPM
+    std::string ppmPath = dataDir + "/wood.ppm";
+    double ppmBest = 1e30;
+    ppmImageFile ppm;
+    for (int i = 0; i < 20; i++)
+    {
+        BenchTimer t;
+        if (ppm.load(ppmPath.c_str()) != ppmImageFile::PPM_NO_ERROR) { printf("\nwood.ppm: load failed\n"); return 1; }
+        ppmBest = std::min(ppmBest, t.ms());
+    }
+    printf("\nwood.ppm %dx%d: %.3f ms\n", ppm.m_nImageWidth, ppm.m_nImageHeight, ppmBest);
+    return failures;
+}
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_jpeg.cpp
+//    Description: JPEG 디코딩 처리량 (DCT 영역 축소 1/1 ~ 1/8) 과 밉 꼬리까지 걸리는 시간
+//-----------------------------------------------------------------------------
+// Planets 폴더의 모든 JPEG 를 scale 1/2/4/8 로 디코딩해서 원본 메가픽셀/초를 잽니다.
+// 축소 디코딩 결과는 풀 해상도 결과를 같은 비율로 평균낸 것과 비슷해야 함 (평균 절대 오차로 확인).
+// 1/8 은 DC = 블록 평균이라 거의 같고, 1/2 와 1/4 는 박스 평균이 아닌 저역 통과라 세밀한 그림에서 몇 단계 차이남.
+// 마지막으로 밉 스트리밍의 첫 화면 비용 (가장 작은 변형의 1/8) 과 4k 변형을 통째로 디코딩하는 비용을 비교.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <math.h>
+#include "bench_common.h"
+#include "jpeg_decoder.h"
+
+// full (w x h) 을 scale 배 평균 축소한 것과 reduced 의 평균 절대 오차
+static double ReducedError(const std::vector<unsigned char>& full, int w, int h, const std::vector<unsigned char>& reduced,
+                           int rw, int rh, int channels, int scale)
+{
+    double error = 0.0;
+    for (int y = 0; y < rh; y++)
+    {
+        for (int x = 0; x < rw; x++)
+        {
+            for (int c = 0; c < channels; c++)
+            {
+                int sum = 0, n = 0;
+                for (int sy = y * scale; sy < std::min(h, (y + 1) * scale); sy++)
+                    for (int sx = x * scale; sx < std::min(w, (x + 1) * scale); sx++, n++)
+                        sum += full[((size_t)sy * w + sx) * channels + c];
+                error += fabs((double)sum / n - reduced[((size_t)y * rw + x) * channels + c]);
+            }
+        }
+    }
+    return error / ((double)rw * rh * channels);
+}
+
+// 파일 하나를 scale 로 디코딩하는 최단 시간 (ms)
+static double DecodeMs(const std::string& path, int scale, std::vector<unsigned char>& out, int& w, int& h, int iterations)
+{
+    double best = 1e30;
+    for (int it = 0; it < iterations; it++)
+    {
+        BenchTimer t;
+        JpegDecoder jpeg;
+        if (jpeg.open(path.c_str()) != JpegDecoder::JPEG_NO_ERROR) return -1.0;
+        if (jpeg.decode(scale, out, w, h) != JpegDecoder::JPEG_NO_ERROR) return -1.0;
+        best = std::min(best, t.ms());
+    }
+    return best;
+}
+
+int BenchJpeg(const std::string& dataDir)
+{
+    std::vector<std::string> files = ListFiles(dataDir + "/Planets", ".jpg");
+    if (files.empty())
+    {
+        printf("no .jpg files in %s/Planets\n", dataDir.c_str());
+        return 1;
+    }
+
+    int failures = 0;
+    printf("%-28s %11s %10s %10s %10s %10s %8s\n", "file", "size", "1/1", "1/2", "1/4", "1/8", "err 1/8");
+    for (const auto& path : files)
+    {
+        JpegDecoder jpeg;
+        if (jpeg.open(path.c_str()) != JpegDecoder::JPEG_NO_ERROR)
+        {
+            printf("%s: header error\n", path.c_str());
+            failures++;
+            continue;
+        }
+        int channels = jpeg.components();
+        double mpix = (double)jpeg.width() * jpeg.height() / 1e6;
+
+        std::vector<unsigned char> full;
+        int fw = 0, fh = 0;
+        double rates[4];
+        double error = 0.0;
+        for (int s = 0; s < 4; s++)
+        {
+            int scale = 1 << s;
+            std::vector<unsigned char> out;
+            int w, h;
+            double ms = DecodeMs(path, scale, out, w, h, 3);
+            if (ms < 0.0)
+            {
+                printf("%s: decode error at 1/%d\n", path.c_str(), scale);
+                failures++;
+                break;
+            }
+            rates[s] = mpix / (ms / 1000.0);
+            if (scale == 1)
+            {
+                full.swap(out);
+                fw = w;
+                fh = h;
+            }
+            else
+            {
+                double e = ReducedError(full, fw, fh, out, w, h, channels, scale);
+                if (e > 12.0)
+                {
+                    printf("%s: 1/%d differs from averaged full decode (mean abs %.2f)\n", path.c_str(), scale, e);
+                    failures++;
+                }
+                error = e;
+            }
+        }
+
+        std::string name = path.substr(path.find_last_of("/\\") + 1);
+        char size[32];
+        snprintf(size, sizeof(size), "%dx%dx%d", jpeg.width(), jpeg.height(), channels);
+        printf("%-28s %11s %6.1f M/s %6.1f M/s %6.1f M/s %6.1f M/s %8.2f\n", name.c_str(), size, rates[0], rates[1], rates[2], rates[3], error);
+    }
+
+    // 밉 스트리밍의 첫 화면: 1k 변형 1/8 (꼬리) vs 4k 변형 전체
+    const char* chains[][2] = { { "Jupiter2_1k.jpg", "Jupiter2_4k.jpg" }, { "Moon_Bump_1k.jpg", "Moon_Bump_4k.jpg" } };
+    printf("%-20s %14s %14s %8s\n", "first pixels", "tail (1k 1/8)", "eager (4k)", "ratio");
+    for (auto& chain : chains)
+    {
+        std::vector<unsigned char> out;
+        int w, h;
+        double tailMs = DecodeMs(dataDir + "/Planets/" + chain[0], 8, out, w, h, 3);
+        double eagerMs = DecodeMs(dataDir + "/Planets/" + chain[1], 1, out, w, h, 1);
+        if (tailMs < 0.0 || eagerMs < 0.0)
+        {
+            printf("%s: decode error\n", chain[1]);
+            failures++;
+            continue;
+        }
+        std::string name = chain[1];
+        printf("%-20s %11.2f ms %11.2f ms %7.1fx\n", name.substr(0, name.size() - 7).c_str(), tailMs, eagerMs, eagerMs / tailMs);
+    }
+    return failures;
+}
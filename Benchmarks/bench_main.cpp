@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_main.cpp
+//    Description: 마이크로벤치마크 실행기
+//                 사용법: Benchmarks [이름|all] [데이터 폴더 (기본 ../Data)]
+//-----------------------------------------------------------------------------
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <string.h>
+#include "bench_common.h"
+
+int BenchBmp(const std::string& dataDir);
+int BenchImage(const std::string& dataDir);
+int BenchPly(const std::string& dataDir);
+int BenchAse(const std::string& dataDir);
+int BenchMorph(const std::string& dataDir);
+int BenchTerrain(const std::string& dataDir);
+int BenchWater(const std::string& dataDir);
+int BenchJpeg(const std::string& dataDir);
+int BenchPack(const std::string& dataDir);
+int BenchCull(const std::string& dataDir);
+int BenchPortal(const std::string& dataDir);
+
+struct BenchEntry
+{
+    const char* name;
+    BenchFunc func;
+};
+
+static const BenchEntry g_benches[] =
+{
+    { "bmp", BenchBmp },
+    { "image", BenchImage },
+    { "ply", BenchPly },
+    { "ase", BenchAse },
+    { "morph", BenchMorph },
+    { "terrain", BenchTerrain },
+    { "water", BenchWater },
+    { "jpeg", BenchJpeg },
+    { "pack", BenchPack },
+    { "cull", BenchCull },
+    { "portal", BenchPortal },
+};
+
+int main(int argc, char** argv)
+{
+    const char* which = (argc > 1) ? argv[1] : "all";
+    std::string dataDir = (argc > 2) ? argv[2] : "../Data";
+
+    int failures = 0;
+    bool found = false;
+    for (const auto& b : g_benches)
+    {
+        if (strcmp(which, "all") != 0 && strcmp(which, b.name) != 0) continue;
+        found = true;
+        printf("==== %s ====\n", b.name);
+        failures += (b.func(dataDir) != 0);
+    }
+
+    if (!found)
+    {
+        printf("Unknown benchmark '%s'. Available:", which);
+        for (const auto& b : g_benches) printf(" %s", b.name);
+        printf("\n");
+        return 1;
+    }
+    return failures;
+}
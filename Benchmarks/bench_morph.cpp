@@ -0,0 +1,121 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_morph.cpp
+//    Description: 모프 타깃 섞기 처리량 (초당 섞은 정점 수)
+//-----------------------------------------------------------------------------
+// Sphere/Torus/Tube.txt 를 타깃으로, 인스턴스마다 다른 가중치로 전부 섞습니다.
+//   scalar : MorphBlend::BlendScalar
+//   simd   : MorphBlend::Blend (AVX2+FMA 가 있으면 그 경로)
+// 타깃 2개(인접 두 모양 사이)와 3개(전부) 두 경우를 잽니다. 결과는 두 경로가 같아야 함.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <math.h>
+#include "bench_common.h"
+#include "morph_targets.h"
+
+// 인스턴스 하나를 스칼라 커널로 (MorphTargets::blend 와 같은 평면 순서)
+static void BlendInstanceScalar(const MorphTargets& m, const float* weights, const float offset[3], float* out)
+{
+    const float* planes[3][MorphBlend::MAX_TARGETS];
+    for (int t = 0; t < m.targetCount(); t++)
+        for (int k = 0; k < 3; k++) planes[k][t] = m.plane(t, k);
+    for (int k = 0; k < 3; k++)
+        MorphBlend::BlendScalar(planes[k], weights, m.targetCount(), offset[k], out + k * m.paddedCount(), m.paddedCount());
+}
+
+int BenchMorph(const std::string& dataDir)
+{
+    MorphTargets morph;
+    const char* names[] = { "Sphere.txt", "Torus.txt", "Tube.txt" };
+    for (auto name : names)
+    {
+        if (!morph.load((dataDir + "/" + name).c_str()))
+        {
+            printf("failed to load %s/%s\n", dataDir.c_str(), name);
+            return 1;
+        }
+    }
+
+    const CpuFeatures& cpu = CpuFeatures::get();
+    printf("cpu: avx2=%d fma=%d, %d targets x %zu vertices (padded %zu)\n",
+           cpu.avx2, cpu.fma, morph.targetCount(), morph.vertexCount(), morph.paddedCount());
+
+    const int instances = 4096;
+    const int iterations = 5;
+    size_t planeSize = morph.paddedCount() * 3;
+    std::vector<float> outScalar(planeSize * instances), outSimd(planeSize * instances);
+    int failures = 0;
+
+    printf("%-10s %14s %14s %8s\n", "targets", "scalar", "simd", "speedup");
+    for (int active = 2; active <= 3; active++)
+    {
+        // 인스턴스마다 가중치 (active == 2 면 세 번째는 0 -> blend 가 건너뜀)
+        std::vector<float> weights(instances * 3);
+        for (int i = 0; i < instances; i++)
+        {
+            float a = 0.25f + 0.5f * (float)((i * 37) % 101) / 100.0f;
+            weights[i * 3] = a;
+            weights[i * 3 + 1] = (active == 2) ? 1.0f - a : (1.0f - a) * 0.5f;
+            weights[i * 3 + 2] = (active == 2) ? 0.0f : (1.0f - a) * 0.5f;
+        }
+
+        double scalarMs = 1e30, simdMs = 1e30;
+        for (int it = 0; it < iterations; it++)
+        {
+            BenchTimer t;
+            for (int i = 0; i < instances; i++)
+            {
+                // 가중치 0 인 타깃을 빼는 것은 blend 와 같게: active 개만
+                float offset[3] = { (float)(i % 64), 0.0f, (float)(i / 64) };
+                const float* planes[3][MorphBlend::MAX_TARGETS];
+                for (int tgt = 0; tgt < active; tgt++)
+                    for (int k = 0; k < 3; k++) planes[k][tgt] = morph.plane(tgt, k);
+                for (int k = 0; k < 3; k++)
+                    MorphBlend::BlendScalar(planes[k], &weights[i * 3], active, offset[k], &outScalar[i * planeSize + k * morph.paddedCount()], morph.paddedCount());
+            }
+            scalarMs = std::min(scalarMs, t.ms());
+        }
+        for (int it = 0; it < iterations; it++)
+        {
+            BenchTimer t;
+            for (int i = 0; i < instances; i++)
+            {
+                float offset[3] = { (float)(i % 64), 0.0f, (float)(i / 64) };
+                float* out = &outSimd[i * planeSize];
+                morph.blend(&weights[i * 3], offset, out, out + morph.paddedCount(), out + morph.paddedCount() * 2);
+            }
+            simdMs = std::min(simdMs, t.ms());
+        }
+
+        // FMA 는 반올림이 한 번 적어서 비트 단위로는 다를 수 있음
+        float maxDiff = 0.0f;
+        for (size_t i = 0; i < outSimd.size(); i++) maxDiff = std::max(maxDiff, fabsf(outSimd[i] - outScalar[i]));
+        if (maxDiff > 1e-4f)
+        {
+            printf("targets %d: simd result differs (max %g)\n", active, maxDiff);
+            failures++;
+        }
+
+        // 섞은 정점 수 = 인스턴스 x 실제 정점 수 (패딩 제외)
+        double verts = (double)instances * morph.vertexCount();
+        printf("%-10d %9.1f M/s %9.1f M/s %7.2fx\n", active,
+               verts / (scalarMs / 1000.0) / 1e6, verts / (simdMs / 1000.0) / 1e6, scalarMs / simdMs);
+    }
+
+    // 한 인스턴스 전체 경로 (가중치 0 건너뛰기 포함) 가 스칼라 기준과 같은지
+    float w[3] = { 0.2f, 0.0f, 0.8f }, offset[3] = { 1.0f, 2.0f, 3.0f };
+    std::vector<float> a(planeSize), b(planeSize);
+    BlendInstanceScalar(morph, w, offset, a.data());
+    morph.blend(w, offset, b.data(), b.data() + morph.paddedCount(), b.data() + morph.paddedCount() * 2);
+    for (size_t i = 0; i < planeSize; i++)
+    {
+        if (fabsf(a[i] - b[i]) > 1e-4f)
+        {
+            printf("blend() differs from scalar reference at %zu\n", i);
+            failures++;
+            break;
+        }
+    }
+    return failures;
+}
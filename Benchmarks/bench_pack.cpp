@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_pack.cpp
+//    Description: 파일별 매핑 vs 에셋 팩 찾기 (파일 하나 열어서 첫 페이지를 읽기까지)
+//-----------------------------------------------------------------------------
+// 데이터 폴더(하위 폴더 포함)를 메모리에서 팩으로 만들어 임시 파일에 쓰고
+//   files : 경로마다 realpath 정규화 (TextureRegistry) + MappedFile::open + 첫 바이트 읽기
+//   pack  : 팩 열기 한 번 + 경로마다 AssetPack::KeyFor (TextureRegistry 키) + find + 첫 바이트 읽기
+// 를 비교합니다. 두 경로로 읽은 내용은 같아야 함. 표기가 다른 경로("Data/x", "..\\DATA\\X")도 확인.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_common.h"
+#include "asset_pack.h"
+
+static std::string Realpath(const std::string& path)
+{
+    char buf[4096];
+#ifdef _WIN32
+    return _fullpath(buf, path.c_str(), sizeof(buf)) ? buf : path;
+#else
+    return realpath(path.c_str(), buf) ? buf : path;
+#endif
+}
+
+int BenchPack(const std::string& dataDir)
+{
+    // ListFiles 는 한 폴더만 보므로 알려진 하위 폴더를 더함
+    std::vector<std::string> files;
+    const char* dirs[] = { "", "/Planets", "/bunny" };
+    for (auto d : dirs)
+    {
+        for (auto& name : ListFiles(dataDir + d, ""))
+            if (name.size() < 4 || name.compare(name.size() - 4, 4, ".pak") != 0) files.push_back(name);
+    }
+
+    AssetPackWriter writer;
+    for (auto& path : files)
+    {
+        MappedFile file;
+        if (file.open(path.c_str())) writer.add(("Data" + path.substr(dataDir.size())).c_str(), file.data(), file.size(), path.c_str());
+    }
+    std::string packPath = dataDir + "/bench_tmp.pak";
+    if (!writer.write(packPath.c_str()))
+    {
+        printf("failed to write %s\n", packPath.c_str());
+        return 1;
+    }
+    printf("%zu files, %.1f MB -> %.1f MB unique\n", writer.stats().entries, writer.stats().inputBytes / 1048576.0,
+           writer.stats().uniqueBytes / 1048576.0);
+
+    int failures = 0;
+    const int iterations = 20;
+    double filesMs = 1e30, packMs = 1e30, openMs = 1e30;
+    size_t sinkFiles = 0, sinkPack = 0;
+    for (int it = 0; it < iterations; it++)
+    {
+        BenchTimer t;
+        sinkFiles = 0;
+        for (auto& path : files)
+        {
+            std::string key = Realpath(path);
+            MappedFile file;
+            if (file.open(path.c_str())) sinkFiles += file.data()[0] + file.size();
+        }
+        filesMs = std::min(filesMs, t.ms());
+    }
+    for (int it = 0; it < iterations; it++)
+    {
+        BenchTimer t;
+        AssetPack pack;
+        if (!pack.open(packPath.c_str()))
+        {
+            printf("failed to open %s\n", packPath.c_str());
+            remove(packPath.c_str());
+            return 1;
+        }
+        openMs = std::min(openMs, t.ms());
+        sinkPack = 0;
+        for (auto& path : files)
+        {
+            std::string key = AssetPack::KeyFor(path.c_str());
+            const unsigned char* data;
+            size_t size;
+            if (pack.find(path.c_str(), data, size)) sinkPack += data[0] + size;
+        }
+        packMs = std::min(packMs, t.ms());
+    }
+    if (sinkFiles != sinkPack)
+    {
+        printf("pack contents differ from files\n");
+        failures++;
+    }
+
+    double n = (double)files.size();
+    printf("%-8s %10s %12s\n", "", "total", "per file");
+    printf("%-8s %7.3f ms %9.2f us\n", "files", filesMs, filesMs * 1000.0 / n);
+    printf("%-8s %7.3f ms %9.2f us   (including pack open %.3f ms)\n", "pack", packMs, (packMs - openMs) * 1000.0 / n, openMs);
+    printf("speedup  %.1fx\n", filesMs / packMs);
+
+    // 내용 전체 비교 + 표기만 다른 경로
+    AssetPack pack;
+    pack.open(packPath.c_str());
+    for (auto& path : files)
+    {
+        MappedFile file;
+        const unsigned char* data;
+        size_t size;
+        if (!file.open(path.c_str())) continue;
+        if (!pack.find(path.c_str(), data, size) || size != file.size() || memcmp(data, file.data(), size) != 0)
+        {
+            printf("%s: pack entry differs\n", path.c_str());
+            failures++;
+        }
+    }
+    if (!pack.contains("..\\DATA\\Planets\\MOON_1K.JPG") || !pack.contains("Data/sky.bmp") || pack.contains("../Data/missing.bmp"))
+    {
+        printf("path normalization failed\n");
+        failures++;
+    }
+    pack.close();
+    remove(packPath.c_str());
+    return failures;
+}
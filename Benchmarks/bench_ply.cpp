@@ -0,0 +1,200 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_ply.cpp
+//    Description: PLY 파싱 처리량(MB/s) 및 바이너리 메쉬 캐시 로드 시간
+//-----------------------------------------------------------------------------
+// 버니 4단계 해상도 각각에 대해:
+//   baseline  : ifstream >> 로 읽는 단순 구현 (비교 기준)
+//   1 thread  : PlyLoader ASCII 파서, 스레드 1개
+//   N threads : PlyLoader ASCII 파서, 하드웨어 스레드 수
+//   binary    : 같은 메쉬를 binary_little_endian PLY 로 바꿔서 파싱
+//   cache     : .msh 캐시를 매핑해서 검증까지 (런타임에서 VBO 로 바로 올리는 경로)
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "bench_common.h"
+#include "ply_loader.h"
+#include "mesh_cache.h"
+
+// 단순 구현: 헤더에서 개수만 읽고 ifstream 으로 숫자를 하나씩
+static bool BaselineLoadPly(const std::string& path, std::vector<float>& positions, std::vector<unsigned int>& indices)
+{
+    std::ifstream in(path.c_str());
+    std::string line;
+    size_t vertexCount = 0, faceCount = 0;
+    int vertexProps = 0;
+    bool inVertex = false;
+    while (std::getline(in, line))
+    {
+        std::istringstream ss(line);
+        std::string word;
+        ss >> word;
+        if (word == "element")
+        {
+            std::string name;
+            size_t count;
+            ss >> name >> count;
+            inVertex = (name == "vertex");
+            if (inVertex) vertexCount = count;
+            else if (name == "face") faceCount = count;
+        }
+        else if (word == "property" && inVertex) vertexProps++;
+        else if (word == "end_header") break;
+    }
+
+    positions.resize(vertexCount * 3);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        float v;
+        for (int k = 0; k < vertexProps; k++)
+        {
+            in >> v;
+            if (k < 3) positions[i * 3 + k] = v;
+        }
+    }
+    indices.clear();
+    for (size_t i = 0; i < faceCount; i++)
+    {
+        int n;
+        in >> n;
+        std::vector<unsigned int> poly(n);
+        for (int j = 0; j < n; j++) in >> poly[j];
+        for (int j = 2; j < n; j++)
+        {
+            indices.push_back(poly[0]);
+            indices.push_back(poly[j - 1]);
+            indices.push_back(poly[j]);
+        }
+    }
+    return !in.fail();
+}
+
+// 파싱 결과를 binary_little_endian PLY 로 기록 (binary 경로 측정용)
+static bool WriteBinaryPly(const char* path, const PlyMesh& mesh)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp) return false;
+    fprintf(fp, "ply\nformat binary_little_endian 1.0\nelement vertex %u\nproperty float x\nproperty float y\nproperty float z\n"
+                "element face %u\nproperty list uchar int vertex_indices\nend_header\n",
+            (unsigned)mesh.vertexCount(), (unsigned)mesh.triangleCount());
+    for (size_t i = 0; i < mesh.vertexCount(); i++) fwrite(&mesh.vertices[i * 6], 4, 3, fp);
+    for (size_t t = 0; t < mesh.triangleCount(); t++)
+    {
+        unsigned char n = 3;
+        fwrite(&n, 1, 1, fp);
+        fwrite(&mesh.indices[t * 3], 4, 3, fp);
+    }
+    fclose(fp);
+    return true;
+}
+
+static bool SameMesh(const PlyMesh& a, const PlyMesh& b)
+{
+    return a.vertices == b.vertices && a.indices == b.indices;
+}
+
+static size_t FileSize(const std::string& path)
+{
+    MappedFile f;
+    return f.open(path.c_str()) ? f.size() : 0;
+}
+
+int BenchPly(const std::string& dataDir)
+{
+    std::vector<std::string> files = ListFiles(dataDir + "/bunny", ".ply");
+    if (files.empty())
+    {
+        printf("no .ply files in %s/bunny\n", dataDir.c_str());
+        return 1;
+    }
+
+    const char* tmpBinary = "bench_ply_binary.tmp";
+    const char* tmpCache = "bench_ply_cache.tmp";
+    int threads = (int)std::thread::hardware_concurrency();
+    const int iterations = 5;
+    int failures = 0;
+
+    printf("%-22s %9s %9s | %10s %10s %10s %10s | %9s\n", "file", "MB", "tris",
+           "baseline", "1 thread", "threads", "binary", "cache ms");
+
+    for (auto& path : files)
+    {
+        double mb = FileSize(path) / (1024.0 * 1024.0);
+
+        double baselineMs = 1e30;
+        for (int i = 0; i < iterations; i++)
+        {
+            std::vector<float> pos;
+            std::vector<unsigned int> idx;
+            BenchTimer t;
+            BaselineLoadPly(path, pos, idx);
+            baselineMs = std::min(baselineMs, t.ms());
+        }
+
+        PlyMesh single, multi;
+        double singleMs = 1e30, multiMs = 1e30;
+        for (int i = 0; i < iterations; i++)
+        {
+            BenchTimer t;
+            if (PlyLoader::load(path.c_str(), single, 1) != PlyLoader::PLY_NO_ERROR) { failures++; break; }
+            singleMs = std::min(singleMs, t.ms());
+        }
+        for (int i = 0; i < iterations; i++)
+        {
+            BenchTimer t;
+            if (PlyLoader::load(path.c_str(), multi, threads) != PlyLoader::PLY_NO_ERROR) { failures++; break; }
+            multiMs = std::min(multiMs, t.ms());
+        }
+        if (!SameMesh(single, multi))
+        {
+            printf("%s: single/multi-threaded results differ\n", path.c_str());
+            failures++;
+        }
+
+        // binary 는 파일 크기가 달라서 자기 크기 기준으로 MB/s
+        WriteBinaryPly(tmpBinary, multi);
+        double binaryMb = FileSize(tmpBinary) / (1024.0 * 1024.0);
+        PlyMesh binary;
+        double binaryMs = 1e30;
+        for (int i = 0; i < iterations; i++)
+        {
+            BenchTimer t;
+            if (PlyLoader::load(tmpBinary, binary) != PlyLoader::PLY_NO_ERROR) { failures++; break; }
+            binaryMs = std::min(binaryMs, t.ms());
+        }
+        if (binary.indices != multi.indices)
+        {
+            printf("%s: binary round trip differs\n", path.c_str());
+            failures++;
+        }
+
+        MeshCacheFile::Write(tmpCache, multi.vertices.data(), multi.vertexCount(), multi.indices.data(), multi.indices.size());
+        double cacheMs = 1e30;
+        for (int i = 0; i < iterations; i++)
+        {
+            BenchTimer t;
+            MappedFile f;
+            MeshCacheFile cache;
+            if (!f.open(tmpCache) || !cache.parse(f.data(), f.size())) { failures++; break; }
+            // 업로드 시 드라이버가 읽는 것과 같도록 전체를 한 번 훑음
+            volatile unsigned char sink = 0;
+            const unsigned char* p = (const unsigned char*)cache.vertices();
+            for (size_t j = 0; j < cache.vertexBytes() + cache.indexBytes(); j += 4096) sink ^= p[j];
+            (void)sink;
+            cacheMs = std::min(cacheMs, t.ms());
+        }
+
+        std::string name = path.substr(path.find_last_of('/') + 1);
+        printf("%-22s %9.2f %9zu | %5.1f MB/s %5.1f MB/s %5.1f MB/s %5.0f MB/s | %9.3f\n", name.c_str(), mb, multi.triangleCount(),
+               mb / (baselineMs / 1000.0), mb / (singleMs / 1000.0), mb / (multiMs / 1000.0), binaryMb / (binaryMs / 1000.0), cacheMs);
+    }
+
+    remove(tmpBinary);
+    remove(tmpCache);
+    printf("(%d threads)\n", threads);
+    return failures;
+}
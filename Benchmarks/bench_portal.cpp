@@ -0,0 +1,197 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_portal.cpp
+//    Description: 셀-포털 가시성 (생성한 방 격자에서 프레임당 PortalCells::update 비용)
+//-----------------------------------------------------------------------------
+// 한 변 10 인 방을 64 x 64 격자로 놓고, 이웃한 방 사이 벽 가운데에 폭 5 x 높이 3 문을 냅니다.
+// 문은 고정된 무작위로 열림/닫힘. 60도 절두체 (먼 500) 를 문 배치 씨앗 x 눈 위치 x 방향 여러 조합으로 놓고
+//   frustum : 절두체에 걸친 셀 수 (포털 없이 방 AABB 만 검사했을 때 그려야 할 방)
+//   portal  : 포털로 보이는 셀 수와 update() 시간
+// 의 평균을 열린 문 비율별로 비교합니다. 확인하는 것:
+//   포털로 보이는 셀은 모두 절두체에도 걸침, 같은 시점에서 문을 다 연 경우 보이는 셀의 부분집합,
+//   문이 전부 닫히면 눈이 있는 방 하나만, 일부만 열렸을 때 통과한 포털이 하나는 있음 (잘라내기/좁히기가 실제로 돎)
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "bench_common.h"
+#include "portal_cells.h"
+
+// yaw: +z 에서 +x 쪽으로 돈 각도 (도)
+static void MakeFrustum(const float eye[3], float yaw, float planes[6][4])
+{
+    const float halfFov = 30.0f * 3.14159265f / 180.0f, aspect = 1.25f, zNear = 0.1f, zFar = 500.0f;
+    float ty = tanf(halfFov), tx = ty * aspect;
+    float c = cosf(yaw * 3.14159265f / 180.0f), s = sinf(yaw * 3.14159265f / 180.0f);
+    // 원점에서 +z 를 보는 평면을 y 축으로 돌리고 eye 로 옮김 (d -= n . eye)
+    const float p[6][4] =
+    {
+        { 1.0f, 0.0f, tx, 0.0f }, { -1.0f, 0.0f, tx, 0.0f },
+        { 0.0f, 1.0f, ty, 0.0f }, { 0.0f, -1.0f, ty, 0.0f },
+        { 0.0f, 0.0f, 1.0f, -zNear }, { 0.0f, 0.0f, -1.0f, zFar }
+    };
+    for (int i = 0; i < 6; i++)
+    {
+        planes[i][0] = p[i][0] * c + p[i][2] * s;
+        planes[i][1] = p[i][1];
+        planes[i][2] = -p[i][0] * s + p[i][2] * c;
+        planes[i][3] = p[i][3] - (planes[i][0] * eye[0] + planes[i][1] * eye[1] + planes[i][2] * eye[2]);
+    }
+}
+
+static bool BoxInFrustum(const float planes[6][4], const float mn[3], const float mx[3])
+{
+    for (int i = 0; i < 6; i++)
+    {
+        const float* p = planes[i];
+        float x = (p[0] >= 0.0f) ? mx[0] : mn[0];
+        float y = (p[1] >= 0.0f) ? mx[1] : mn[1];
+        float z = (p[2] >= 0.0f) ? mx[2] : mn[2];
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) return false;
+    }
+    return true;
+}
+
+int BenchPortal(const std::string&)
+{
+    const int grid = 64;
+    const float size = 10.0f, half = 2.5f, height = 3.0f;
+
+    PortalCells cells;
+    std::vector<float> boxes;
+    for (int z = 0; z < grid; z++)
+    {
+        for (int x = 0; x < grid; x++)
+        {
+            float mn[3] = { x * size, 0.0f, z * size }, mx[3] = { (x + 1) * size, 4.0f, (z + 1) * size };
+            cells.addCell(mn, mx);
+            boxes.insert(boxes.end(), mn, mn + 3);
+            boxes.insert(boxes.end(), mx, mx + 3);
+        }
+    }
+    std::vector<int> portals;
+    for (int z = 0; z < grid; z++)
+    {
+        for (int x = 0; x < grid; x++)
+        {
+            int cell = z * grid + x;
+            if (x + 1 < grid)
+            {
+                float wx = (x + 1) * size, cz = (z + 0.5f) * size;
+                float q[12] = { wx, 0.0f, cz - half, wx, 0.0f, cz + half, wx, height, cz + half, wx, height, cz - half };
+                portals.push_back(cells.addPortal(cell, cell + 1, q, 4));
+            }
+            if (z + 1 < grid)
+            {
+                float wz = (z + 1) * size, cx = (x + 0.5f) * size;
+                float q[12] = { cx - half, 0.0f, wz, cx + half, 0.0f, wz, cx + half, height, wz, cx - half, height, wz };
+                portals.push_back(cells.addPortal(cell, cell + grid, q, 4));
+            }
+        }
+    }
+
+    // 가운데 근처 방들, 문 높이, 방 가운데에서 약간 비껴서
+    const float eyes[][3] =
+    {
+        { (grid / 2 + 0.45f) * size, 1.7f, (grid / 2 + 0.2f) * size },
+        { (grid / 2 - 5 + 0.3f) * size, 1.7f, (grid / 2 + 3 + 0.7f) * size },
+        { (grid / 2 + 7 + 0.6f) * size, 1.7f, (grid / 2 - 6 + 0.5f) * size },
+    };
+    const float yaws[] = { 0.0f, 35.0f, 90.0f, 210.0f };
+    const unsigned int seeds[] = { 7, 11, 23, 42 };
+    const int openPercent[] = { 0, 50, 80, 100 };
+    const int percents = sizeof(openPercent) / sizeof(openPercent[0]);
+    const int iterations = 20;
+
+    struct Row { double visible, tested, passed, us; };
+    Row rows[percents];
+    memset(rows, 0, sizeof(rows));
+    double inFrustum = 0.0;
+    int views = 0, failures = 0;
+    std::vector<char> allOpen(grid * grid);
+
+    for (unsigned int seed0 : seeds)
+    {
+        for (const auto& eye : eyes)
+        {
+            for (float yaw : yaws)
+            {
+                float planes[6][4];
+                MakeFrustum(eye, yaw, planes);
+                for (int i = 0; i < grid * grid; i++) inFrustum += BoxInFrustum(planes, &boxes[i * 6], &boxes[i * 6 + 3]) ? 1 : 0;
+
+                // 기준: 문을 다 열었을 때 보이는 셀
+                for (int id : portals) cells.setOpen(id, true);
+                cells.update(eye, planes, 6);
+                for (int i = 0; i < grid * grid; i++) allOpen[i] = cells.cellVisible(i) ? 1 : 0;
+
+                for (int k = 0; k < percents; k++)
+                {
+                    int pct = openPercent[k];
+                    unsigned int seed = seed0;
+                    for (int id : portals)
+                    {
+                        seed = seed * 1664525u + 1013904223u;
+                        cells.setOpen(id, (int)((seed >> 8) % 100) < pct);
+                    }
+
+                    double best = 1e30;
+                    int visible = 0;
+                    for (int it = 0; it < iterations; it++)
+                    {
+                        BenchTimer t;
+                        visible = cells.update(eye, planes, 6);
+                        best = std::min(best, t.ms());
+                    }
+
+                    for (int i = 0; i < grid * grid; i++)
+                    {
+                        if (!cells.cellVisible(i)) continue;
+                        if (!BoxInFrustum(planes, &boxes[i * 6], &boxes[i * 6 + 3]))
+                        {
+                            printf("%d%% seed %u yaw %.0f: cell %d visible through portals but outside frustum\n", pct, seed0, yaw, i);
+                            failures++;
+                            break;
+                        }
+                        if (!allOpen[i])
+                        {
+                            printf("%d%% seed %u yaw %.0f: cell %d visible but not with every door open\n", pct, seed0, yaw, i);
+                            failures++;
+                            break;
+                        }
+                    }
+                    if (pct == 0 && visible != 1)
+                    {
+                        printf("all doors closed: %d cells visible (expected 1)\n", visible);
+                        failures++;
+                    }
+
+                    const PortalCells::Stats& s = cells.stats();
+                    rows[k].visible += visible;
+                    rows[k].tested += s.portalsTested;
+                    rows[k].passed += s.portalsPassed;
+                    rows[k].us += best * 1000.0;
+                }
+                views++;
+            }
+        }
+    }
+
+    printf("%d cells, %zu portals, %d views (%zu seeds x %zu eyes x %zu yaws), %.1f cells in frustum on average\n",
+           grid * grid, portals.size(), views, sizeof(seeds) / sizeof(seeds[0]), sizeof(eyes) / sizeof(eyes[0]),
+           sizeof(yaws) / sizeof(yaws[0]), inFrustum / views);
+    printf("%-6s %10s %10s %10s %12s   (average per view)\n", "open", "visible", "tested", "passed", "us/update");
+    for (int k = 0; k < percents; k++)
+    {
+        const Row& r = rows[k];
+        printf("%5d%% %10.1f %10.1f %10.1f %12.2f\n", openPercent[k], r.visible / views, r.tested / views, r.passed / views, r.us / views);
+        // 일부만 열렸는데 통과한 포털이 없으면 잘라내기/좁히기를 재지 못한 것
+        if (openPercent[k] > 0 && openPercent[k] < 100 && r.passed == 0.0)
+        {
+            printf("%d%% open: no portal passed in any view\n", openPercent[k]);
+            failures++;
+        }
+    }
+    return failures;
+}
@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+//           Name: bench_terrain.cpp
+//    Description: 높이장 바닥 질의 처리량 (초당 질의 수)
+//-----------------------------------------------------------------------------
+// Terrain.raw (1024 x 1024) 위 무작위 위치에서 바이리니어 높이를 구합니다.
+//   scalar : HeightField::SampleScalar (= Sample, 게임 바닥 질의)
+//   batch  : HeightField::SampleBatch (AVX2 gather + FMA, 8점씩)
+// 범위 밖 좌표도 섞어서 가장자리 고정을 같이 확인. 결과는 두 경로가 같아야 함.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <math.h>
+#include "bench_common.h"
+#include "heightfield.h"
+
+int BenchTerrain(const std::string& dataDir)
+{
+    HeightField field;
+    if (!field.load((dataDir + "/Terrain.raw").c_str(), 1024, -128.0f, -148.0f, 256.0f, 20.0f, -18.0f))
+    {
+        printf("failed to load %s/Terrain.raw\n", dataDir.c_str());
+        return 1;
+    }
+
+    const CpuFeatures& cpu = CpuFeatures::get();
+    printf("cpu: sse2=%d avx2=%d fma=%d\n", cpu.sse2, cpu.avx2, cpu.fma);
+
+    // 월드보다 조금 넓은 범위 (LCG 로 고정된 순서)
+    const size_t count = 1 << 20;
+    std::vector<float> xs(count), zs(count);
+    unsigned int seed = 12345;
+    for (size_t i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        xs[i] = -140.0f + 280.0f * (seed >> 8) / 16777216.0f;
+        seed = seed * 1664525u + 1013904223u;
+        zs[i] = -160.0f + 280.0f * (seed >> 8) / 16777216.0f;
+    }
+
+    const int iterations = 5;
+    std::vector<float> outScalar(count), outBatch(count);
+    double scalarMs = 1e30, batchMs = 1e30;
+    for (int it = 0; it < iterations; it++)
+    {
+        BenchTimer t;
+        for (size_t i = 0; i < count; i++) outScalar[i] = field.SampleScalar(xs[i], zs[i]);
+        scalarMs = std::min(scalarMs, t.ms());
+    }
+    for (int it = 0; it < iterations; it++)
+    {
+        BenchTimer t;
+        field.SampleBatch(xs.data(), zs.data(), outBatch.data(), count);
+        batchMs = std::min(batchMs, t.ms());
+    }
+
+    // 곱셈 순서가 달라 비트 단위로는 다를 수 있음
+    int failures = 0;
+    float maxBatch = 0.0f;
+    for (size_t i = 0; i < count; i++) maxBatch = std::max(maxBatch, fabsf(outBatch[i] - outScalar[i]));
+    if (maxBatch > 1e-4f)
+    {
+        printf("results differ from scalar (batch %g)\n", maxBatch);
+        failures++;
+    }
+
+    printf("%-8s %12s %10s\n", "path", "queries", "ns/query");
+    printf("%-8s %8.1f M/s %10.2f\n", "scalar", count / (scalarMs / 1000.0) / 1e6, scalarMs * 1e6 / count);
+    printf("%-8s %8.1f M/s %10.2f\n", "batch", count / (batchMs / 1000.0) / 1e6, batchMs * 1e6 / count);
+    return failures;
+}
@@ -0,0 +1,488 @@
+//-----------------------------------------------------------------------------
+//           Name: ase_loader.h
+//    Description: 3ds Max ASCII Export(.ASE) 메쉬 로더 (스트리밍 토크나이저, 용접된 인덱스 버퍼)
+//-----------------------------------------------------------------------------
+// 파일을 매핑한 뒤 한 번만 훑습니다. 토큰은 (포인터, 길이) 쌍이라 문자열 복사가 없고
+// 숫자는 text_parse.h 의 파서로 매핑된 메모리에서 바로 읽습니다.
+//   *MATERIAL_LIST  -> 재질별 디퓨즈 비트맵 이름 (*SUBMATERIAL 포함)
+//   *GEOMOBJECT     -> 정점/면/텍스처 좌표/법선 목록을 읽어 면 모서리(corner)마다
+//                      (위치, UV, 법선)이 같은 것끼리 해시로 용접 -> 인덱스 버퍼
+//   그 밖의 블록(*SCENE, *LIGHTOBJECT, *NODE_TM ...)은 중괄호 깊이만 세서 건너뜀
+// 오브젝트/재질 ID(*MESH_MTLID)마다 ModelSubMesh 하나 (같은 인덱스 버퍼의 구간).
+// 좌표는 Max 의 Z-up 을 Y-up 으로 바꿔서 저장합니다. (x, y, z) -> (x, z, -y)
+// 오브젝트 단위 임시 배열은 오브젝트 사이에서 재사용하므로 할당은 파일 크기와 무관하게 몇 번뿐.
+
+#ifndef ASE_LOADER_H_INCLUDED
+#define ASE_LOADER_H_INCLUDED
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "text_parse.h"
+#include "model_mesh.h"
+
+class AseLoader
+{
+public:
+    enum AseLoadError
+    {
+        ASE_NO_ERROR = 1,   // No error
+        ASE_FILE_NOT_FOUND, // File was not found or could not be mapped
+        ASE_BAD_HEADER,     // Not an ASCII export file
+        ASE_BAD_DATA        // Unbalanced braces, unparsable numbers or out of range indices
+    };
+
+    static AseLoadError load(const char* path, ModelMesh& mesh)
+    {
+        MappedFile file;
+        if (!file.open(path)) return ASE_FILE_NOT_FOUND;
+        return parse(file.data(), file.size(), mesh);
+    }
+
+    static AseLoadError parse(const unsigned char* data, size_t size, ModelMesh& mesh)
+    {
+        mesh.clear();
+
+        Lexer lex((const char*)data, (const char*)data + size);
+        Token tok;
+        if (!lex.next(tok) || !tok.is("*3DSMAX_ASCIIEXPORT")) return ASE_BAD_HEADER;
+
+        std::vector<Material> materials;
+        Scratch scratch;
+        while (lex.next(tok))
+        {
+            bool ok = true;
+            if (tok.is("*MATERIAL_LIST")) ok = parseMaterialList(lex, materials);
+            else if (tok.is("*GEOMOBJECT")) ok = parseGeomObject(lex, scratch, mesh);
+            else if (tok.is("{")) ok = lex.skipBlock();
+            else if (tok.is("}")) ok = false;
+            if (!ok) return ASE_BAD_DATA;
+        }
+
+        // 재질 목록이 오브젝트보다 뒤에 있어도 되도록 비트맵은 마지막에 연결
+        for (auto& sub : mesh.subMeshes)
+        {
+            if (sub.material < 0 || sub.material >= (int)materials.size()) continue;
+            const Material& m = materials[sub.material];
+            sub.bitmap = (!m.subs.empty()) ? m.subs[sub.materialId % m.subs.size()].bitmap : m.bitmap;
+        }
+        return ASE_NO_ERROR;
+    }
+
+private:
+    // 매핑된 메모리 안의 토큰 (널 종료 아님)
+    struct Token
+    {
+        const char* p;
+        size_t n;
+
+        bool is(const char* s) const { return strlen(s) == n && memcmp(p, s, n) == 0; }
+        // 따옴표 문자열이면 안쪽만
+        std::string str() const { return (n >= 2 && p[0] == '"') ? std::string(p + 1, n - 2) : std::string(p, n); }
+    };
+
+    class Lexer
+    {
+    public:
+        Lexer(const char* begin, const char* end) : m_p(begin), m_end(end) {}
+
+        // 공백 구분 단어, "따옴표 문자열", '{', '}'
+        bool next(Token& t)
+        {
+            skipSpace();
+            if (m_p >= m_end) return false;
+            t.p = m_p;
+            if (*m_p == '{' || *m_p == '}') m_p++;
+            else if (*m_p == '"')
+            {
+                for (m_p++; m_p < m_end && *m_p != '"' && *m_p != '\n'; m_p++) {}
+                if (m_p < m_end && *m_p == '"') m_p++;
+            }
+            else
+            {
+                while (m_p < m_end && !IsSpace(*m_p) && *m_p != '{' && *m_p != '}') m_p++;
+            }
+            t.n = (size_t)(m_p - t.p);
+            return true;
+        }
+
+        bool number(float& out)
+        {
+            skipSpace();
+            return TextParse::ParseFloat(m_p, m_end, out);
+        }
+
+        // "12" 또는 "12:" 형태의 정수
+        bool index(unsigned int& out)
+        {
+            skipSpace();
+            if (!TextParse::ParseUInt(m_p, m_end, out)) return false;
+            if (m_p < m_end && *m_p == ':') m_p++;
+            return true;
+        }
+
+        bool vec3(float v[3]) { return number(v[0]) && number(v[1]) && number(v[2]); }
+
+        // 블록 이름 뒤의 '{' 를 소비
+        bool open()
+        {
+            Token t;
+            return next(t) && t.is("{");
+        }
+
+        // '{' 를 읽은 직후부터 짝이 맞는 '}' 까지 건너뜀
+        bool skipBlock()
+        {
+            int depth = 1;
+            Token t;
+            while (next(t))
+            {
+                if (t.is("{")) depth++;
+                else if (t.is("}") && --depth == 0) return true;
+            }
+            return false;
+        }
+
+    private:
+        static bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+        void skipSpace() { while (m_p < m_end && IsSpace(*m_p)) m_p++; }
+
+        const char* m_p;
+        const char* m_end;
+    };
+
+    struct Material
+    {
+        std::string bitmap;
+        std::vector<Material> subs;
+    };
+
+    struct Face
+    {
+        unsigned int v[3];      // 정점 인덱스
+        unsigned int t[3];      // 텍스처 정점 인덱스
+        float n[3][3];          // 모서리별 법선
+        unsigned int mtl;
+    };
+
+    // 오브젝트마다 다시 쓰는 임시 배열 (capacity 유지)
+    struct Scratch
+    {
+        std::vector<float> positions;       // x y z
+        std::vector<float> tverts;          // u v
+        std::vector<Face> faces;
+        std::vector<unsigned int> table;    // 용접 해시 테이블 (정점 번호 + 1, 0 = 빈 칸)
+        std::vector<unsigned int> mtlIds;
+    };
+
+    static bool parseMaterialList(Lexer& lex, std::vector<Material>& materials)
+    {
+        if (!lex.open()) return false;
+        Token tok;
+        while (lex.next(tok))
+        {
+            if (tok.is("}")) return true;
+            if (tok.is("*MATERIAL"))
+            {
+                unsigned int id;
+                if (!lex.index(id) || !lex.open()) return false;
+                if (id >= materials.size()) materials.resize(id + 1);
+                if (!parseMaterial(lex, materials[id])) return false;
+            }
+            else if (tok.is("{") && !lex.skipBlock()) return false;
+        }
+        return false;
+    }
+
+    // '{' 다음부터. 디퓨즈 맵의 비트맵과 하위 재질만 읽음
+    static bool parseMaterial(Lexer& lex, Material& m)
+    {
+        Token tok;
+        while (lex.next(tok))
+        {
+            if (tok.is("}")) return true;
+            if (tok.is("*SUBMATERIAL"))
+            {
+                unsigned int id;
+                if (!lex.index(id) || !lex.open()) return false;
+                if (id >= m.subs.size()) m.subs.resize(id + 1);
+                if (!parseMaterial(lex, m.subs[id])) return false;
+            }
+            else if (tok.is("*MAP_DIFFUSE"))
+            {
+                if (!lex.open()) return false;
+                while (lex.next(tok) && !tok.is("}"))
+                {
+                    if (tok.is("*BITMAP") && lex.next(tok)) m.bitmap = FileName(tok.str());
+                    else if (tok.is("{") && !lex.skipBlock()) return false;
+                }
+            }
+            else if (tok.is("{") && !lex.skipBlock()) return false;
+        }
+        return false;
+    }
+
+    static bool parseGeomObject(Lexer& lex, Scratch& s, ModelMesh& mesh)
+    {
+        if (!lex.open()) return false;
+        s.positions.clear();
+        s.tverts.clear();
+        s.faces.clear();
+
+        std::string name;
+        int material = -1;
+        bool hasNormals = false;
+        Token tok;
+        for (;;)
+        {
+            if (!lex.next(tok)) return false;
+            if (tok.is("}")) break;
+            if (tok.is("*NODE_NAME") && lex.next(tok)) name = tok.str();
+            else if (tok.is("*MATERIAL_REF"))
+            {
+                unsigned int id;
+                if (!lex.index(id)) return false;
+                material = (int)id;
+            }
+            else if (tok.is("*MESH"))
+            {
+                if (!lex.open() || !parseMesh(lex, s, hasNormals)) return false;
+            }
+            else if (tok.is("{") && !lex.skipBlock()) return false;
+        }
+
+        if (s.faces.empty()) return true;
+        if (!hasNormals) ComputeFaceNormals(s);
+        return emit(s, name, material, mesh);
+    }
+
+    // '{' 다음부터
+    static bool parseMesh(Lexer& lex, Scratch& s, bool& hasNormals)
+    {
+        Token tok;
+        while (lex.next(tok))
+        {
+            if (tok.is("}")) return true;
+
+            unsigned int i, count;
+            if (tok.is("*MESH_NUMVERTEX"))
+            {
+                if (!lex.index(count)) return false;
+                s.positions.assign((size_t)count * 3, 0.0f);
+            }
+            else if (tok.is("*MESH_NUMFACES"))
+            {
+                if (!lex.index(count)) return false;
+                Face empty;
+                memset(&empty, 0, sizeof(empty));
+                s.faces.assign(count, empty);
+            }
+            else if (tok.is("*MESH_NUMTVERTEX"))
+            {
+                if (!lex.index(count)) return false;
+                s.tverts.assign((size_t)count * 2, 0.0f);
+            }
+            else if (tok.is("*MESH_VERTEX_LIST"))
+            {
+                if (!lex.open()) return false;
+                while (lex.next(tok) && !tok.is("}"))
+                {
+                    float p[3];
+                    if (!tok.is("*MESH_VERTEX")) continue;
+                    if (!lex.index(i) || !lex.vec3(p) || (size_t)i * 3 >= s.positions.size()) return false;
+                    ToYUp(p, &s.positions[(size_t)i * 3]);
+                }
+            }
+            else if (tok.is("*MESH_FACE_LIST"))
+            {
+                // *MESH_FACE 0: A: 0 B: 1 C: 2 AB: 1 BC: 1 CA: 0 *MESH_SMOOTHING 1 *MESH_MTLID 0
+                Face* face = NULL;
+                if (!lex.open()) return false;
+                while (lex.next(tok) && !tok.is("}"))
+                {
+                    if (tok.is("*MESH_FACE"))
+                    {
+                        if (!lex.index(i) || i >= s.faces.size()) return false;
+                        face = &s.faces[i];
+                        for (int k = 0; k < 3; k++)
+                        {
+                            if (!lex.next(tok) || !lex.index(face->v[k])) return false;
+                            if ((size_t)face->v[k] * 3 >= s.positions.size()) return false;
+                        }
+                    }
+                    else if (tok.is("*MESH_MTLID") && face)
+                    {
+                        if (!lex.index(face->mtl)) return false;
+                    }
+                }
+            }
+            else if (tok.is("*MESH_TVERTLIST"))
+            {
+                if (!lex.open()) return false;
+                while (lex.next(tok) && !tok.is("}"))
+                {
+                    float uvw[3];
+                    if (!tok.is("*MESH_TVERT")) continue;
+                    if (!lex.index(i) || !lex.vec3(uvw) || (size_t)i * 2 >= s.tverts.size()) return false;
+                    s.tverts[(size_t)i * 2] = uvw[0];
+                    s.tverts[(size_t)i * 2 + 1] = uvw[1];
+                }
+            }
+            else if (tok.is("*MESH_TFACELIST"))
+            {
+                if (!lex.open()) return false;
+                while (lex.next(tok) && !tok.is("}"))
+                {
+                    if (!tok.is("*MESH_TFACE")) continue;
+                    if (!lex.index(i) || i >= s.faces.size()) return false;
+                    for (int k = 0; k < 3; k++)
+                    {
+                        if (!lex.index(s.faces[i].t[k]) || (size_t)s.faces[i].t[k] * 2 >= s.tverts.size()) return false;
+                    }
+                }
+            }
+            else if (tok.is("*MESH_NORMALS"))
+            {
+                // *MESH_FACENORMAL f nx ny nz 뒤에 모서리 순서대로 *MESH_VERTEXNORMAL v nx ny nz 3개
+                Face* face = NULL;
+                int corner = 0;
+                if (!lex.open()) return false;
+                while (lex.next(tok) && !tok.is("}"))
+                {
+                    float n[3];
+                    if (tok.is("*MESH_FACENORMAL"))
+                    {
+                        if (!lex.index(i) || !lex.vec3(n) || i >= s.faces.size()) return false;
+                        face = &s.faces[i];
+                        corner = 0;
+                    }
+                    else if (tok.is("*MESH_VERTEXNORMAL"))
+                    {
+                        if (!lex.index(i) || !lex.vec3(n)) return false;
+                        if (face && corner < 3) ToYUp(n, face->n[corner++]);
+                    }
+                }
+                hasNormals = true;
+            }
+            else if (tok.is("{") && !lex.skipBlock()) return false;
+        }
+        return false;
+    }
+
+    // 모서리 (위치, 법선, UV) 가 같으면 같은 정점. 재질 ID 순으로 서브메쉬를 나눠 인덱스를 씀
+    static bool emit(Scratch& s, const std::string& name, int material, ModelMesh& mesh)
+    {
+        size_t corners = s.faces.size() * 3;
+        size_t tableSize = 16;
+        while (tableSize < corners * 2) tableSize <<= 1;
+        s.table.assign(tableSize, 0);
+        size_t mask = tableSize - 1;
+
+        s.mtlIds.clear();
+        for (auto& f : s.faces)
+        {
+            bool found = false;
+            for (unsigned int id : s.mtlIds) if (id == f.mtl) { found = true; break; }
+            if (!found) s.mtlIds.push_back(f.mtl);
+        }
+        std::sort(s.mtlIds.begin(), s.mtlIds.end());
+
+        size_t base = mesh.vertexCount();
+        mesh.vertices.reserve(mesh.vertices.size() + corners * 8);
+        mesh.indices.reserve(mesh.indices.size() + corners);
+
+        for (unsigned int id : s.mtlIds)
+        {
+            ModelSubMesh sub;
+            sub.name = name;
+            sub.material = material;
+            sub.materialId = id;
+            sub.firstIndex = (unsigned int)mesh.indices.size();
+
+            for (auto& f : s.faces)
+            {
+                if (f.mtl != id) continue;
+                for (int k = 0; k < 3; k++)
+                {
+                    float v[8];
+                    memcpy(v, &s.positions[(size_t)f.v[k] * 3], 3 * sizeof(float));
+                    memcpy(v + 3, f.n[k], 3 * sizeof(float));
+                    if (!s.tverts.empty()) memcpy(v + 6, &s.tverts[(size_t)f.t[k] * 2], 2 * sizeof(float));
+                    else v[6] = v[7] = 0.0f;
+
+                    size_t slot = Hash(v) & mask;
+                    for (;;)
+                    {
+                        unsigned int e = s.table[slot];
+                        if (e == 0)
+                        {
+                            mesh.vertices.insert(mesh.vertices.end(), v, v + 8);
+                            e = (unsigned int)(mesh.vertexCount() - base);
+                            s.table[slot] = e;
+                        }
+                        else if (memcmp(&mesh.vertices[(base + e - 1) * 8], v, sizeof(v)) != 0)
+                        {
+                            slot = (slot + 1) & mask;
+                            continue;
+                        }
+                        mesh.indices.push_back((unsigned int)(base + e - 1));
+                        break;
+                    }
+                }
+            }
+
+            sub.indexCount = (unsigned int)mesh.indices.size() - sub.firstIndex;
+            mesh.subMeshes.push_back(sub);
+        }
+        return true;
+    }
+
+    // 파일에 법선이 없으면 면 법선 (Max 의 스무딩 그룹 없는 면과 같은 결과)
+    static void ComputeFaceNormals(Scratch& s)
+    {
+        for (auto& f : s.faces)
+        {
+            const float* a = &s.positions[(size_t)f.v[0] * 3];
+            const float* b = &s.positions[(size_t)f.v[1] * 3];
+            const float* c = &s.positions[(size_t)f.v[2] * 3];
+            float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            float len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len > 0.0f) { n[0] /= len; n[1] /= len; n[2] /= len; }
+            else n[1] = 1.0f;
+            for (int k = 0; k < 3; k++) memcpy(f.n[k], n, sizeof(n));
+        }
+    }
+
+    static void ToYUp(const float in[3], float out[3])
+    {
+        // 0 - y: -0.0 이 생기지 않게 해서 용접 비교(비트 단위)가 어긋나지 않도록
+        float x = in[0], y = in[1], z = in[2];
+        out[0] = x;
+        out[1] = z;
+        out[2] = 0.0f - y;
+    }
+
+    // 8개 float 비트 패턴의 FNV-1a
+    static size_t Hash(const float v[8])
+    {
+        unsigned int bits[8];
+        memcpy(bits, v, sizeof(bits));
+        unsigned int h = 2166136261u;
+        for (int i = 0; i < 8; i++) h = (h ^ bits[i]) * 16777619u;
+        return h ^ (h >> 15);
+    }
+
+    // "C:\\maps\\marble.bmp" -> "marble.bmp"
+    static std::string FileName(const std::string& path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        return (slash == std::string::npos) ? path : path.substr(slash + 1);
+    }
+};
+
+#endif // ASE_LOADER_H_INCLUDED
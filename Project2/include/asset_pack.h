@@ -0,0 +1,406 @@
+//-----------------------------------------------------------------------------
+//           Name: asset_pack.h
+//    Description: Data 폴더 전체를 담는 단일 에셋 팩(.pak) 포맷, 읽기(매핑) / 쓰기
+//-----------------------------------------------------------------------------
+// 파일 구조: [AssetPackHeader][AssetPackSlot x slotCount][이름 문자열][데이터 (ASSETPACK_ALIGNMENT 정렬)]
+// 슬롯 표는 키 해시(FNV-1a 64)로 찾는 선형 탐사 해시 표 (슬롯 수 = 2의 거듭제곱, 절반 이하 사용).
+// 내용이 같은 파일은 데이터를 한 번만 저장하고 여러 슬롯이 같은 오프셋을 가리킵니다.
+//
+// 키: 경로에서 마지막 "Data" 폴더 뒤 부분을 소문자 + '/' 로 (없으면 경로 전체)
+//   "../Data/Cube.bmp", "Data/cube.bmp", "..\\data\\Cube.bmp"  ->  "cube.bmp"
+//   "../Data/Planets/Moon_1k.jpg"                             ->  "planets/moon_1k.jpg"
+// 그래서 실행 폴더 기준으로 섞여 있는 "../Data/..." 와 "Data/..." 경로가 같은 항목을 찾습니다.
+//
+// AssetPack::Mount() 로 걸어두면 MappedFile::open 이 파일 시스템보다 팩을 먼저 찾으므로
+// 매핑 기반 로더(BMP/TGA/PPM/JPEG/PLY/ASE/3DS ...)는 고칠 필요 없이 팩에서 읽게 됩니다.
+// 찾기는 해시 한 번 + 슬롯 비교뿐이고 stat/open 같은 파일 시스템 호출이 없습니다.
+
+#ifndef ASSET_PACK_H_INCLUDED
+#define ASSET_PACK_H_INCLUDED
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "mapped_file.h"
+
+#ifdef _MSC_VER
+typedef unsigned __int32 apk_uint32;
+typedef unsigned __int64 apk_uint64;
+#else
+#include <stdint.h>
+typedef uint32_t apk_uint32;
+typedef uint64_t apk_uint64;
+#endif
+
+struct AssetPackHeader
+{
+    char       magic[4];        // "APK1"
+    apk_uint32 version;
+    apk_uint32 entryCount;      // 이름 수 (중복 내용 포함)
+    apk_uint32 slotCount;       // 2의 거듭제곱
+    apk_uint64 namesOffset;
+    apk_uint64 namesSize;
+    apk_uint64 dataOffset;
+    apk_uint64 dataSize;        // 중복 제거된 데이터 크기
+};
+
+struct AssetPackSlot
+{
+    apk_uint64 hash;            // 0 = 빈 슬롯
+    apk_uint64 offset;          // 파일 시작 기준
+    apk_uint64 size;
+    apk_uint32 nameOffset;      // 이름 문자열 영역 기준 (해시 충돌 확인용)
+    apk_uint32 nameLength;
+};
+
+const apk_uint32 ASSETPACK_VERSION = 1;
+const size_t ASSETPACK_ALIGNMENT = 64;
+
+class AssetPack
+{
+public:
+    AssetPack() : m_pData(NULL), m_pHeader(NULL), m_pSlots(NULL), m_pNames(NULL), m_nMask(0) {}
+
+    bool open(const char* path)
+    {
+        close();
+        // 팩 자체는 언제나 파일 시스템에서 (걸어둔 팩에서 찾지 않도록 매핑 전에 잠시 해제)
+        AssetPack* mounted = Mounted();
+        Mount(NULL);
+        bool ok = m_file.open(path);
+        Mount(mounted);
+        if (!ok || !parse(m_file.data(), m_file.size()))
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // 메모리 위의 팩 검증 (데이터 수명은 호출자가 보장)
+    bool parse(const unsigned char* data, size_t size)
+    {
+        if (size < sizeof(AssetPackHeader)) return false;
+        const AssetPackHeader* h = (const AssetPackHeader*)data;
+        if (memcmp(h->magic, "APK1", 4) != 0 || h->version != ASSETPACK_VERSION) return false;
+        if (h->slotCount == 0 || (h->slotCount & (h->slotCount - 1)) != 0) return false;
+
+        size_t slotsEnd = sizeof(AssetPackHeader) + sizeof(AssetPackSlot) * (size_t)h->slotCount;
+        if (slotsEnd > size || h->namesOffset < slotsEnd || h->namesOffset + h->namesSize > size) return false;
+        if (h->dataOffset + h->dataSize > size) return false;
+
+        // 빈 슬롯이 하나도 없으면 없는 키를 찾을 때 탐사가 끝나지 않으므로 거부
+        const AssetPackSlot* slots = (const AssetPackSlot*)(data + sizeof(AssetPackHeader));
+        bool hasEmpty = false;
+        for (apk_uint32 i = 0; i < h->slotCount; i++)
+        {
+            if (slots[i].hash == 0)
+            {
+                hasEmpty = true;
+                continue;
+            }
+            if (slots[i].offset + slots[i].size > size || (apk_uint64)slots[i].nameOffset + slots[i].nameLength > h->namesSize) return false;
+        }
+        if (!hasEmpty) return false;
+
+        m_pData = data;
+        m_pHeader = h;
+        m_pSlots = slots;
+        m_pNames = (const char*)data + h->namesOffset;
+        m_nMask = h->slotCount - 1;
+        return true;
+    }
+
+    void close()
+    {
+        if (Mounted() == this) Mount(NULL);
+        m_file.close();
+        m_pData = NULL;
+        m_pHeader = NULL;
+        m_pSlots = NULL;
+        m_pNames = NULL;
+        m_nMask = 0;
+    }
+
+    bool isOpen() const { return m_pHeader != NULL; }
+    const AssetPackHeader& header() const { return *m_pHeader; }
+
+    // 경로 -> 팩 안의 데이터. 키 정규화와 해시를 한 번에 (메모리 할당 없음)
+    bool find(const char* path, const unsigned char*& data, size_t& size) const
+    {
+        if (!m_pHeader || !path) return false;
+        const char* key = KeyStart(path);
+        size_t length = strlen(key);
+        apk_uint64 hash = HashKey(key, length);
+
+        // 최대 slotCount 번만 탐사 (parse 가 빈 슬롯을 보장하지만 한 번 더 막아둠)
+        apk_uint32 i = (apk_uint32)hash & m_nMask;
+        for (apk_uint32 n = 0; n <= m_nMask; n++, i = (i + 1) & m_nMask)
+        {
+            const AssetPackSlot& s = m_pSlots[i];
+            if (s.hash == 0) return false;
+            if (s.hash == hash && s.nameLength == length && KeyEquals(key, m_pNames + s.nameOffset, length))
+            {
+                data = m_pData + s.offset;
+                size = (size_t)s.size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool contains(const char* path) const
+    {
+        const unsigned char* data;
+        size_t size;
+        return find(path, data, size);
+    }
+
+    // 정규화된 키 문자열 ("../Data/Planets/Moon.bmp" -> "planets/moon.bmp")
+    static std::string KeyFor(const char* path)
+    {
+        std::string key = KeyStart(path);
+        for (auto& c : key) c = NormalizeChar(c);
+        return key;
+    }
+
+    // FNV-1a 64, 정규화(소문자, '/')를 하면서 해시. 0 은 빈 슬롯 표시라 피함
+    static apk_uint64 HashKey(const char* key, size_t length)
+    {
+        apk_uint64 h = 14695981039346656037ULL;
+        for (size_t i = 0; i < length; i++)
+        {
+            h ^= (unsigned char)NormalizeChar(key[i]);
+            h *= 1099511628211ULL;
+        }
+        return h ? h : 1;
+    }
+
+    // 걸어둔 팩 (MappedFile 이 먼저 찾아봄). NULL 이면 해제
+    static void Mount(AssetPack* pack)
+    {
+        MountedSlot() = pack;
+        MappedFile::resolver() = pack ? &Resolve : NULL;
+    }
+
+    static AssetPack* Mounted() { return MountedSlot(); }
+
+private:
+    static char NormalizeChar(char c)
+    {
+        if (c == '\\') return '/';
+        return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+
+    // 마지막 "data" 폴더 이름 뒤. 없으면 앞의 "./" 만 떼고 전체
+    static const char* KeyStart(const char* path)
+    {
+        const char* key = path;
+        for (const char* p = path; *p; p++)
+        {
+            bool componentStart = (p == path) || p[-1] == '/' || p[-1] == '\\';
+            if (!componentStart) continue;
+            if (NormalizeChar(p[0]) == 'd' && NormalizeChar(p[1]) == 'a' && NormalizeChar(p[2]) == 't' && NormalizeChar(p[3]) == 'a' &&
+                (p[4] == '/' || p[4] == '\\'))
+                key = p + 5;
+        }
+        while (key[0] == '.' && (key[1] == '/' || key[1] == '\\')) key += 2;
+        return key;
+    }
+
+    static bool KeyEquals(const char* key, const char* stored, size_t length)
+    {
+        for (size_t i = 0; i < length; i++)
+            if (NormalizeChar(key[i]) != stored[i]) return false;
+        return true;
+    }
+
+    static bool Resolve(const char* path, const unsigned char*& data, size_t& size)
+    {
+        AssetPack* pack = Mounted();
+        return pack && pack->find(path, data, size);
+    }
+
+    static AssetPack*& MountedSlot()
+    {
+        static AssetPack* pack = NULL;
+        return pack;
+    }
+
+    MappedFile m_file;
+    const unsigned char* m_pData;
+    const AssetPackHeader* m_pHeader;
+    const AssetPackSlot* m_pSlots;
+    const char* m_pNames;
+    apk_uint32 m_nMask;
+};
+
+// 팩 파일 쓰기 (오프라인 도구용). add() 는 데이터를 복사해 두고 write() 가 한 번에 씀
+class AssetPackWriter
+{
+public:
+    struct Stats
+    {
+        size_t entries;         // 이름 수
+        size_t uniqueEntries;   // 서로 다른 내용 수
+        size_t inputBytes;      // 추가된 전체 크기
+        size_t uniqueBytes;     // 실제로 저장된 크기
+        size_t sameNameSkipped; // 이미 같은 키가 있어서 건너뛴 파일 수 (내용이 같을 때)
+        size_t conflicts;       // 같은 키에 다른 내용 (먼저 추가된 쪽 유지, 두 경로를 stderr 에 경고)
+    };
+
+    AssetPackWriter() { memset(&m_stats, 0, sizeof(m_stats)); }
+
+    // path 에서 키를 만들어 추가. source 는 경고에 찍을 실제 파일 경로 (NULL 이면 path). 반환: 새 이름이면 true
+    bool add(const char* path, const unsigned char* data, size_t size, const char* source = NULL)
+    {
+        if (!source) source = path;
+        std::string key = AssetPack::KeyFor(path);
+        apk_uint64 contentHash = HashContent(data, size);
+        m_stats.inputBytes += size;
+
+        auto named = m_byName.find(key);
+        if (named != m_byName.end())
+        {
+            const Blob& existing = m_blobs[named->second];
+            if (existing.bytes.size() == size && memcmp(existing.bytes.data(), data, size) == 0)
+            {
+                m_stats.sameNameSkipped++;
+            }
+            else
+            {
+                // "Data/x" 와 "Project2/Data/x" 처럼 키가 같아지는 다른 파일. 조용히 버리지 않고 둘 다 알림
+                fprintf(stderr, "warning: key \"%s\" conflict: keeping %s, skipping %s (different contents)\n",
+                        key.c_str(), m_sourceByName[key].c_str(), source);
+                m_stats.conflicts++;
+            }
+            return false;
+        }
+
+        // 내용 중복 제거 (해시가 같으면 바이트까지 비교)
+        size_t blob = m_blobs.size();
+        auto range = m_byContent.equal_range(contentHash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const Blob& b = m_blobs[it->second];
+            if (b.bytes.size() == size && memcmp(b.bytes.data(), data, size) == 0)
+            {
+                blob = it->second;
+                break;
+            }
+        }
+        if (blob == m_blobs.size())
+        {
+            Blob b;
+            b.bytes.assign(data, data + size);
+            b.offset = 0;
+            m_blobs.push_back(b);
+            m_byContent.insert(std::make_pair(contentHash, blob));
+            m_stats.uniqueEntries++;
+            m_stats.uniqueBytes += size;
+        }
+
+        m_byName[key] = blob;
+        m_sourceByName[key] = source;
+        m_names.push_back(key);
+        m_stats.entries++;
+        return true;
+    }
+
+    bool write(const char* path)
+    {
+        apk_uint32 slotCount = 16;
+        while (slotCount < m_names.size() * 2) slotCount *= 2;
+
+        std::string names;
+        for (auto& n : m_names) names += n;
+
+        AssetPackHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, "APK1", 4);
+        h.version = ASSETPACK_VERSION;
+        h.entryCount = (apk_uint32)m_names.size();
+        h.slotCount = slotCount;
+        h.namesOffset = sizeof(AssetPackHeader) + sizeof(AssetPackSlot) * (apk_uint64)slotCount;
+        h.namesSize = names.size();
+        h.dataOffset = Align(h.namesOffset + h.namesSize);
+
+        apk_uint64 offset = h.dataOffset;
+        for (auto& b : m_blobs)
+        {
+            b.offset = offset;
+            offset = Align(offset + b.bytes.size());
+        }
+        h.dataSize = offset - h.dataOffset;
+
+        std::vector<AssetPackSlot> slots(slotCount);
+        memset(slots.data(), 0, sizeof(AssetPackSlot) * slotCount);
+        apk_uint32 nameOffset = 0;
+        for (auto& n : m_names)
+        {
+            apk_uint64 hash = AssetPack::HashKey(n.c_str(), n.size());
+            apk_uint32 i = (apk_uint32)hash & (slotCount - 1);
+            while (slots[i].hash != 0) i = (i + 1) & (slotCount - 1);
+            const Blob& b = m_blobs[m_byName[n]];
+            slots[i].hash = hash;
+            slots[i].offset = b.offset;
+            slots[i].size = b.bytes.size();
+            slots[i].nameOffset = nameOffset;
+            slots[i].nameLength = (apk_uint32)n.size();
+            nameOffset += (apk_uint32)n.size();
+        }
+
+        FILE* fp = fopen(path, "wb");
+        if (!fp) return false;
+        bool ok = fwrite(&h, sizeof(h), 1, fp) == 1;
+        ok = ok && fwrite(slots.data(), sizeof(AssetPackSlot), slotCount, fp) == slotCount;
+        ok = ok && (names.empty() || fwrite(names.data(), 1, names.size(), fp) == names.size());
+        apk_uint64 written = h.namesOffset + h.namesSize;
+        static const unsigned char zeros[ASSETPACK_ALIGNMENT] = { 0 };
+        for (auto& b : m_blobs)
+        {
+            ok = ok && fwrite(zeros, 1, (size_t)(b.offset - written), fp) == b.offset - written;
+            ok = ok && (b.bytes.empty() || fwrite(b.bytes.data(), 1, b.bytes.size(), fp) == b.bytes.size());
+            written = b.offset + b.bytes.size();
+        }
+        // 마지막 블롭 뒤도 정렬 경계까지 채워서 파일 크기 = dataOffset + dataSize
+        apk_uint64 end = h.dataOffset + h.dataSize;
+        ok = ok && fwrite(zeros, 1, (size_t)(end - written), fp) == end - written;
+        fclose(fp);
+        return ok;
+    }
+
+    const Stats& stats() const { return m_stats; }
+
+private:
+    struct Blob
+    {
+        std::vector<unsigned char> bytes;
+        apk_uint64 offset;
+    };
+
+    static apk_uint64 Align(apk_uint64 v) { return (v + ASSETPACK_ALIGNMENT - 1) & ~(apk_uint64)(ASSETPACK_ALIGNMENT - 1); }
+
+    static apk_uint64 HashContent(const unsigned char* data, size_t size)
+    {
+        apk_uint64 h = 14695981039346656037ULL ^ size;
+        for (size_t i = 0; i < size; i++)
+        {
+            h ^= data[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    std::vector<Blob> m_blobs;
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, size_t> m_byName;
+    std::unordered_map<std::string, std::string> m_sourceByName; // 키 -> 처음 추가한 파일 경로 (충돌 경고용)
+    std::unordered_multimap<apk_uint64, size_t> m_byContent;
+    Stats m_stats;
+};
+
+#endif // ASSET_PACK_H_INCLUDED
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+//           Name: bc_encoder.h
+//    Description: BC1 / BC3 (S3TC DXT1 / DXT5) 블록 인코더 및 밉맵 생성
+//-----------------------------------------------------------------------------
+// 오프라인 베이커 전용. 색상은 주성분 축 위의 최소/최대 점을 끝점으로 쓰는
+// range fit 방식이고, BC3 알파는 블록의 최소/최대를 8단계로 보간합니다.
+// 입력은 빈틈없는 RGBA8 이미지 (GL 과 같은 bottom-up 행 순서).
+
+#ifndef BC_ENCODER_H_INCLUDED
+#define BC_ENCODER_H_INCLUDED
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+namespace BCEncoder
+{
+
+inline int Clamp255(int v) { return v < 0 ? 0 : (v > 255 ? 255 : v); }
+
+inline unsigned short PackRGB565(const float c[3])
+{
+    int r = Clamp255((int)(c[0] + 0.5f)), g = Clamp255((int)(c[1] + 0.5f)), b = Clamp255((int)(c[2] + 0.5f));
+    return (unsigned short)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+inline void UnpackRGB565(unsigned short c, int out[3])
+{
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// 4x4 RGBA 블록 -> BC1 색상 블록 8바이트 (항상 4색 모드)
+inline void EncodeColorBlock(const unsigned char block[64], unsigned char out[8])
+{
+    // 평균과 공분산
+    float mean[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++)
+        for (int k = 0; k < 3; k++) mean[k] += block[i * 4 + k];
+    for (int k = 0; k < 3; k++) mean[k] /= 16.0f;
+
+    float cov[6] = { 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < 16; i++)
+    {
+        float d[3] = { block[i * 4] - mean[0], block[i * 4 + 1] - mean[1], block[i * 4 + 2] - mean[2] };
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+
+    // 거듭제곱법으로 주성분 축
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int it = 0; it < 8; it++)
+    {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float len = sqrtf(x * x + y * y + z * z);
+        if (len < 1e-6f) break;
+        axis[0] = x / len; axis[1] = y / len; axis[2] = z / len;
+    }
+
+    float minT = 1e30f, maxT = -1e30f;
+    for (int i = 0; i < 16; i++)
+    {
+        float t = (block[i * 4] - mean[0]) * axis[0] + (block[i * 4 + 1] - mean[1]) * axis[1] + (block[i * 4 + 2] - mean[2]) * axis[2];
+        if (t < minT) minT = t;
+        if (t > maxT) maxT = t;
+    }
+
+    // 양 끝을 범위의 1/16 만큼 안쪽으로 (양자화 오차 감소)
+    float inset = (maxT - minT) / 16.0f;
+    minT += inset; maxT -= inset;
+    float e0[3], e1[3];
+    for (int k = 0; k < 3; k++) { e0[k] = mean[k] + axis[k] * maxT; e1[k] = mean[k] + axis[k] * minT; }
+
+    unsigned short c0 = PackRGB565(e0), c1 = PackRGB565(e1);
+    if (c0 < c1) { unsigned short t = c0; c0 = c1; c1 = t; }
+
+    unsigned int indices = 0;
+    if (c0 != c1)
+    {
+        int p[4][3];
+        UnpackRGB565(c0, p[0]);
+        UnpackRGB565(c1, p[1]);
+        for (int k = 0; k < 3; k++)
+        {
+            p[2][k] = (2 * p[0][k] + p[1][k]) / 3;
+            p[3][k] = (p[0][k] + 2 * p[1][k]) / 3;
+        }
+        for (int i = 15; i >= 0; i--)
+        {
+            int best = 0, bestDist = 1 << 30;
+            for (int j = 0; j < 4; j++)
+            {
+                int dr = block[i * 4] - p[j][0], dg = block[i * 4 + 1] - p[j][1], db = block[i * 4 + 2] - p[j][2];
+                int dist = dr * dr + dg * dg + db * db;
+                if (dist < bestDist) { bestDist = dist; best = j; }
+            }
+            indices = (indices << 2) | best;
+        }
+    }
+
+    out[0] = (unsigned char)(c0 & 0xFF); out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF); out[3] = (unsigned char)(c1 >> 8);
+    out[4] = (unsigned char)(indices);       out[5] = (unsigned char)(indices >> 8);
+    out[6] = (unsigned char)(indices >> 16); out[7] = (unsigned char)(indices >> 24);
+}
+
+// 4x4 RGBA 블록의 알파 -> BC3 알파 블록 8바이트 (8단계 보간 모드)
+inline void EncodeAlphaBlock(const unsigned char block[64], unsigned char out[8])
+{
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++)
+    {
+        int a = block[i * 4 + 3];
+        if (a > a0) a0 = a;
+        if (a < a1) a1 = a;
+    }
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+
+    unsigned long long bits = 0;
+    if (a0 != a1)
+    {
+        int palette[8] = { a0, a1 };
+        for (int i = 1; i <= 6; i++) palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+        for (int i = 15; i >= 0; i--)
+        {
+            int a = block[i * 4 + 3], best = 0, bestDist = 1 << 30;
+            for (int j = 0; j < 8; j++)
+            {
+                int d = (a - palette[j]) * (a - palette[j]);
+                if (d < bestDist) { bestDist = d; best = j; }
+            }
+            bits = (bits << 3) | (unsigned long long)best;
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = (unsigned char)(bits >> (8 * i));
+}
+
+// RGBA8 이미지 한 레벨 전체를 인코딩 (가장자리는 좌표를 잘라서 채움)
+inline std::vector<unsigned char> EncodeImage(const unsigned char* rgba, int width, int height, bool bc3)
+{
+    int bw = (width + 3) / 4, bh = (height + 3) / 4;
+    int blockBytes = bc3 ? 16 : 8;
+    std::vector<unsigned char> out((size_t)bw * bh * blockBytes);
+
+    unsigned char block[64];
+    for (int by = 0; by < bh; by++)
+    {
+        for (int bx = 0; bx < bw; bx++)
+        {
+            for (int y = 0; y < 4; y++)
+            {
+                int sy = by * 4 + y < height ? by * 4 + y : height - 1;
+                for (int x = 0; x < 4; x++)
+                {
+                    int sx = bx * 4 + x < width ? bx * 4 + x : width - 1;
+                    memcpy(block + (y * 4 + x) * 4, rgba + ((size_t)sy * width + sx) * 4, 4);
+                }
+            }
+
+            unsigned char* dst = &out[((size_t)by * bw + bx) * blockBytes];
+            if (bc3)
+            {
+                EncodeAlphaBlock(block, dst);
+                EncodeColorBlock(block, dst + 8);
+            }
+            else EncodeColorBlock(block, dst);
+        }
+    }
+    return out;
+}
+
+// 2x2 박스 필터로 다음 밉 레벨 생성 (홀수 크기는 가장자리 픽셀 재사용)
+inline std::vector<unsigned char> Downsample(const unsigned char* rgba, int width, int height, int& outW, int& outH)
+{
+    outW = width > 1 ? width / 2 : 1;
+    outH = height > 1 ? height / 2 : 1;
+    std::vector<unsigned char> out((size_t)outW * outH * 4);
+
+    for (int y = 0; y < outH; y++)
+    {
+        int y0 = y * 2 < height ? y * 2 : height - 1;
+        int y1 = y * 2 + 1 < height ? y * 2 + 1 : height - 1;
+        for (int x = 0; x < outW; x++)
+        {
+            int x0 = x * 2 < width ? x * 2 : width - 1;
+            int x1 = x * 2 + 1 < width ? x * 2 + 1 : width - 1;
+            for (int k = 0; k < 4; k++)
+            {
+                int sum = rgba[((size_t)y0 * width + x0) * 4 + k] + rgba[((size_t)y0 * width + x1) * 4 + k] +
+                          rgba[((size_t)y1 * width + x0) * 4 + k] + rgba[((size_t)y1 * width + x1) * 4 + k];
+                out[((size_t)y * outW + x) * 4 + k] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace BCEncoder
+
+#endif // BC_ENCODER_H_INCLUDED
@@ -0,0 +1,248 @@
+//-----------------------------------------------------------------------------
+//           Name: bmp_view.h
+//    Description: 메모리 매핑된 BMP 파일의 헤더 검증 및 픽셀 영역 뷰
+//-----------------------------------------------------------------------------
+// 픽셀은 파일 안의 BGR(A) 레이아웃 그대로 가리킵니다. (행은 4바이트 정렬, 기본은 bottom-up)
+// GL_BGR / GL_BGRA + GL_UNPACK_ALIGNMENT 4 로 복사/스왑 없이 바로 업로드할 수 있습니다.
+// 팔레트(1/4/8bit) 및 top-down 이미지만 normalize()에서 bottom-up BGR 로 풀어냅니다.
+
+#ifndef BMP_VIEW_H_INCLUDED
+#define BMP_VIEW_H_INCLUDED
+
+#include <string.h>
+#include <vector>
+#include "mapped_file.h"
+#include "pixel_convert.h"
+
+class BmpView
+{
+public:
+    enum BMPLoadError
+    {
+        BMP_NO_ERROR = 1,   // No error
+        BMP_FILE_NOT_FOUND, // File was not found or could not be mapped
+        BMP_BAD_HEADER,     // Not a BMP file or header fields are invalid
+        BMP_UNSUPPORTED,    // Compressed (RLE/JPEG/PNG) or unusual bit masks
+        BMP_TRUNCATED       // Pixel data runs past the end of the file
+    };
+
+    BmpView() :
+        m_nWidth(0), m_nHeight(0), m_nBits(0),
+        m_bTopDown(false), m_bAlpha(false),
+        m_pPixels(NULL), m_nStride(0),
+        m_pPalette(NULL), m_nPaletteCount(0) {}
+
+    BmpView(BmpView&&) = default;
+    BmpView& operator=(BmpView&&) = default;
+
+    // 파일을 매핑하고 헤더를 검증
+    BMPLoadError open(const char* path)
+    {
+        if (!m_file.open(path)) return BMP_FILE_NOT_FOUND;
+        BMPLoadError err = parse(m_file.data(), m_file.size());
+        if (err != BMP_NO_ERROR) m_file.close();
+        return err;
+    }
+
+    // 이미 메모리에 있는 BMP 이미지를 검증 (데이터 수명은 호출자가 보장)
+    BMPLoadError parse(const unsigned char* data, size_t size)
+    {
+        m_pPixels = NULL;
+        m_pPalette = NULL;
+        m_nPaletteCount = 0;
+        m_expanded.clear();
+
+        if (size < 14 + 40 || data[0] != 'B' || data[1] != 'M') return BMP_BAD_HEADER;
+
+        unsigned int dataOffset = readU32(data + 10);
+        unsigned int dibSize = readU32(data + 14);
+        if (dibSize < 40 || 14 + (size_t)dibSize > size) return BMP_BAD_HEADER;
+
+        int width = (int)readU32(data + 18);
+        int height = (int)readU32(data + 22);
+        int planes = readU16(data + 26);
+        int bits = readU16(data + 28);
+        unsigned int compression = readU32(data + 30);
+        unsigned int colorsUsed = readU32(data + 46);
+
+        if (planes != 1 || width <= 0 || height == 0 || width > 32768 || height > 32768 || height < -32768)
+            return BMP_BAD_HEADER;
+
+        m_bTopDown = (height < 0);
+        m_nWidth = width;
+        m_nHeight = m_bTopDown ? -height : height;
+        m_nBits = bits;
+        m_bAlpha = false;
+
+        const unsigned int BI_RGB = 0, BI_BITFIELDS = 3, BI_ALPHABITFIELDS = 6;
+        switch (bits)
+        {
+        case 1: case 4: case 8:
+            if (compression != BI_RGB) return BMP_UNSUPPORTED;
+            break;
+        case 24:
+            if (compression != BI_RGB) return BMP_UNSUPPORTED;
+            break;
+        case 32:
+            if (compression == BI_BITFIELDS || compression == BI_ALPHABITFIELDS)
+            {
+                // 마스크는 V4/V5 헤더 안, 혹은 40바이트 헤더 바로 뒤에 위치
+                if (14 + 40 + 16 > size) return BMP_BAD_HEADER;
+                const unsigned char* masks = data + 14 + 40;
+                if (readU32(masks) != 0x00FF0000 || readU32(masks + 4) != 0x0000FF00 || readU32(masks + 8) != 0x000000FF)
+                    return BMP_UNSUPPORTED;
+                bool alphaMask = (compression == BI_ALPHABITFIELDS || dibSize >= 56);
+                m_bAlpha = alphaMask && readU32(masks + 12) == 0xFF000000;
+            }
+            else if (compression != BI_RGB) return BMP_UNSUPPORTED;
+            break;
+        default:
+            return BMP_UNSUPPORTED;
+        }
+
+        if (bits <= 8)
+        {
+            int maxColors = 1 << bits;
+            m_nPaletteCount = (colorsUsed == 0 || colorsUsed > (unsigned int)maxColors) ? maxColors : (int)colorsUsed;
+            size_t paletteOffset = 14 + (size_t)dibSize;
+            if (paletteOffset + (size_t)m_nPaletteCount * 4 > size) return BMP_TRUNCATED;
+            m_pPalette = data + paletteOffset;
+        }
+
+        m_nStride = (((size_t)m_nWidth * bits + 31) / 32) * 4;
+        if (dataOffset < 14 + dibSize || (size_t)dataOffset + m_nStride * m_nHeight > size) return BMP_TRUNCATED;
+
+        m_pPixels = data + dataOffset;
+        return BMP_NO_ERROR;
+    }
+
+    // 팔레트 이미지나 top-down 이미지는 bottom-up 24/32bit BGR(A) 로 변환
+    // (바로 업로드 가능한 일반 BMP는 아무것도 하지 않음)
+    void normalize()
+    {
+        if (!m_pPixels || (!isPalettized() && !m_bTopDown)) return;
+
+        int outBits = isPalettized() ? 24 : m_nBits;
+        size_t outStride = (((size_t)m_nWidth * outBits + 31) / 32) * 4;
+        std::vector<unsigned char> out(outStride * m_nHeight, 0);
+
+        bool gray = isGrayPalette();
+        for (int y = 0; y < m_nHeight; y++)
+        {
+            const unsigned char* src = row(y);
+            unsigned char* dst = &out[outStride * y];
+            if (!isPalettized())
+            {
+                memcpy(dst, src, m_nStride);
+                continue;
+            }
+            if (gray)
+            {
+                // 인덱스 == 밝기 이므로 SIMD 그레이 확장으로 처리 (B=G=R 이라 순서 무관)
+                PixelConvert::ExpandGray(src, dst, m_nWidth, 3);
+                continue;
+            }
+            for (int x = 0; x < m_nWidth; x++)
+            {
+                const unsigned char* c = m_pPalette + 4 * paletteIndex(src, x);
+                dst[x * 3 + 0] = c[0];
+                dst[x * 3 + 1] = c[1];
+                dst[x * 3 + 2] = c[2];
+            }
+        }
+
+        m_expanded.swap(out);
+        m_pPixels = m_expanded.data();
+        m_nStride = outStride;
+        m_nBits = outBits;
+        m_bTopDown = false;
+        m_pPalette = NULL;
+        m_nPaletteCount = 0;
+    }
+
+    // 빈틈없이 채운 bottom-up RGB 버퍼 (new[] 할당, 호출자가 delete[])
+    unsigned char* decodeRGB() const
+    {
+        if (!m_pPixels) return NULL;
+        unsigned char* out = new unsigned char[(size_t)m_nWidth * m_nHeight * 3];
+        unsigned char* dst = out;
+        bool gray = isGrayPalette();
+        for (int y = 0; y < m_nHeight; y++)
+        {
+            const unsigned char* src = row(y);
+            if (m_nBits == 24 || gray)
+            {
+                if (gray) PixelConvert::ExpandGray(src, dst, m_nWidth, 3);
+                else PixelConvert::SwapRB24(src, dst, m_nWidth);
+                dst += (size_t)m_nWidth * 3;
+                continue;
+            }
+            for (int x = 0; x < m_nWidth; x++, dst += 3)
+            {
+                const unsigned char* c;
+                if (isPalettized()) c = m_pPalette + 4 * paletteIndex(src, x);
+                else c = src + x * (m_nBits / 8);
+                dst[0] = c[2]; dst[1] = c[1]; dst[2] = c[0];
+            }
+        }
+        return out;
+    }
+
+    // y = 0 이 맨 아래 행
+    const unsigned char* row(int y) const
+    {
+        int stored = m_bTopDown ? (m_nHeight - 1 - y) : y;
+        return m_pPixels + m_nStride * stored;
+    }
+
+    bool isPalettized() const { return m_nBits <= 8; }
+    bool isUploadable() const { return !isPalettized() && !m_bTopDown; }
+    size_t pixelBytes() const { return m_nStride * m_nHeight; }
+
+    int width() const { return m_nWidth; }
+    int height() const { return m_nHeight; }
+    int bitsPerPixel() const { return m_nBits; }
+    bool hasAlpha() const { return m_bAlpha; }
+    const unsigned char* pixels() const { return m_pPixels; }
+    size_t stride() const { return m_nStride; }
+
+private:
+    static unsigned int readU32(const unsigned char* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24); }
+    static unsigned int readU16(const unsigned char* p) { return p[0] | (p[1] << 8); }
+
+    // 8bit 이고 팔레트가 0..255 그레이 램프인지 (인덱스를 그대로 밝기로 쓸 수 있음)
+    bool isGrayPalette() const
+    {
+        if (m_nBits != 8 || m_nPaletteCount != 256) return false;
+        for (int i = 0; i < 256; i++)
+        {
+            const unsigned char* c = m_pPalette + 4 * i;
+            if (c[0] != i || c[1] != i || c[2] != i) return false;
+        }
+        return true;
+    }
+
+    int paletteIndex(const unsigned char* src, int x) const
+    {
+        int index;
+        if (m_nBits == 8) index = src[x];
+        else if (m_nBits == 4) index = (src[x >> 1] >> ((x & 1) ? 0 : 4)) & 0x0F;
+        else index = (src[x >> 3] >> (7 - (x & 7))) & 0x01;
+        return (index < m_nPaletteCount) ? index : 0;
+    }
+
+    MappedFile m_file;
+    std::vector<unsigned char> m_expanded;
+
+    int m_nWidth;
+    int m_nHeight;
+    int m_nBits;
+    bool m_bTopDown;
+    bool m_bAlpha;
+    const unsigned char* m_pPixels;
+    size_t m_nStride;
+    const unsigned char* m_pPalette;
+    int m_nPaletteCount;
+};
+
+#endif // BMP_VIEW_H_INCLUDED
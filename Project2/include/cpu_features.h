@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+//           Name: cpu_features.h
+//    Description: 런타임 CPU 기능 검사 (SSE2 / SSSE3 / SSE4.1 / AVX2 / FMA)
+//-----------------------------------------------------------------------------
+// SIMD 커널은 CPU_X86 일 때만 컴파일되고, 호출 전 CpuFeatures::get() 으로 분기합니다.
+// GCC/Clang 은 함수 단위 target 속성이 필요하므로 SIMD_TARGET_* 매크로를 붙여 정의합니다.
+
+#ifndef CPU_FEATURES_H_INCLUDED
+#define CPU_FEATURES_H_INCLUDED
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPU_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define CPU_X86 0
+#endif
+
+#if CPU_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_SSE2     __attribute__((target("sse2")))
+#define SIMD_TARGET_SSSE3    __attribute__((target("ssse3")))
+#define SIMD_TARGET_SSE41    __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2     __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#else
+#define SIMD_TARGET_SSE2
+#define SIMD_TARGET_SSSE3
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX2_FMA
+#endif
+
+struct CpuFeatures
+{
+    bool sse2;
+    bool ssse3;
+    bool sse41;
+    bool avx2;
+    bool fma;
+
+    // 최초 호출 시 한 번만 검사 (C++11 정적 지역 변수 초기화는 스레드 안전)
+    static const CpuFeatures& get()
+    {
+        static const CpuFeatures features = detect();
+        return features;
+    }
+
+private:
+    static CpuFeatures detect()
+    {
+        CpuFeatures f;
+        f.sse2 = f.ssse3 = f.sse41 = f.avx2 = f.fma = false;
+#if CPU_X86
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        f.sse2  = (info[3] & (1 << 26)) != 0;
+        f.ssse3 = (info[2] & (1 << 9)) != 0;
+        f.sse41 = (info[2] & (1 << 19)) != 0;
+        bool fma3 = (info[2] & (1 << 12)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+
+        // OS 가 YMM 레지스터 저장을 지원하는지 확인
+        bool ymmEnabled = osxsave && avx && ((_xgetbv(0) & 0x6) == 0x6);
+        if (ymmEnabled && maxLeaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            f.avx2 = (info[1] & (1 << 5)) != 0;
+            f.fma = f.avx2 && fma3;
+        }
+#else
+        __builtin_cpu_init();
+        f.sse2  = __builtin_cpu_supports("sse2") != 0;
+        f.ssse3 = __builtin_cpu_supports("ssse3") != 0;
+        f.sse41 = __builtin_cpu_supports("sse4.1") != 0;
+        f.avx2  = __builtin_cpu_supports("avx2") != 0;
+        f.fma   = f.avx2 && __builtin_cpu_supports("fma") != 0;
+#endif
+#endif
+        return f;
+    }
+};
+
+#endif // CPU_FEATURES_H_INCLUDED
@@ -0,0 +1,173 @@
+//-----------------------------------------------------------------------------
+//           Name: frustum_cull.h
+//    Description: 경계 구 + AABB 묶음의 절두체 컬링 (스칼라 / SSE2 / AVX2)
+//-----------------------------------------------------------------------------
+// 오브젝트마다 칸(slot) 하나를 받아 월드 경계 구(중심, 반지름) 와 AABB 를 SoA 배열에 둡니다.
+// 칸 값은 오브젝트가 움직였을 때만 set() 으로 바꾸고, cull() 은 매 프레임 전체 칸을 한 번에 검사.
+// 평면 (a, b, c, d) 은 a*x + b*y + c*z + d >= 0 이 안쪽 (정규화 안 된 평면도 됨: 구 검사만 정규화).
+// 한 평면이라도 구가 완전히 바깥이거나, AABB 의 가장 안쪽 꼭짓점이 바깥이면 컬링.
+//   Scalar : 칸 하나씩
+//   SSE2   : 4칸씩, AVX2 : 8칸씩 (평면마다 안쪽 꼭짓점 배열을 골라 읽으므로 gather 없음)
+// 세 경로의 결과는 같습니다 (같은 식, 같은 연산 순서).
+
+#ifndef FRUSTUM_CULL_H_INCLUDED
+#define FRUSTUM_CULL_H_INCLUDED
+
+#include <math.h>
+#include <vector>
+#include "cpu_features.h"
+
+class CullSet
+{
+public:
+    enum Path { PATH_SCALAR, PATH_SSE2, PATH_AVX2 };
+
+    // 새 칸 (처음엔 어디서나 보이는 무한 경계)
+    int add()
+    {
+        const float huge = 1e30f;
+        m_cx.push_back(0.0f); m_cy.push_back(0.0f); m_cz.push_back(0.0f); m_r.push_back(huge);
+        m_minX.push_back(-huge); m_minY.push_back(-huge); m_minZ.push_back(-huge);
+        m_maxX.push_back(huge); m_maxY.push_back(huge); m_maxZ.push_back(huge);
+        return (int)m_r.size() - 1;
+    }
+
+    void set(int slot, const float center[3], float radius, const float boxMin[3], const float boxMax[3])
+    {
+        m_cx[slot] = center[0]; m_cy[slot] = center[1]; m_cz[slot] = center[2]; m_r[slot] = radius;
+        m_minX[slot] = boxMin[0]; m_minY[slot] = boxMin[1]; m_minZ[slot] = boxMin[2];
+        m_maxX[slot] = boxMax[0]; m_maxY[slot] = boxMax[1]; m_maxZ[slot] = boxMax[2];
+    }
+
+    size_t size() const { return m_r.size(); }
+
+    // 지원되는 가장 넓은 경로
+    static Path bestPath()
+    {
+#if CPU_X86
+        const CpuFeatures& cpu = CpuFeatures::get();
+        if (cpu.avx2) return PATH_AVX2;
+        if (cpu.sse2) return PATH_SSE2;
+#endif
+        return PATH_SCALAR;
+    }
+
+    static const char* pathName(Path path)
+    {
+        return path == PATH_AVX2 ? "avx2" : (path == PATH_SSE2 ? "sse2" : "scalar");
+    }
+
+    // visible[slot] = 1 (보임) / 0 (컬링). 반환: 보이는 칸 수
+    size_t cull(const float planes[6][4], unsigned char* visible, Path path) const
+    {
+        Plane p[6];
+        for (int i = 0; i < 6; i++)
+        {
+            float len = sqrtf(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+            float inv = (len > 0.0f) ? 1.0f / len : 0.0f;
+            for (int k = 0; k < 4; k++) p[i].n[k] = planes[i][k] * inv;
+        }
+
+        size_t count = size(), done = 0;
+#if CPU_X86
+        if (path == PATH_AVX2) done = cullAVX2(p, visible, count);
+        else if (path == PATH_SSE2) done = cullSSE2(p, visible, count);
+#endif
+        for (size_t i = done; i < count; i++) visible[i] = testOne(p, i) ? 1 : 0;
+
+        size_t n = 0;
+        for (size_t i = 0; i < count; i++) n += visible[i];
+        return n;
+    }
+
+    size_t cull(const float planes[6][4], unsigned char* visible) const { return cull(planes, visible, bestPath()); }
+
+private:
+    struct Plane { float n[4]; };     // 정규화된 평면 (법선 길이 1)
+
+    // 평면마다 AABB 의 가장 안쪽 꼭짓점 축별 배열 (법선 부호로 고름)
+    void pickVertex(const Plane& p, const float*& x, const float*& y, const float*& z) const
+    {
+        x = (p.n[0] >= 0.0f) ? m_maxX.data() : m_minX.data();
+        y = (p.n[1] >= 0.0f) ? m_maxY.data() : m_minY.data();
+        z = (p.n[2] >= 0.0f) ? m_maxZ.data() : m_minZ.data();
+    }
+
+    bool testOne(const Plane* p, size_t i) const
+    {
+        for (int k = 0; k < 6; k++)
+        {
+            const float* n = p[k].n;
+            float sphere = n[0] * m_cx[i] + n[1] * m_cy[i] + n[2] * m_cz[i] + n[3];
+            if (sphere < -m_r[i]) return false;
+
+            const float *x, *y, *z;
+            pickVertex(p[k], x, y, z);
+            if (n[0] * x[i] + n[1] * y[i] + n[2] * z[i] + n[3] < 0.0f) return false;
+        }
+        return true;
+    }
+
+#if CPU_X86
+    SIMD_TARGET_SSE2 size_t cullSSE2(const Plane* p, unsigned char* visible, size_t count) const
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 cx = _mm_loadu_ps(&m_cx[i]), cy = _mm_loadu_ps(&m_cy[i]), cz = _mm_loadu_ps(&m_cz[i]);
+            __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&m_r[i]));
+            __m128 out = _mm_setzero_ps();
+            for (int k = 0; k < 6; k++)
+            {
+                const float* n = p[k].n;
+                __m128 a = _mm_set1_ps(n[0]), b = _mm_set1_ps(n[1]), c = _mm_set1_ps(n[2]), d = _mm_set1_ps(n[3]);
+                __m128 sphere = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a, cx), _mm_mul_ps(b, cy)), _mm_mul_ps(c, cz)), d);
+                out = _mm_or_ps(out, _mm_cmplt_ps(sphere, negR));
+
+                const float *x, *y, *z;
+                pickVertex(p[k], x, y, z);
+                __m128 box = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a, _mm_loadu_ps(x + i)), _mm_mul_ps(b, _mm_loadu_ps(y + i))),
+                                                   _mm_mul_ps(c, _mm_loadu_ps(z + i))), d);
+                out = _mm_or_ps(out, _mm_cmplt_ps(box, _mm_setzero_ps()));
+            }
+            int mask = _mm_movemask_ps(out);
+            for (int j = 0; j < 4; j++) visible[i + j] = (mask >> j) & 1 ? 0 : 1;
+        }
+        return i;
+    }
+
+    SIMD_TARGET_AVX2 size_t cullAVX2(const Plane* p, unsigned char* visible, size_t count) const
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 cx = _mm256_loadu_ps(&m_cx[i]), cy = _mm256_loadu_ps(&m_cy[i]), cz = _mm256_loadu_ps(&m_cz[i]);
+            __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&m_r[i]));
+            __m256 out = _mm256_setzero_ps();
+            for (int k = 0; k < 6; k++)
+            {
+                const float* n = p[k].n;
+                __m256 a = _mm256_set1_ps(n[0]), b = _mm256_set1_ps(n[1]), c = _mm256_set1_ps(n[2]), d = _mm256_set1_ps(n[3]);
+                __m256 sphere = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, cx), _mm256_mul_ps(b, cy)), _mm256_mul_ps(c, cz)), d);
+                out = _mm256_or_ps(out, _mm256_cmp_ps(sphere, negR, _CMP_LT_OQ));
+
+                const float *x, *y, *z;
+                pickVertex(p[k], x, y, z);
+                __m256 box = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, _mm256_loadu_ps(x + i)), _mm256_mul_ps(b, _mm256_loadu_ps(y + i))),
+                                                         _mm256_mul_ps(c, _mm256_loadu_ps(z + i))), d);
+                out = _mm256_or_ps(out, _mm256_cmp_ps(box, _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+            int mask = _mm256_movemask_ps(out);
+            for (int j = 0; j < 8; j++) visible[i + j] = (mask >> j) & 1 ? 0 : 1;
+        }
+        return i;
+    }
+#endif
+
+    // SoA: 중심, 반지름, AABB 최소/최대
+    std::vector<float> m_cx, m_cy, m_cz, m_r;
+    std::vector<float> m_minX, m_minY, m_minZ;
+    std::vector<float> m_maxX, m_maxY, m_maxZ;
+};
+
+#endif // FRUSTUM_CULL_H_INCLUDED
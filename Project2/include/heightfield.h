@@ -0,0 +1,175 @@
+//-----------------------------------------------------------------------------
+//           Name: heightfield.h
+//    Description: 8bit RAW 높이맵 -> float 높이장, 바이리니어 높이 질의 (스칼라 / AVX2)
+//-----------------------------------------------------------------------------
+// 샘플 (i, j) 의 월드 위치는 (originX + i * spacing, originZ + j * spacing), spacing = worldSize / size.
+// 범위 밖 질의는 가장자리로 고정(clamp). 질의 비용은 위치와 무관하게 일정합니다.
+//   Sample      : 한 점 (스칼라. SSE2 로 네 모서리를 모으는 쪽은 셔플 비용 때문에 더 느렸음)
+//   SampleBatch : 여러 점. AVX2 가 있으면 8개씩 gather + FMA, 나머지는 스칼라
+// 렌더러(CDLOD)는 같은 배열을 GL_R32F 텍스처로 올려서 GPU 바이리니어와 값이 맞습니다.
+
+#ifndef HEIGHTFIELD_H_INCLUDED
+#define HEIGHTFIELD_H_INCLUDED
+
+#include <math.h>
+#include <vector>
+#include "cpu_features.h"
+#include "mapped_file.h"
+
+class HeightField
+{
+public:
+    HeightField() : m_size(0), m_originX(0.0f), m_originZ(0.0f), m_worldSize(1.0f), m_invSpacing(1.0f) {}
+
+    // size x size 8bit RAW. 높이 = value / 255 * heightScale + heightBias
+    bool load(const char* path, int size, float originX, float originZ, float worldSize, float heightScale, float heightBias)
+    {
+        MappedFile file;
+        size_t count = (size_t)size * size;
+        if (!file.open(path) || file.size() < count) return false;
+
+        const unsigned char* raw = file.data();
+        m_heights.resize(count);
+        for (size_t i = 0; i < count; i++) m_heights[i] = raw[i] / 255.0f * heightScale + heightBias;
+        m_size = size;
+        m_originX = originX;
+        m_originZ = originZ;
+        m_worldSize = worldSize;
+        m_invSpacing = size / worldSize;
+        return true;
+    }
+
+    bool isLoaded() const { return m_size > 0; }
+    int size() const { return m_size; }
+    float originX() const { return m_originX; }
+    float originZ() const { return m_originZ; }
+    float worldSize() const { return m_worldSize; }
+    const float* data() const { return m_heights.data(); }
+    float at(int i, int j) const { return m_heights[(size_t)j * m_size + i]; }
+
+    // 사각형 [minX, maxX] x [minZ, maxZ] 안은 height 이하로 누르고, 바깥 falloff 거리 동안 원래 높이로 복귀
+    // (방 바닥 밑으로 지형이 튀어나오지 않게)
+    void flattenRect(float minX, float minZ, float maxX, float maxZ, float height, float falloff)
+    {
+        for (int j = 0; j < m_size; j++)
+        {
+            float z = m_originZ + j / m_invSpacing;
+            float dz = (z < minZ) ? minZ - z : (z > maxZ ? z - maxZ : 0.0f);
+            for (int i = 0; i < m_size; i++)
+            {
+                float x = m_originX + i / m_invSpacing;
+                float dx = (x < minX) ? minX - x : (x > maxX ? x - maxX : 0.0f);
+                float d = sqrtf(dx * dx + dz * dz);
+                if (d >= falloff) continue;
+
+                float t = d / falloff;
+                t = t * t * (3.0f - 2.0f * t);
+                float& h = m_heights[(size_t)j * m_size + i];
+                float limit = height + (h - height) * t;
+                if (h > limit) h = limit;
+            }
+        }
+    }
+
+    // 블록(blockSize x blockSize 칸, 마지막 샘플 공유) 의 최소/최대 높이
+    void blockMinMax(int i0, int j0, int blockSize, float& outMin, float& outMax) const
+    {
+        int i1 = (i0 + blockSize < m_size) ? i0 + blockSize : m_size - 1;
+        int j1 = (j0 + blockSize < m_size) ? j0 + blockSize : m_size - 1;
+        outMin = outMax = at(i0, j0);
+        for (int j = j0; j <= j1; j++)
+        {
+            const float* row = &m_heights[(size_t)j * m_size];
+            for (int i = i0; i <= i1; i++)
+            {
+                if (row[i] < outMin) outMin = row[i];
+                if (row[i] > outMax) outMax = row[i];
+            }
+        }
+    }
+
+    float SampleScalar(float x, float z) const
+    {
+        int i, j;
+        float fx, fz;
+        Cell(x, z, i, j, fx, fz);
+        const float* p = &m_heights[(size_t)j * m_size + i];
+        float top = p[0] + (p[1] - p[0]) * fx;
+        float bottom = p[m_size] + (p[m_size + 1] - p[m_size]) * fx;
+        return top + (bottom - top) * fz;
+    }
+
+    float Sample(float x, float z) const { return SampleScalar(x, z); }
+
+    void SampleBatch(const float* xs, const float* zs, float* out, size_t count) const
+    {
+        size_t done = 0;
+#if CPU_X86
+        const CpuFeatures& cpu = CpuFeatures::get();
+        if (cpu.avx2 && cpu.fma) done = SampleBatchAVX2(xs, zs, out, count);
+#endif
+        for (size_t i = done; i < count; i++) out[i] = SampleScalar(xs[i], zs[i]);
+    }
+
+private:
+    // 셀 좌하단 샘플 (i, j) 과 셀 안의 비율. 오른쪽/위 이웃이 항상 있도록 size - 2 까지
+    void Cell(float x, float z, int& i, int& j, float& fx, float& fz) const
+    {
+        float gx = (x - m_originX) * m_invSpacing;
+        float gz = (z - m_originZ) * m_invSpacing;
+        float maxCoord = (float)(m_size - 1);
+        gx = (gx < 0.0f) ? 0.0f : (gx > maxCoord ? maxCoord : gx);
+        gz = (gz < 0.0f) ? 0.0f : (gz > maxCoord ? maxCoord : gz);
+        i = (int)gx;
+        j = (int)gz;
+        if (i > m_size - 2) i = m_size - 2;
+        if (j > m_size - 2) j = m_size - 2;
+        fx = gx - i;
+        fz = gz - j;
+    }
+
+#if CPU_X86
+    SIMD_TARGET_AVX2_FMA size_t SampleBatchAVX2(const float* xs, const float* zs, float* out, size_t count) const
+    {
+        const __m256 ox = _mm256_set1_ps(m_originX), oz = _mm256_set1_ps(m_originZ);
+        const __m256 inv = _mm256_set1_ps(m_invSpacing);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 maxCoord = _mm256_set1_ps((float)(m_size - 1));
+        const __m256i maxCell = _mm256_set1_epi32(m_size - 2);
+        const __m256i stride = _mm256_set1_epi32(m_size);
+        const float* base = m_heights.data();
+
+        size_t n = 0;
+        for (; n + 8 <= count; n += 8)
+        {
+            __m256 gx = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(xs + n), ox), inv);
+            __m256 gz = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(zs + n), oz), inv);
+            gx = _mm256_min_ps(_mm256_max_ps(gx, zero), maxCoord);
+            gz = _mm256_min_ps(_mm256_max_ps(gz, zero), maxCoord);
+            __m256i i = _mm256_min_epi32(_mm256_cvttps_epi32(gx), maxCell);
+            __m256i j = _mm256_min_epi32(_mm256_cvttps_epi32(gz), maxCell);
+            __m256 fx = _mm256_sub_ps(gx, _mm256_cvtepi32_ps(i));
+            __m256 fz = _mm256_sub_ps(gz, _mm256_cvtepi32_ps(j));
+
+            __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(j, stride), i);
+            __m256 h00 = _mm256_i32gather_ps(base, idx, 4);
+            __m256 h10 = _mm256_i32gather_ps(base + 1, idx, 4);
+            __m256 h01 = _mm256_i32gather_ps(base + m_size, idx, 4);
+            __m256 h11 = _mm256_i32gather_ps(base + m_size + 1, idx, 4);
+
+            __m256 top = _mm256_fmadd_ps(_mm256_sub_ps(h10, h00), fx, h00);
+            __m256 bottom = _mm256_fmadd_ps(_mm256_sub_ps(h11, h01), fx, h01);
+            _mm256_storeu_ps(out + n, _mm256_fmadd_ps(_mm256_sub_ps(bottom, top), fz, top));
+        }
+        return n;
+    }
+#endif
+
+    std::vector<float> m_heights;
+    int m_size;
+    float m_originX, m_originZ;
+    float m_worldSize;
+    float m_invSpacing;
+};
+
+#endif // HEIGHTFIELD_H_INCLUDED
@@ -0,0 +1,617 @@
+//-----------------------------------------------------------------------------
+//           Name: jpeg_decoder.h
+//    Description: 베이스라인 JPEG 디코더 (허프만, 재시작 마커, 서브샘플링, DCT 영역 축소)
+//-----------------------------------------------------------------------------
+// 지원: SOF0/SOF1 (8bit 허프만), 그레이 1채널 / YCbCr 3채널, 샘플링 1x1 ~ 2x2, DRI/RSTn,
+//       인터리브/비인터리브 스캔. 프로그레시브/산술 부호화/12bit 는 JPEG_UNSUPPORTED.
+//
+// decode(scale) 의 scale 은 1, 2, 4, 8: 8x8 블록을 (8/scale) 크기로 바로 역DCT 합니다.
+// 낮은 주파수 계수만 쓰므로 풀 해상도로 디코딩한 뒤 줄이는 것보다 훨씬 싸고,
+// scale 8 은 DC 만 써서 역DCT 자체가 없습니다 (밉 꼬리를 빠르게 얻는 용도).
+// 허프만 해독은 모든 계수를 거쳐야 하므로 scale 과 무관하게 일정한 비용입니다.
+//
+// 출력은 top-down, 빈틈없는 components() 채널 (1: 그레이, 3: RGB) 8bit 버퍼.
+
+#ifndef JPEG_DECODER_H_INCLUDED
+#define JPEG_DECODER_H_INCLUDED
+
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "mapped_file.h"
+
+class JpegDecoder
+{
+public:
+    enum JpegError
+    {
+        JPEG_NO_ERROR = 1,  // No error
+        JPEG_FILE_NOT_FOUND,
+        JPEG_BAD_HEADER,    // Missing SOI/SOF/SOS or malformed segment
+        JPEG_UNSUPPORTED,   // Progressive, arithmetic, 12-bit, CMYK or unusual sampling
+        JPEG_BAD_DATA       // Entropy-coded data could not be decoded
+    };
+
+    JpegDecoder() : m_data(NULL), m_size(0), m_width(0), m_height(0), m_componentCount(0),
+                    m_restartInterval(0), m_maxH(1), m_maxV(1), m_mcusX(0), m_mcusY(0), m_scanStart(0), m_scanCount(0)
+    {
+        memset(m_huff, 0, sizeof(m_huff));
+        memset(m_quant, 0, sizeof(m_quant));
+    }
+
+    // 파일을 매핑하고 첫 스캔 직전까지 헤더를 읽음
+    JpegError open(const char* path)
+    {
+        if (!m_file.open(path)) return JPEG_FILE_NOT_FOUND;
+        return parse(m_file.data(), m_file.size());
+    }
+
+    // 메모리 위의 JPEG (decode 가 끝날 때까지 data 가 살아 있어야 함)
+    JpegError parse(const unsigned char* data, size_t size)
+    {
+        m_data = data;
+        m_size = size;
+        m_width = m_height = m_componentCount = 0;
+        m_restartInterval = 0;
+        if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) return JPEG_BAD_HEADER;
+        size_t pos = 2;
+        JpegError err = readSegments(pos, true);
+        if (err != JPEG_NO_ERROR) return err;
+        if (m_componentCount == 0) return JPEG_BAD_HEADER;
+        m_scanStart = pos;
+        return JPEG_NO_ERROR;
+    }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int components() const { return m_componentCount == 1 ? 1 : 3; }
+
+    static int ScaledSize(int size, int scale) { return (size + scale - 1) / scale; }
+
+    // scale: 1, 2, 4, 8. out 은 ScaledSize(width) x ScaledSize(height) x components()
+    JpegError decode(int scale, std::vector<unsigned char>& out, int& outW, int& outH)
+    {
+        if (scale != 1 && scale != 2 && scale != 4 && scale != 8) return JPEG_UNSUPPORTED;
+        if (!m_data || m_componentCount == 0) return JPEG_BAD_HEADER;
+        int n = 8 / scale;
+        buildIdctTable(n);
+
+        // 컴포넌트 평면: MCU 경계까지 채운 크기 (블록 하나 = n x n)
+        int mcuW = 8 * m_maxH, mcuH = 8 * m_maxV;
+        m_mcusX = (m_width + mcuW - 1) / mcuW;
+        m_mcusY = (m_height + mcuH - 1) / mcuH;
+        for (int c = 0; c < m_componentCount; c++)
+        {
+            Component& comp = m_comp[c];
+            comp.blocksW = m_mcusX * comp.h;
+            comp.blocksH = m_mcusY * comp.v;
+            comp.planeW = comp.blocksW * n;
+            comp.plane.assign((size_t)comp.planeW * comp.blocksH * n, 0);
+        }
+
+        // 스캔들을 EOI 까지 (베이스라인은 보통 인터리브 스캔 하나)
+        size_t pos = m_scanStart;
+        bool first = true;
+        for (;;)
+        {
+            if (!first)
+            {
+                JpegError err = readSegments(pos, false);
+                if (err != JPEG_NO_ERROR) return err;
+                if (pos >= m_size) break;
+            }
+            first = false;
+            if (m_scanCount == 0) break;
+            JpegError err = decodeScan(pos, n);
+            if (err != JPEG_NO_ERROR) return err;
+            m_scanCount = 0;
+        }
+
+        outW = ScaledSize(m_width, scale);
+        outH = ScaledSize(m_height, scale);
+        writeOutput(outW, outH, out);
+        return JPEG_NO_ERROR;
+    }
+
+private:
+    enum { FAST_BITS = 9 };
+
+    struct Huffman
+    {
+        unsigned char fast[1 << FAST_BITS];     // 짧은 부호 -> 값 인덱스 (255 = 느린 경로)
+        unsigned char fastLength[1 << FAST_BITS];
+        unsigned short code[256];
+        unsigned char values[256];
+        unsigned char length[257];
+        unsigned int maxCode[18];
+        int delta[17];
+        bool defined;
+    };
+
+    struct Component
+    {
+        int id, h, v, quant;
+        int dcTable, acTable;
+        int dcPred;
+        int blocksW, blocksH;
+        int planeW;
+        std::vector<unsigned char> plane;
+    };
+
+    // ------------------------------------------------------------ segments
+
+    static unsigned int Read16(const unsigned char* p) { return ((unsigned int)p[0] << 8) | p[1]; }
+
+    // header: SOS 를 만나면 멈춤. 아니면 다음 스캔(SOS) 이나 EOI 까지
+    JpegError readSegments(size_t& pos, bool header)
+    {
+        m_scanCount = 0;
+        while (pos + 4 <= m_size)
+        {
+            if (m_data[pos] != 0xFF)
+            {
+                pos++;  // 스캔 뒤 남은 바이트는 건너뜀
+                continue;
+            }
+            unsigned char marker = m_data[pos + 1];
+            if (marker == 0xFF) { pos++; continue; }
+            if (marker == 0xD9) { pos = m_size; return header ? JPEG_BAD_HEADER : JPEG_NO_ERROR; }
+            if (marker == 0xD8 || (marker >= 0xD0 && marker <= 0xD7) || marker <= 0x01) { pos += 2; continue; }
+
+            unsigned int length = Read16(m_data + pos + 2);
+            if (length < 2 || pos + 2 + length > m_size) return JPEG_BAD_HEADER;
+            const unsigned char* seg = m_data + pos + 4;
+            size_t segSize = length - 2;
+            pos += 2 + length;
+
+            switch (marker)
+            {
+            case 0xC0:
+            case 0xC1:
+                if (!readFrame(seg, segSize)) return JPEG_BAD_HEADER;
+                if (m_componentCount == 0) return JPEG_UNSUPPORTED;
+                break;
+            case 0xC2: case 0xC3: case 0xC5: case 0xC6: case 0xC7:
+            case 0xC9: case 0xCA: case 0xCB: case 0xCD: case 0xCE: case 0xCF:
+                return JPEG_UNSUPPORTED;
+            case 0xC4:
+                if (!readHuffman(seg, segSize)) return JPEG_BAD_HEADER;
+                break;
+            case 0xDB:
+                if (!readQuant(seg, segSize)) return JPEG_BAD_HEADER;
+                break;
+            case 0xDD:
+                if (segSize < 2) return JPEG_BAD_HEADER;
+                m_restartInterval = (int)Read16(seg);
+                break;
+            case 0xDA:
+                if (!readScan(seg, segSize)) return JPEG_BAD_HEADER;
+                return JPEG_NO_ERROR;
+            default:
+                break;  // APPn, COM, DNL 등
+            }
+        }
+        return header ? JPEG_BAD_HEADER : JPEG_NO_ERROR;
+    }
+
+    bool readFrame(const unsigned char* p, size_t size)
+    {
+        if (size < 6 || p[0] != 8) return false;
+        m_height = (int)Read16(p + 1);
+        m_width = (int)Read16(p + 3);
+        int count = p[5];
+        if (m_width <= 0 || m_height <= 0 || m_width > 16384 || m_height > 16384) return false;
+        if ((count != 1 && count != 3) || size < 6 + (size_t)count * 3)
+        {
+            m_componentCount = 0;
+            return true;    // 호출자가 UNSUPPORTED 로
+        }
+
+        m_maxH = m_maxV = 1;
+        for (int c = 0; c < count; c++)
+        {
+            Component& comp = m_comp[c];
+            comp.id = p[6 + c * 3];
+            comp.h = p[7 + c * 3] >> 4;
+            comp.v = p[7 + c * 3] & 15;
+            comp.quant = p[8 + c * 3] & 3;
+            if (comp.h < 1 || comp.h > 2 || comp.v < 1 || comp.v > 2) return false;
+            if (comp.h > m_maxH) m_maxH = comp.h;
+            if (comp.v > m_maxV) m_maxV = comp.v;
+        }
+        // 그레이는 샘플링 값과 무관하게 1x1 로 처리
+        if (count == 1) m_comp[0].h = m_comp[0].v = m_maxH = m_maxV = 1;
+        m_componentCount = count;
+        return true;
+    }
+
+    bool readQuant(const unsigned char* p, size_t size)
+    {
+        size_t i = 0;
+        while (i < size)
+        {
+            int precision = p[i] >> 4, id = p[i] & 3;
+            i++;
+            size_t bytes = precision ? 128 : 64;
+            if (i + bytes > size) return false;
+            for (int k = 0; k < 64; k++)
+                m_quant[id][k] = precision ? (unsigned short)Read16(p + i + k * 2) : p[i + k];
+            i += bytes;
+        }
+        return true;
+    }
+
+    bool readHuffman(const unsigned char* p, size_t size)
+    {
+        size_t i = 0;
+        while (i + 17 <= size)
+        {
+            int tableClass = p[i] >> 4, id = p[i] & 3;
+            if (tableClass > 1) return false;
+            const unsigned char* counts = p + i + 1;
+            int total = 0;
+            for (int k = 0; k < 16; k++) total += counts[k];
+            if (total > 256 || i + 17 + total > size) return false;
+            if (!buildHuffman(m_huff[tableClass][id], counts, p + i + 17)) return false;
+            i += 17 + total;
+        }
+        return true;
+    }
+
+    // 길이별 부호 수 -> 정규 허프만 부호 (짧은 부호는 FAST_BITS 표로 바로 찾음)
+    static bool buildHuffman(Huffman& h, const unsigned char* counts, const unsigned char* values)
+    {
+        int k = 0;
+        for (int len = 1; len <= 16; len++)
+            for (int i = 0; i < counts[len - 1]; i++) h.length[k++] = (unsigned char)len;
+        h.length[k] = 0;
+        memcpy(h.values, values, k);
+
+        unsigned int code = 0;
+        int j = 0;
+        for (int len = 1; len <= 16; len++)
+        {
+            h.delta[len] = j - (int)code;
+            if (h.length[j] == len)
+            {
+                while (h.length[j] == len) h.code[j++] = (unsigned short)code++;
+                if (code - 1 >= (1u << len)) return false;
+            }
+            h.maxCode[len] = code << (16 - len);    // 16bit 로 정렬해 비교
+            code <<= 1;
+        }
+        h.maxCode[17] = 0xFFFFFFFFu;
+
+        memset(h.fast, 255, sizeof(h.fast));
+        for (int i = 0; i < k; i++)
+        {
+            int len = h.length[i];
+            if (len > FAST_BITS) continue;
+            int c = h.code[i] << (FAST_BITS - len);
+            int n = 1 << (FAST_BITS - len);
+            for (int m = 0; m < n; m++)
+            {
+                h.fast[c + m] = (unsigned char)i;
+                h.fastLength[c + m] = (unsigned char)len;
+            }
+        }
+        h.defined = true;
+        return true;
+    }
+
+    bool readScan(const unsigned char* p, size_t size)
+    {
+        if (size < 1) return false;
+        int count = p[0];
+        if (count < 1 || count > m_componentCount || size < 4 + (size_t)count * 2) return false;
+        for (int i = 0; i < count; i++)
+        {
+            int id = p[1 + i * 2];
+            int which = -1;
+            for (int c = 0; c < m_componentCount; c++)
+                if (m_comp[c].id == id) which = c;
+            if (which < 0) return false;
+            m_comp[which].dcTable = p[2 + i * 2] >> 4;
+            m_comp[which].acTable = p[2 + i * 2] & 3;
+            if (m_comp[which].dcTable > 3) return false;
+            m_scanComp[i] = which;
+        }
+        m_scanCount = count;
+        return true;
+    }
+
+    // ------------------------------------------------------------ entropy
+
+    struct BitReader
+    {
+        const unsigned char* p;
+        const unsigned char* end;
+        unsigned int bits;      // MSB 부터 유효
+        int count;
+        bool marker;            // 마커를 만나면 이후는 0 으로 채움
+
+        void fill()
+        {
+            while (count <= 24)
+            {
+                unsigned int b = 0;
+                if (!marker && p < end)
+                {
+                    b = *p++;
+                    if (b == 0xFF)
+                    {
+                        unsigned int next = (p < end) ? *p : 0;
+                        if (next == 0) p++;
+                        else
+                        {
+                            marker = true;
+                            p--;
+                            b = 0;
+                        }
+                    }
+                }
+                bits |= b << (24 - count);
+                count += 8;
+            }
+        }
+
+        unsigned int peek(int n) { if (count < n) fill(); return bits >> (32 - n); }
+        void skip(int n) { bits <<= n; count -= n; }
+
+        int receive(int n)
+        {
+            if (n == 0) return 0;
+            unsigned int v = peek(n);
+            skip(n);
+            // 부호 확장: 최상위 비트가 0 이면 음수
+            return (v < (1u << (n - 1))) ? (int)v - (1 << n) + 1 : (int)v;
+        }
+
+        // RSTn 으로 정렬하고 상태를 비움
+        void restart()
+        {
+            bits = 0;
+            count = 0;
+            marker = false;
+            while (p + 1 < end && !(p[0] == 0xFF && p[1] >= 0xD0 && p[1] <= 0xD7)) p++;
+            if (p + 1 < end) p += 2;
+        }
+    };
+
+    static int DecodeSymbol(BitReader& br, const Huffman& h)
+    {
+        unsigned int look = br.peek(16);
+        int i = h.fast[look >> (16 - FAST_BITS)];
+        if (i != 255)
+        {
+            br.skip(h.fastLength[look >> (16 - FAST_BITS)]);
+            return h.values[i];
+        }
+        int len = FAST_BITS + 1;
+        while (look >= h.maxCode[len]) len++;
+        if (len > 16) return -1;
+        br.skip(len);
+        int index = (int)(look >> (16 - len)) + h.delta[len];
+        if (index < 0 || index > 255) return -1;
+        return h.values[index];
+    }
+
+    // 계수 하나 블록을 해독해 coef (자연 순서, 역양자화 적용) 에. 마지막 0 아닌 지그재그 위치를 반환
+    int decodeBlock(BitReader& br, Component& comp, int* coef, int n)
+    {
+        const Huffman& dc = m_huff[0][comp.dcTable];
+        const Huffman& ac = m_huff[1][comp.acTable];
+        const unsigned short* q = m_quant[comp.quant];
+
+        int t = DecodeSymbol(br, dc);
+        if (t < 0 || t > 11) return -1;
+        comp.dcPred += br.receive(t);
+        coef[0] = comp.dcPred * q[0];
+
+        // n 보다 바깥 계수는 쓰지 않으므로 해독만 하고 버림
+        int last = 0;
+        for (int k = 1; k < 64;)
+        {
+            int rs = DecodeSymbol(br, ac);
+            if (rs < 0) return -1;
+            int run = rs >> 4, s = rs & 15;
+            if (s == 0)
+            {
+                if (run != 15) break;   // EOB
+                k += 16;
+                continue;
+            }
+            k += run;
+            if (k > 63) return -1;
+            int v = br.receive(s);
+            int z = ZigZag()[k];
+            if ((z & 7) < n && (z >> 3) < n)
+            {
+                coef[z] = v * q[k];
+                last = k;
+            }
+            k++;
+        }
+        return last;
+    }
+
+    JpegError decodeScan(size_t& pos, int n)
+    {
+        for (int i = 0; i < m_scanCount; i++)
+        {
+            Component& comp = m_comp[m_scanComp[i]];
+            if (!m_huff[0][comp.dcTable].defined || !m_huff[1][comp.acTable].defined) return JPEG_BAD_DATA;
+            comp.dcPred = 0;
+        }
+
+        BitReader br;
+        br.p = m_data + pos;
+        br.end = m_data + m_size;
+        br.bits = 0;
+        br.count = 0;
+        br.marker = false;
+
+        int coef[64];
+        unsigned char block[64];
+        int restartsLeft = m_restartInterval;
+
+        // 인터리브: MCU 단위, 비인터리브(컴포넌트 하나): 그 컴포넌트의 블록 단위
+        bool interleaved = m_scanCount > 1;
+        Component& single = m_comp[m_scanComp[0]];
+        int unitsX = interleaved ? m_mcusX : ComponentBlocks(m_width, single.h, m_maxH);
+        int unitsY = interleaved ? m_mcusY : ComponentBlocks(m_height, single.v, m_maxV);
+
+        for (int uy = 0; uy < unitsY; uy++)
+        {
+            for (int ux = 0; ux < unitsX; ux++)
+            {
+                if (m_restartInterval && restartsLeft == 0)
+                {
+                    br.restart();
+                    restartsLeft = m_restartInterval;
+                    for (int i = 0; i < m_scanCount; i++) m_comp[m_scanComp[i]].dcPred = 0;
+                }
+
+                for (int i = 0; i < m_scanCount; i++)
+                {
+                    Component& comp = m_comp[m_scanComp[i]];
+                    int bh = interleaved ? comp.h : 1, bv = interleaved ? comp.v : 1;
+                    for (int by = 0; by < bv; by++)
+                    {
+                        for (int bx = 0; bx < bh; bx++)
+                        {
+                            memset(coef, 0, sizeof(coef));
+                            int last = decodeBlock(br, comp, coef, n);
+                            if (last < 0) return JPEG_BAD_DATA;
+
+                            int blockX = interleaved ? ux * comp.h + bx : ux;
+                            int blockY = interleaved ? uy * comp.v + by : uy;
+                            idct(coef, last, n, block);
+                            unsigned char* dst = &comp.plane[((size_t)blockY * n) * comp.planeW + (size_t)blockX * n];
+                            for (int y = 0; y < n; y++) memcpy(dst + (size_t)y * comp.planeW, block + y * n, n);
+                        }
+                    }
+                }
+                if (m_restartInterval) restartsLeft--;
+            }
+        }
+
+        // 다음 세그먼트 위치: 리더가 멈춘 곳부터 마커를 찾음
+        pos = (size_t)(br.p - m_data);
+        return JPEG_NO_ERROR;
+    }
+
+    // 비인터리브 스캔의 블록 수 (MCU 패딩 없이 컴포넌트 실제 크기 기준)
+    static int ComponentBlocks(int size, int sampling, int maxSampling)
+    {
+        int compSize = (size * sampling + maxSampling - 1) / maxSampling;
+        return (compSize + 7) / 8;
+    }
+
+    // ------------------------------------------------------------ IDCT / output
+
+    // table[k * 8 + u] = c(u) / 2 * cos((2k + 1) u pi / 2n), c(0) = 1/sqrt(2)
+    void buildIdctTable(int n)
+    {
+        for (int k = 0; k < n; k++)
+            for (int u = 0; u < n; u++)
+                m_idct[k * 8 + u] = (float)((u == 0 ? 0.70710678 : 1.0) * 0.5 * cos((2 * k + 1) * u * 3.14159265358979 / (2 * n)));
+    }
+
+    // n x n 축소 역DCT (분리형). DC 만 있으면 상수 채우기
+    void idct(const int* coef, int last, int n, unsigned char* out) const
+    {
+        if (last == 0)
+        {
+            int v = (int)floorf(coef[0] * 0.125f + 128.5f);
+            memset(out, Clamp(v), n * n);
+            return;
+        }
+
+        float tmp[64];
+        for (int u = 0; u < n; u++)          // 열: tmp[y][u] = sum_v T[y][v] F[v][u]
+        {
+            for (int y = 0; y < n; y++)
+            {
+                float s = 0.0f;
+                for (int v = 0; v < n; v++) s += m_idct[y * 8 + v] * coef[v * 8 + u];
+                tmp[y * 8 + u] = s;
+            }
+        }
+        for (int y = 0; y < n; y++)          // 행: out[y][x] = sum_u T[x][u] tmp[y][u]
+        {
+            for (int x = 0; x < n; x++)
+            {
+                float s = 128.5f;
+                for (int u = 0; u < n; u++) s += m_idct[x * 8 + u] * tmp[y * 8 + u];
+                out[y * n + x] = Clamp((int)floorf(s));
+            }
+        }
+    }
+
+    static unsigned char Clamp(int v) { return (unsigned char)(v < 0 ? 0 : (v > 255 ? 255 : v)); }
+
+    // 평면 -> 출력. 서브샘플된 채널은 최근접 확대, 3채널은 YCbCr -> RGB (JFIF, 16bit 고정소수)
+    void writeOutput(int outW, int outH, std::vector<unsigned char>& out) const
+    {
+        int channels = components();
+        out.resize((size_t)outW * outH * channels);
+        if (channels == 1)
+        {
+            const Component& c = m_comp[0];
+            for (int y = 0; y < outH; y++) memcpy(&out[(size_t)y * outW], &c.plane[(size_t)y * c.planeW], outW);
+            return;
+        }
+
+        const Component& cy = m_comp[0];
+        const Component& cb = m_comp[1];
+        const Component& cr = m_comp[2];
+        for (int y = 0; y < outH; y++)
+        {
+            const unsigned char* rowY = &cy.plane[(size_t)(y * cy.v / m_maxV) * cy.planeW];
+            const unsigned char* rowB = &cb.plane[(size_t)(y * cb.v / m_maxV) * cb.planeW];
+            const unsigned char* rowR = &cr.plane[(size_t)(y * cr.v / m_maxV) * cr.planeW];
+            unsigned char* dst = &out[(size_t)y * outW * 3];
+            for (int x = 0; x < outW; x++, dst += 3)
+            {
+                int Y = rowY[x * cy.h / m_maxH] << 16;
+                int Cb = rowB[x * cb.h / m_maxH] - 128;
+                int Cr = rowR[x * cr.h / m_maxH] - 128;
+                dst[0] = Clamp((Y + 91881 * Cr + 32768) >> 16);
+                dst[1] = Clamp((Y - 22554 * Cb - 46802 * Cr + 32768) >> 16);
+                dst[2] = Clamp((Y + 116130 * Cb + 32768) >> 16);
+            }
+        }
+    }
+
+    static const unsigned char* ZigZag()
+    {
+        static const unsigned char zz[64] = {
+             0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+            12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+            35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+            58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+        };
+        return zz;
+    }
+
+    MappedFile m_file;
+    const unsigned char* m_data;
+    size_t m_size;
+    int m_width, m_height;
+    int m_componentCount;
+    int m_restartInterval;
+    int m_maxH, m_maxV;
+    int m_mcusX, m_mcusY;
+    size_t m_scanStart;
+
+    Component m_comp[3];
+    int m_scanComp[3];
+    int m_scanCount;
+    unsigned short m_quant[4][64];
+    Huffman m_huff[2][4];
+    float m_idct[64];
+};
+
+#endif // JPEG_DECODER_H_INCLUDED
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+//           Name: mapped_file.h
+//    Description: 읽기 전용 메모리 매핑 파일 (Windows / POSIX)
+//-----------------------------------------------------------------------------
+
+#ifndef MAPPED_FILE_H_INCLUDED
+#define MAPPED_FILE_H_INCLUDED
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 파일 전체를 읽기 전용으로 매핑합니다. 복사 없이 data()로 바로 접근하고
+// 소멸 시 자동으로 해제됩니다. (복사 금지, 이동만 가능)
+// resolver() 가 설정되어 있으면 먼저 물어보고, 찾으면 그 메모리를 빌려씀 (에셋 팩 등, 해제하지 않음)
+class MappedFile
+{
+public:
+    // path 를 이미 매핑된 메모리로 찾아주는 함수 (찾으면 true)
+    typedef bool (*Resolver)(const char* path, const unsigned char*& data, size_t& size);
+
+    static Resolver& resolver()
+    {
+        static Resolver r = NULL;
+        return r;
+    }
+
+    MappedFile() : m_data(NULL), m_size(0), m_borrowed(false)
+#ifdef _WIN32
+        , m_file(INVALID_HANDLE_VALUE), m_mapping(NULL)
+#endif
+    {}
+
+    ~MappedFile() { close(); }
+
+    MappedFile(MappedFile&& o) : MappedFile() { swap(o); }
+    MappedFile& operator=(MappedFile&& o) { close(); swap(o); return *this; }
+
+    bool open(const char* path)
+    {
+        close();
+        if (!path) return false;
+        if (resolver() && resolver()(path, m_data, m_size))
+        {
+            m_borrowed = true;
+            return true;
+        }
+
+#ifdef _WIN32
+        // 프로젝트 문자셋(Unicode/MultiByte)과 무관하게 ANSI 경로 사용
+        m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (m_file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) { close(); return false; }
+        m_size = (size_t)size.QuadPart;
+
+        m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!m_mapping) { close(); return false; }
+
+        m_data = (const unsigned char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!m_data) { close(); return false; }
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+        m_size = (size_t)st.st_size;
+
+        void* p = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) { m_size = 0; return false; }
+        m_data = (const unsigned char*)p;
+        madvise(p, m_size, MADV_SEQUENTIAL);
+#endif
+        return true;
+    }
+
+    void close()
+    {
+        if (m_borrowed)
+        {
+            m_data = NULL;
+            m_size = 0;
+            m_borrowed = false;
+            return;
+        }
+#ifdef _WIN32
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+        m_mapping = NULL;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data) munmap((void*)m_data, m_size);
+#endif
+        m_data = NULL;
+        m_size = 0;
+    }
+
+    bool isOpen() const { return m_data != NULL; }
+    const unsigned char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    void swap(MappedFile& o)
+    {
+        const unsigned char* d = m_data; m_data = o.m_data; o.m_data = d;
+        size_t s = m_size; m_size = o.m_size; o.m_size = s;
+        bool b = m_borrowed; m_borrowed = o.m_borrowed; o.m_borrowed = b;
+#ifdef _WIN32
+        HANDLE f = m_file; m_file = o.m_file; o.m_file = f;
+        HANDLE m = m_mapping; m_mapping = o.m_mapping; o.m_mapping = m;
+#endif
+    }
+
+    const unsigned char* m_data;
+    size_t m_size;
+    bool m_borrowed;
+#ifdef _WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#endif
+};
+
+#endif // MAPPED_FILE_H_INCLUDED
@@ -0,0 +1,404 @@
+//-----------------------------------------------------------------------------
+//           Name: max3ds_loader.h
+//    Description: 3D Studio(.3DS) 바이너리 청크 로더 (메모리 매핑, 복사 없는 청크 탐색)
+//-----------------------------------------------------------------------------
+// 3DS 파일은 [id(uint16) 길이(uint32, 헤더 포함) 내용] 청크의 트리입니다.
+// 매핑한 파일 위에서 필요한 청크만 내려가고 나머지는 길이만큼 건너뜁니다.
+//   0x4D4D 메인 > 0x3D3D 에디터 > 0xAFFF 재질 (0xA000 이름, 0xA200 > 0xA300 디퓨즈 맵 파일)
+//                              > 0x4000 오브젝트(이름) > 0x4100 삼각형 메쉬
+//                                   0x4110 정점, 0x4140 UV, 0x4120 면 (> 0x4130 재질 그룹, 0x4150 스무딩 그룹)
+// 청크 내용은 포인터로만 기억해 두고, 출력 버퍼에 쓸 때 한 번만 읽습니다.
+// 법선은 스무딩 그룹 규칙대로: 한 정점을 공유하는 면들 중 그룹 비트가 겹치는 면끼리만 평균,
+// 그룹이 0 인 면은 면 법선. (정점, 그룹 비트) 가 다르면 정점을 나눕니다.
+// 좌표는 Z-up 을 Y-up 으로 바꿔서 저장합니다. (x, y, z) -> (x, z, -y)
+
+#ifndef MAX3DS_LOADER_H_INCLUDED
+#define MAX3DS_LOADER_H_INCLUDED
+
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "model_mesh.h"
+
+class Max3dsLoader
+{
+public:
+    enum Max3dsLoadError
+    {
+        MAX3DS_NO_ERROR = 1,    // No error
+        MAX3DS_FILE_NOT_FOUND,  // File was not found or could not be mapped
+        MAX3DS_BAD_HEADER,      // Not a 3DS file (missing main chunk)
+        MAX3DS_BAD_DATA         // Chunk lengths or element counts run past their parent chunk
+    };
+
+    static Max3dsLoadError load(const char* path, ModelMesh& mesh)
+    {
+        MappedFile file;
+        if (!file.open(path)) return MAX3DS_FILE_NOT_FOUND;
+        return parse(file.data(), file.size(), mesh);
+    }
+
+    static Max3dsLoadError parse(const unsigned char* data, size_t size, ModelMesh& mesh)
+    {
+        mesh.clear();
+
+        Chunk main;
+        if (!ReadChunk(data, data + size, main) || main.id != CHUNK_MAIN) return MAX3DS_BAD_HEADER;
+
+        std::vector<Material> materials;
+        std::vector<Object> objects;
+        Chunk c;
+        for (const unsigned char* p = main.body; ReadChunk(p, main.end, c); p = c.end)
+        {
+            if (c.id != CHUNK_EDITOR) continue;
+            Chunk e;
+            for (const unsigned char* q = c.body; ReadChunk(q, c.end, e); q = e.end)
+            {
+                if (e.id == CHUNK_MATERIAL) materials.push_back(ReadMaterial(e));
+                else if (e.id == CHUNK_OBJECT && !ReadObject(e, objects)) return MAX3DS_BAD_DATA;
+            }
+        }
+
+        Scratch scratch;
+        for (auto& obj : objects)
+        {
+            if (!emit(obj, materials, scratch, mesh)) return MAX3DS_BAD_DATA;
+        }
+        return MAX3DS_NO_ERROR;
+    }
+
+private:
+    enum
+    {
+        CHUNK_MAIN = 0x4D4D,
+        CHUNK_EDITOR = 0x3D3D,
+        CHUNK_OBJECT = 0x4000,
+        CHUNK_TRIMESH = 0x4100,
+        CHUNK_VERTICES = 0x4110,
+        CHUNK_FACES = 0x4120,
+        CHUNK_FACE_MATERIAL = 0x4130,
+        CHUNK_MAPPING = 0x4140,
+        CHUNK_SMOOTHING = 0x4150,
+        CHUNK_MATERIAL = 0xAFFF,
+        CHUNK_MATERIAL_NAME = 0xA000,
+        CHUNK_TEXTURE_MAP = 0xA200,
+        CHUNK_MAP_FILE = 0xA300
+    };
+
+    struct Chunk
+    {
+        unsigned int id;
+        const unsigned char* body;  // 헤더 다음
+        const unsigned char* end;   // 다음 형제 청크
+    };
+
+    struct Material
+    {
+        std::string name;
+        std::string bitmap;
+    };
+
+    // 매핑된 메모리 안의 면 재질 그룹 (0x4130)
+    struct FaceGroup
+    {
+        std::string material;
+        const unsigned char* faces; // uint16 면 번호 배열
+        unsigned int count;
+    };
+
+    // 청크 내용을 가리키는 포인터만 가진 오브젝트
+    struct Object
+    {
+        std::string name;
+        const unsigned char* vertices;  // float x y z
+        unsigned int vertexCount;
+        const unsigned char* uvs;       // float u v (정점 수와 같음)
+        unsigned int uvCount;
+        const unsigned char* faces;     // uint16 a b c flags
+        unsigned int faceCount;
+        const unsigned char* smoothing; // uint32 (면마다)
+        std::vector<FaceGroup> groups;
+    };
+
+    // 오브젝트마다 다시 쓰는 임시 배열 (capacity 유지)
+    struct Scratch
+    {
+        std::vector<float> positions;           // Y-up 으로 바꾼 위치
+        std::vector<float> faceNormals;         // 정규화 전 (면적 가중)
+        std::vector<unsigned int> faceIndex;    // 면마다 a b c
+        std::vector<unsigned int> smoothing;
+        std::vector<unsigned int> cornerStart;  // 정점별 인접 모서리 구간 (CSR)
+        std::vector<unsigned int> corners;      // 면 * 3 + 모서리
+        std::vector<unsigned int> cornerVertex; // 모서리 -> 출력 정점
+        std::vector<unsigned int> seenMasks;    // 정점 하나에서 이미 만든 (그룹 비트, 출력 정점)
+        std::vector<unsigned char> grouped;
+    };
+
+    static unsigned int U16(const unsigned char* p) { return p[0] | (p[1] << 8); }
+    static unsigned int U32(const unsigned char* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24); }
+    static float F32(const unsigned char* p)
+    {
+        unsigned int bits = U32(p);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    static bool ReadChunk(const unsigned char* p, const unsigned char* end, Chunk& c)
+    {
+        if (end - p < 6) return false;
+        unsigned int length = U32(p + 2);
+        if (length < 6 || length > (size_t)(end - p)) return false;
+        c.id = U16(p);
+        c.body = p + 6;
+        c.end = p + length;
+        return true;
+    }
+
+    // 널 종료 문자열 (청크 끝을 넘지 않음)
+    static const unsigned char* ReadString(const unsigned char* p, const unsigned char* end, std::string& out)
+    {
+        const unsigned char* z = p;
+        while (z < end && *z) z++;
+        out.assign((const char*)p, z - p);
+        return (z < end) ? z + 1 : end;
+    }
+
+    static Material ReadMaterial(const Chunk& m)
+    {
+        Material mat;
+        Chunk c;
+        for (const unsigned char* p = m.body; ReadChunk(p, m.end, c); p = c.end)
+        {
+            if (c.id == CHUNK_MATERIAL_NAME) ReadString(c.body, c.end, mat.name);
+            else if (c.id == CHUNK_TEXTURE_MAP)
+            {
+                Chunk t;
+                for (const unsigned char* q = c.body; ReadChunk(q, c.end, t); q = t.end)
+                {
+                    if (t.id != CHUNK_MAP_FILE) continue;
+                    std::string path;
+                    ReadString(t.body, t.end, path);
+                    size_t slash = path.find_last_of("/\\");
+                    mat.bitmap = (slash == std::string::npos) ? path : path.substr(slash + 1);
+                }
+            }
+        }
+        return mat;
+    }
+
+    static bool ReadObject(const Chunk& o, std::vector<Object>& objects)
+    {
+        std::string name;
+        const unsigned char* p = ReadString(o.body, o.end, name);
+
+        Chunk c;
+        for (; ReadChunk(p, o.end, c); p = c.end)
+        {
+            if (c.id != CHUNK_TRIMESH) continue;
+
+            Object obj;
+            obj.name = name;
+            obj.vertices = obj.uvs = obj.faces = obj.smoothing = NULL;
+            obj.vertexCount = obj.uvCount = obj.faceCount = 0;
+
+            Chunk m;
+            for (const unsigned char* q = c.body; ReadChunk(q, c.end, m); q = m.end)
+            {
+                size_t avail = m.end - m.body;
+                if (m.id == CHUNK_VERTICES)
+                {
+                    if (avail < 2) return false;
+                    obj.vertexCount = U16(m.body);
+                    obj.vertices = m.body + 2;
+                    if (2 + obj.vertexCount * 12 > avail) return false;
+                }
+                else if (m.id == CHUNK_MAPPING)
+                {
+                    if (avail < 2) return false;
+                    obj.uvCount = U16(m.body);
+                    obj.uvs = m.body + 2;
+                    if (2 + obj.uvCount * 8 > avail) return false;
+                }
+                else if (m.id == CHUNK_FACES)
+                {
+                    if (avail < 2) return false;
+                    obj.faceCount = U16(m.body);
+                    obj.faces = m.body + 2;
+                    if (2 + obj.faceCount * 8 > avail) return false;
+                    if (!ReadFaceSubChunks(obj, obj.faces + obj.faceCount * 8, m.end)) return false;
+                }
+            }
+            if (obj.vertexCount && obj.faceCount) objects.push_back(obj);
+        }
+        return true;
+    }
+
+    static bool ReadFaceSubChunks(Object& obj, const unsigned char* p, const unsigned char* end)
+    {
+        Chunk s;
+        for (; ReadChunk(p, end, s); p = s.end)
+        {
+            if (s.id == CHUNK_FACE_MATERIAL)
+            {
+                FaceGroup g;
+                const unsigned char* q = ReadString(s.body, s.end, g.material);
+                if (s.end - q < 2) return false;
+                g.count = U16(q);
+                g.faces = q + 2;
+                if ((size_t)(s.end - g.faces) < g.count * 2) return false;
+                obj.groups.push_back(g);
+            }
+            else if (s.id == CHUNK_SMOOTHING)
+            {
+                if ((size_t)(s.end - s.body) < obj.faceCount * 4) return false;
+                obj.smoothing = s.body;
+            }
+        }
+        return true;
+    }
+
+    static bool emit(const Object& obj, const std::vector<Material>& materials, Scratch& s, ModelMesh& mesh)
+    {
+        unsigned int nv = obj.vertexCount, nf = obj.faceCount;
+
+        s.positions.resize((size_t)nv * 3);
+        for (unsigned int i = 0; i < nv; i++)
+        {
+            const unsigned char* v = obj.vertices + i * 12;
+            s.positions[i * 3] = F32(v);
+            s.positions[i * 3 + 1] = F32(v + 8);
+            s.positions[i * 3 + 2] = 0.0f - F32(v + 4);
+        }
+
+        s.faceIndex.resize((size_t)nf * 3);
+        s.faceNormals.resize((size_t)nf * 3);
+        s.smoothing.resize(nf);
+        s.cornerStart.assign(nv + 1, 0);
+        for (unsigned int f = 0; f < nf; f++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                unsigned int v = U16(obj.faces + f * 8 + k * 2);
+                if (v >= nv) return false;
+                s.faceIndex[f * 3 + k] = v;
+                s.cornerStart[v + 1]++;
+            }
+            s.smoothing[f] = obj.smoothing ? U32(obj.smoothing + f * 4) : 1;
+
+            const float* a = &s.positions[s.faceIndex[f * 3] * 3];
+            const float* b = &s.positions[s.faceIndex[f * 3 + 1] * 3];
+            const float* c = &s.positions[s.faceIndex[f * 3 + 2] * 3];
+            float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            s.faceNormals[f * 3] = e1[1] * e2[2] - e1[2] * e2[1];
+            s.faceNormals[f * 3 + 1] = e1[2] * e2[0] - e1[0] * e2[2];
+            s.faceNormals[f * 3 + 2] = e1[0] * e2[1] - e1[1] * e2[0];
+        }
+
+        // 정점 -> 인접 모서리 (계수 정렬)
+        for (unsigned int v = 0; v < nv; v++) s.cornerStart[v + 1] += s.cornerStart[v];
+        s.corners.resize((size_t)nf * 3);
+        s.seenMasks.assign(s.cornerStart.begin(), s.cornerStart.end() - 1);
+        for (unsigned int i = 0; i < nf * 3; i++) s.corners[s.seenMasks[s.faceIndex[i]]++] = i;
+
+        // (정점, 스무딩 그룹) 마다 출력 정점 하나
+        s.cornerVertex.resize((size_t)nf * 3);
+        for (unsigned int v = 0; v < nv; v++)
+        {
+            s.seenMasks.clear();
+            for (unsigned int i = s.cornerStart[v]; i < s.cornerStart[v + 1]; i++)
+            {
+                unsigned int corner = s.corners[i];
+                unsigned int mask = s.smoothing[corner / 3];
+
+                bool found = false;
+                for (size_t m = 0; mask && m < s.seenMasks.size(); m += 2)
+                {
+                    if (s.seenMasks[m] == mask) { s.cornerVertex[corner] = s.seenMasks[m + 1]; found = true; break; }
+                }
+                if (found) continue;
+
+                float n[3] = { 0.0f, 0.0f, 0.0f };
+                if (mask == 0) memcpy(n, &s.faceNormals[(corner / 3) * 3], sizeof(n));
+                else
+                {
+                    for (unsigned int j = s.cornerStart[v]; j < s.cornerStart[v + 1]; j++)
+                    {
+                        unsigned int g = s.corners[j] / 3;
+                        if (!(s.smoothing[g] & mask)) continue;
+                        n[0] += s.faceNormals[g * 3]; n[1] += s.faceNormals[g * 3 + 1]; n[2] += s.faceNormals[g * 3 + 2];
+                    }
+                }
+                float len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (len > 0.0f) { n[0] /= len; n[1] /= len; n[2] /= len; }
+                else n[1] = 1.0f;
+
+                float uv[2] = { 0.0f, 0.0f };
+                if (v < obj.uvCount)
+                {
+                    uv[0] = F32(obj.uvs + v * 8);
+                    uv[1] = F32(obj.uvs + v * 8 + 4);
+                }
+
+                unsigned int out = (unsigned int)mesh.vertexCount();
+                const float* p = &s.positions[v * 3];
+                float vert[MODEL_VERTEX_FLOATS] = { p[0], p[1], p[2], n[0], n[1], n[2], uv[0], uv[1] };
+                mesh.vertices.insert(mesh.vertices.end(), vert, vert + MODEL_VERTEX_FLOATS);
+                s.cornerVertex[corner] = out;
+                if (mask)
+                {
+                    s.seenMasks.push_back(mask);
+                    s.seenMasks.push_back(out);
+                }
+            }
+        }
+
+        // 재질 그룹 순서대로 서브메쉬, 어느 그룹에도 없는 면은 재질 없는 서브메쉬 하나로
+        s.grouped.assign(nf, 0);
+        for (auto& g : obj.groups)
+        {
+            ModelSubMesh sub;
+            sub.name = obj.name;
+            sub.material = -1;
+            sub.materialId = 0;
+            for (size_t m = 0; m < materials.size(); m++)
+            {
+                if (materials[m].name == g.material)
+                {
+                    sub.material = (int)m;
+                    sub.bitmap = materials[m].bitmap;
+                    break;
+                }
+            }
+            sub.firstIndex = (unsigned int)mesh.indices.size();
+            for (unsigned int i = 0; i < g.count; i++)
+            {
+                unsigned int f = U16(g.faces + i * 2);
+                if (f >= nf || s.grouped[f]) continue;
+                s.grouped[f] = 1;
+                for (int k = 0; k < 3; k++) mesh.indices.push_back(s.cornerVertex[f * 3 + k]);
+            }
+            sub.indexCount = (unsigned int)mesh.indices.size() - sub.firstIndex;
+            if (sub.indexCount) mesh.subMeshes.push_back(sub);
+        }
+
+        ModelSubMesh rest;
+        rest.name = obj.name;
+        rest.material = -1;
+        rest.materialId = 0;
+        rest.firstIndex = (unsigned int)mesh.indices.size();
+        for (unsigned int f = 0; f < nf; f++)
+        {
+            if (s.grouped[f]) continue;
+            for (int k = 0; k < 3; k++) mesh.indices.push_back(s.cornerVertex[f * 3 + k]);
+        }
+        rest.indexCount = (unsigned int)mesh.indices.size() - rest.firstIndex;
+        if (rest.indexCount) mesh.subMeshes.push_back(rest);
+        return true;
+    }
+};
+
+#endif // MAX3DS_LOADER_H_INCLUDED
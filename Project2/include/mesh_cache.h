@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+//           Name: mesh_cache.h
+//    Description: 파싱이 끝난 메쉬를 저장하는 바이너리 캐시(.msh) 포맷
+//-----------------------------------------------------------------------------
+// 파일 구조: [MeshCacheHeader][정점 (float x y z nx ny nz)][인덱스 (uint32)]
+// 정점/인덱스 영역은 GL 버퍼 레이아웃 그대로라서, 매핑한 파일을 glBufferData 에 바로 넘깁니다.
+// 캐시 파일은 원본 옆의 Cache 폴더에 "<원본 파일명>.msh" 로 저장됩니다.
+//   ../Data/bunny/bun_zipper.ply  ->  ../Data/bunny/Cache/bun_zipper.ply.msh
+
+#ifndef MESH_CACHE_H_INCLUDED
+#define MESH_CACHE_H_INCLUDED
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#ifdef _MSC_VER
+typedef unsigned __int32 msh_uint32;
+#else
+#include <stdint.h>
+typedef uint32_t msh_uint32;
+#endif
+
+struct MeshCacheHeader
+{
+    char       magic[4];        // "MSH1"
+    msh_uint32 version;
+    msh_uint32 vertexCount;
+    msh_uint32 indexCount;
+    msh_uint32 vertexStride;    // 바이트 (현재 24: 위치 + 법선)
+    msh_uint32 vertexOffset;    // 파일 시작 기준
+    msh_uint32 indexOffset;
+    msh_uint32 reserved;
+    float      boundsMin[3];
+    float      boundsMax[3];
+};
+
+const msh_uint32 MESHCACHE_VERSION = 1;
+const msh_uint32 MESHCACHE_STRIDE = 6 * sizeof(float);
+
+// 메모리에 올라온 캐시 파일 검증 (데이터 수명은 호출자가 보장)
+class MeshCacheFile
+{
+public:
+    MeshCacheFile() : m_pData(NULL), m_pHeader(NULL) {}
+
+    bool parse(const unsigned char* data, size_t size)
+    {
+        m_pData = data;
+        m_pHeader = NULL;
+
+        if (size < sizeof(MeshCacheHeader)) return false;
+        const MeshCacheHeader* h = (const MeshCacheHeader*)data;
+        if (memcmp(h->magic, "MSH1", 4) != 0 || h->version != MESHCACHE_VERSION || h->vertexStride != MESHCACHE_STRIDE) return false;
+        if (h->indexCount % 3 != 0) return false;
+        if ((size_t)h->vertexOffset + (size_t)h->vertexCount * h->vertexStride > size) return false;
+        if ((size_t)h->indexOffset + (size_t)h->indexCount * 4 > size) return false;
+
+        m_pHeader = h;
+        return true;
+    }
+
+    const MeshCacheHeader& header() const { return *m_pHeader; }
+    const void* vertices() const { return m_pData + m_pHeader->vertexOffset; }
+    const void* indices() const { return m_pData + m_pHeader->indexOffset; }
+    size_t vertexBytes() const { return (size_t)m_pHeader->vertexCount * m_pHeader->vertexStride; }
+    size_t indexBytes() const { return (size_t)m_pHeader->indexCount * 4; }
+
+    // 정점(24바이트 stride)과 삼각형 인덱스를 캐시 파일로 기록
+    static bool Write(const char* path, const float* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount)
+    {
+        MeshCacheHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, "MSH1", 4);
+        h.version = MESHCACHE_VERSION;
+        h.vertexCount = (msh_uint32)vertexCount;
+        h.indexCount = (msh_uint32)indexCount;
+        h.vertexStride = MESHCACHE_STRIDE;
+        h.vertexOffset = sizeof(MeshCacheHeader);
+        h.indexOffset = h.vertexOffset + (msh_uint32)(vertexCount * MESHCACHE_STRIDE);
+
+        ComputeBounds(vertices, vertexCount, h.boundsMin, h.boundsMax);
+
+        FILE* fp = fopen(path, "wb");
+        if (!fp) return false;
+        bool ok = fwrite(&h, sizeof(h), 1, fp) == 1 &&
+                  fwrite(vertices, MESHCACHE_STRIDE, vertexCount, fp) == vertexCount &&
+                  fwrite(indices, 4, indexCount, fp) == indexCount;
+        fclose(fp);
+        if (!ok) remove(path);
+        return ok;
+    }
+
+    // 위치(24바이트 stride 정점의 앞 3개 float)의 AABB
+    static void ComputeBounds(const float* vertices, size_t vertexCount, float outMin[3], float outMax[3])
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            outMin[k] = vertexCount ? vertices[k] : 0.0f;
+            outMax[k] = outMin[k];
+        }
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                float v = vertices[i * 6 + k];
+                if (v < outMin[k]) outMin[k] = v;
+                if (v > outMax[k]) outMax[k] = v;
+            }
+        }
+    }
+
+    // "../Data/bunny/bun_zipper.ply" -> "../Data/bunny/Cache/bun_zipper.ply.msh"
+    static std::string CachePathFor(const char* sourcePath)
+    {
+        std::string path = sourcePath;
+        size_t slash = path.find_last_of("/\\");
+        std::string dir = (slash == std::string::npos) ? "" : path.substr(0, slash + 1);
+        std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+        return dir + "Cache/" + name + ".msh";
+    }
+
+private:
+    const unsigned char* m_pData;
+    const MeshCacheHeader* m_pHeader;
+};
+
+#endif // MESH_CACHE_H_INCLUDED
@@ -0,0 +1,43 @@
+//-----------------------------------------------------------------------------
+//           Name: model_mesh.h
+//    Description: 텍스처 모델 로더(ASE, 3DS) 공용 출력 형식
+//-----------------------------------------------------------------------------
+// 정점은 위치/법선/UV 인터리브 (32바이트), 인덱스는 삼각형 리스트.
+// 서브메쉬는 같은 인덱스 버퍼 안의 구간이며 구간마다 디퓨즈 텍스처 하나.
+
+#ifndef MODEL_MESH_H_INCLUDED
+#define MODEL_MESH_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+const int MODEL_VERTEX_FLOATS = 8;
+
+struct ModelSubMesh
+{
+    std::string name;           // 오브젝트 이름
+    std::string bitmap;         // 디퓨즈 비트맵 파일 이름 (경로 제외, 없으면 빈 문자열)
+    int material;               // 파일 안의 재질 번호 (없으면 -1)
+    unsigned int materialId;    // 다중 재질의 하위 재질 번호 (ASE *MESH_MTLID, 그 외 0)
+    unsigned int firstIndex;    // ModelMesh::indices 안의 시작 위치
+    unsigned int indexCount;
+};
+
+struct ModelMesh
+{
+    std::vector<float> vertices;        // x y z nx ny nz u v 반복
+    std::vector<unsigned int> indices;  // 삼각형 리스트
+    std::vector<ModelSubMesh> subMeshes;
+
+    size_t vertexCount() const { return vertices.size() / MODEL_VERTEX_FLOATS; }
+    size_t triangleCount() const { return indices.size() / 3; }
+
+    void clear()
+    {
+        vertices.clear();
+        indices.clear();
+        subMeshes.clear();
+    }
+};
+
+#endif // MODEL_MESH_H_INCLUDED
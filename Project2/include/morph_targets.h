@@ -0,0 +1,169 @@
+//-----------------------------------------------------------------------------
+//           Name: morph_targets.h
+//    Description: 정점 순서가 같은 점 집합(Sphere/Torus/Tube.txt)을 모프 타깃으로 섞는 커널
+//-----------------------------------------------------------------------------
+// 타깃은 SoA 로 저장합니다: [x 0..P) [y 0..P) [z 0..P), P 는 정점 수를 8 의 배수로 올린 값.
+// 섞기는 평면(x/y/z)마다 out[i] = bias + sum(w[t] * target[t][i]) 이고,
+// AVX2+FMA 가 있으면 8 float 씩 fused multiply-add, 없으면 스칼라 (cpu_features.h 로 분기).
+// 패딩 칸은 0 이라서 섞어도 bias 만 남습니다. (그리지 않으면 무해)
+//
+// 텍스트 형식:
+//   Vertices: 486
+//   -0.106     1.593     2.272
+//   ...
+
+#ifndef MORPH_TARGETS_H_INCLUDED
+#define MORPH_TARGETS_H_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include "cpu_features.h"
+#include "mapped_file.h"
+#include "text_parse.h"
+
+namespace MorphBlend
+{
+
+// 섞을 수 있는 타깃 수 상한 (커널의 스택 배열 크기)
+const int MAX_TARGETS = 16;
+
+inline void BlendScalar(const float* const* targets, const float* weights, int targetCount, float bias, float* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        float sum = bias;
+        for (int t = 0; t < targetCount; t++) sum += weights[t] * targets[t][i];
+        out[i] = sum;
+    }
+}
+
+#if CPU_X86
+// 32 float 씩 누산기 4개로 FMA 지연을 숨기고, 남은 8 배수 구간은 하나로. 처리한 개수를 반환
+SIMD_TARGET_AVX2_FMA inline size_t BlendAVX2(const float* const* targets, const float* weights, int targetCount, float bias, float* out, size_t count)
+{
+    __m256 w[MAX_TARGETS];
+    for (int t = 0; t < targetCount; t++) w[t] = _mm256_set1_ps(weights[t]);
+    const __m256 b = _mm256_set1_ps(bias);
+
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256 a0 = b, a1 = b, a2 = b, a3 = b;
+        for (int t = 0; t < targetCount; t++)
+        {
+            const float* src = targets[t] + i;
+            a0 = _mm256_fmadd_ps(w[t], _mm256_loadu_ps(src), a0);
+            a1 = _mm256_fmadd_ps(w[t], _mm256_loadu_ps(src + 8), a1);
+            a2 = _mm256_fmadd_ps(w[t], _mm256_loadu_ps(src + 16), a2);
+            a3 = _mm256_fmadd_ps(w[t], _mm256_loadu_ps(src + 24), a3);
+        }
+        _mm256_storeu_ps(out + i, a0);
+        _mm256_storeu_ps(out + i + 8, a1);
+        _mm256_storeu_ps(out + i + 16, a2);
+        _mm256_storeu_ps(out + i + 24, a3);
+    }
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 a = b;
+        for (int t = 0; t < targetCount; t++) a = _mm256_fmadd_ps(w[t], _mm256_loadu_ps(targets[t] + i), a);
+        _mm256_storeu_ps(out + i, a);
+    }
+    return i;
+}
+#endif
+
+// 공개 함수: targetCount 는 1 ~ MAX_TARGETS
+inline void Blend(const float* const* targets, const float* weights, int targetCount, float bias, float* out, size_t count)
+{
+    size_t done = 0;
+#if CPU_X86
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx2 && cpu.fma) done = BlendAVX2(targets, weights, targetCount, bias, out, count);
+#endif
+    if (done < count)
+    {
+        const float* rest[MAX_TARGETS];
+        for (int t = 0; t < targetCount; t++) rest[t] = targets[t] + done;
+        BlendScalar(rest, weights, targetCount, bias, out + done, count - done);
+    }
+}
+
+} // namespace MorphBlend
+
+class MorphTargets
+{
+public:
+    MorphTargets() : m_vertexCount(0), m_padded(0) {}
+
+    // 타깃 하나를 추가. 정점 수가 앞의 타깃과 다르면 실패
+    bool load(const char* path)
+    {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        const char* p = (const char*)file.data();
+        const char* end = p + file.size();
+
+        // "Vertices: N"
+        while (p < end && *p != ':') p++;
+        if (p < end) p++;
+        unsigned int count = 0;
+        if (!TextParse::ParseUInt(p, end, count) || count == 0) return false;
+        if (m_vertexCount && count != m_vertexCount) return false;
+
+        size_t padded = (count + 7) & ~(size_t)7;
+        std::vector<float> target(padded * 3, 0.0f);
+        for (size_t i = 0; i < count; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+                float v;
+                if (!TextParse::ParseFloat(p, end, v)) return false;
+                target[k * padded + i] = v;
+            }
+        }
+
+        m_vertexCount = count;
+        m_padded = padded;
+        m_targets.push_back(target);
+        return true;
+    }
+
+    size_t vertexCount() const { return m_vertexCount; }
+    size_t paddedCount() const { return m_padded; }
+    int targetCount() const { return (int)m_targets.size(); }
+
+    // axis 0/1/2 = x/y/z 평면
+    const float* plane(int target, int axis) const { return m_targets[target].data() + axis * m_padded; }
+
+    // 가중치 0 인 타깃은 빼고 섞음. out 의 각 평면은 paddedCount() 개
+    void blend(const float* weights, const float offset[3], float* outX, float* outY, float* outZ) const
+    {
+        const float* planes[3][MorphBlend::MAX_TARGETS];
+        float w[MorphBlend::MAX_TARGETS];
+        int n = 0;
+        for (int t = 0; t < targetCount() && n < MorphBlend::MAX_TARGETS; t++)
+        {
+            if (weights[t] == 0.0f) continue;
+            for (int k = 0; k < 3; k++) planes[k][n] = plane(t, k);
+            w[n++] = weights[t];
+        }
+
+        float* out[3] = { outX, outY, outZ };
+        for (int k = 0; k < 3; k++)
+        {
+            if (n == 0)
+            {
+                for (size_t i = 0; i < m_padded; i++) out[k][i] = offset[k];
+            }
+            else MorphBlend::Blend(planes[k], w, n, offset[k], out[k], m_padded);
+        }
+    }
+
+private:
+    size_t m_vertexCount;
+    size_t m_padded;
+    std::vector<std::vector<float> > m_targets;
+};
+
+#endif // MORPH_TARGETS_H_INCLUDED
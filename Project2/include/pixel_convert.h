@@ -0,0 +1,294 @@
+//-----------------------------------------------------------------------------
+//           Name: pixel_convert.h
+//    Description: TGA / BMP / PPM 디코딩 공용 픽셀 변환 커널 (SSE2 / SSSE3 / AVX2)
+//-----------------------------------------------------------------------------
+// - SwapRB24 / SwapRB32 : BGR(A) <-> RGB(A) 채널 교환 (src == dst 인 제자리 변환 가능)
+// - ExpandGray          : 8bit 그레이 -> RGB / RGBA
+// - DecodeRLE           : TGA RLE 패킷 디코딩 (런 구간은 SIMD 채우기)
+// 모든 함수는 크기 제한이 없고, SIMD 로 처리하지 못한 꼬리 부분은 스칼라로 마무리합니다.
+
+#ifndef PIXEL_CONVERT_H_INCLUDED
+#define PIXEL_CONVERT_H_INCLUDED
+
+#include <stddef.h>
+#include <string.h>
+#include "cpu_features.h"
+
+namespace PixelConvert
+{
+
+//-----------------------------------------------------------------------------
+// 스칼라 기준 구현 (꼬리 처리 및 비 x86 환경)
+//-----------------------------------------------------------------------------
+inline void SwapRB24Scalar(const unsigned char* src, unsigned char* dst, size_t count)
+{
+    for (size_t i = 0; i < count * 3; i += 3)
+    {
+        unsigned char b = src[i], g = src[i + 1], r = src[i + 2];
+        dst[i] = r; dst[i + 1] = g; dst[i + 2] = b;
+    }
+}
+
+inline void SwapRB32Scalar(const unsigned char* src, unsigned char* dst, size_t count)
+{
+    for (size_t i = 0; i < count * 4; i += 4)
+    {
+        unsigned char b = src[i], g = src[i + 1], r = src[i + 2], a = src[i + 3];
+        dst[i] = r; dst[i + 1] = g; dst[i + 2] = b; dst[i + 3] = a;
+    }
+}
+
+inline void ExpandGrayScalar(const unsigned char* src, unsigned char* dst, size_t count, int channels)
+{
+    for (size_t i = 0; i < count; i++, dst += channels)
+    {
+        dst[0] = dst[1] = dst[2] = src[i];
+        if (channels == 4) dst[3] = 255;
+    }
+}
+
+#if CPU_X86
+//-----------------------------------------------------------------------------
+// SIMD 커널
+//-----------------------------------------------------------------------------
+
+// 24bit: 16바이트 로드에서 앞 5픽셀(15바이트)만 교환, 16번째 바이트는 다음 반복에서 다시 씀
+SIMD_TARGET_SSSE3 inline size_t SwapRB24SSSE3(const unsigned char* src, unsigned char* dst, size_t bytes)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 15)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+// 24bit AVX2: 두 레인에 각각 15바이트씩 (src+i, src+i+15) 넣어서 한 번에 10픽셀
+SIMD_TARGET_AVX2 inline size_t SwapRB24AVX2(const unsigned char* src, unsigned char* dst, size_t bytes)
+{
+    const __m256i mask = _mm256_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15,
+                                          2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 31 <= bytes; i += 30)
+    {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 15));
+        __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), mask);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm256_castsi256_si128(v));
+        _mm_storeu_si128((__m128i*)(dst + i + 15), _mm256_extracti128_si256(v, 1));
+    }
+    return i;
+}
+
+// 32bit SSE2: 마스크/시프트로 B, R 바이트 교환 (SSSE3 없는 CPU 용)
+SIMD_TARGET_SSE2 inline size_t SwapRB32SSE2(const unsigned char* src, unsigned char* dst, size_t bytes)
+{
+    const __m128i agMask = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i ag = _mm_and_si128(v, agMask);
+        __m128i rb = _mm_and_si128(v, rbMask);
+        rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(ag, rb));
+    }
+    return i;
+}
+
+SIMD_TARGET_SSSE3 inline size_t SwapRB32SSSE3(const unsigned char* src, unsigned char* dst, size_t bytes)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+SIMD_TARGET_AVX2 inline size_t SwapRB32AVX2(const unsigned char* src, unsigned char* dst, size_t bytes)
+{
+    const __m256i mask = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                          2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+// 그레이 16픽셀 -> RGB 48바이트
+SIMD_TARGET_SSSE3 inline size_t ExpandGrayRGBSSSE3(const unsigned char* src, unsigned char* dst, size_t count)
+{
+    const __m128i m0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+    const __m128i m1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+    const __m128i m2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i g = _mm_loadu_si128((const __m128i*)(src + i));
+        unsigned char* d = dst + i * 3;
+        _mm_storeu_si128((__m128i*)(d), _mm_shuffle_epi8(g, m0));
+        _mm_storeu_si128((__m128i*)(d + 16), _mm_shuffle_epi8(g, m1));
+        _mm_storeu_si128((__m128i*)(d + 32), _mm_shuffle_epi8(g, m2));
+    }
+    return i;
+}
+
+// 그레이 16픽셀 -> RGBA 64바이트 (알파 255)
+SIMD_TARGET_SSE2 inline size_t ExpandGrayRGBASSE2(const unsigned char* src, unsigned char* dst, size_t count)
+{
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i g = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i lo = _mm_unpacklo_epi8(g, g);
+        __m128i hi = _mm_unpackhi_epi8(g, g);
+        unsigned char* d = dst + i * 4;
+        _mm_storeu_si128((__m128i*)(d),      _mm_or_si128(_mm_and_si128(_mm_unpacklo_epi16(lo, lo), rgbMask), alpha));
+        _mm_storeu_si128((__m128i*)(d + 16), _mm_or_si128(_mm_and_si128(_mm_unpackhi_epi16(lo, lo), rgbMask), alpha));
+        _mm_storeu_si128((__m128i*)(d + 32), _mm_or_si128(_mm_and_si128(_mm_unpacklo_epi16(hi, hi), rgbMask), alpha));
+        _mm_storeu_si128((__m128i*)(d + 48), _mm_or_si128(_mm_and_si128(_mm_unpackhi_epi16(hi, hi), rgbMask), alpha));
+    }
+    return i;
+}
+#endif // CPU_X86
+
+//-----------------------------------------------------------------------------
+// 공개 함수 (CPU 기능에 따라 분기)
+//-----------------------------------------------------------------------------
+inline void SwapRB24(const unsigned char* src, unsigned char* dst, size_t count)
+{
+    size_t bytes = count * 3;
+    size_t done = 0;
+#if CPU_X86
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx2) done = SwapRB24AVX2(src, dst, bytes);
+    else if (cpu.ssse3) done = SwapRB24SSSE3(src, dst, bytes);
+#endif
+    SwapRB24Scalar(src + done, dst + done, (bytes - done) / 3);
+}
+
+inline void SwapRB32(const unsigned char* src, unsigned char* dst, size_t count)
+{
+    size_t bytes = count * 4;
+    size_t done = 0;
+#if CPU_X86
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx2) done = SwapRB32AVX2(src, dst, bytes);
+    else if (cpu.ssse3) done = SwapRB32SSSE3(src, dst, bytes);
+    else if (cpu.sse2) done = SwapRB32SSE2(src, dst, bytes);
+#endif
+    SwapRB32Scalar(src + done, dst + done, (bytes - done) / 4);
+}
+
+// channels: 3 (RGB) 또는 4 (RGBA, 알파 255). src 와 dst 는 겹치면 안 됨
+inline void ExpandGray(const unsigned char* src, unsigned char* dst, size_t count, int channels)
+{
+    size_t done = 0;
+#if CPU_X86
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (channels == 3 && cpu.ssse3) done = ExpandGrayRGBSSSE3(src, dst, count);
+    else if (channels == 4 && cpu.sse2) done = ExpandGrayRGBASSE2(src, dst, count);
+#endif
+    ExpandGrayScalar(src + done, dst + done * channels, count - done, channels);
+}
+
+// 같은 픽셀을 count 번 채움 (RLE 런 패킷용)
+inline void FillPixel(unsigned char* dst, const unsigned char* px, int bytesPerPixel, size_t count)
+{
+    if (bytesPerPixel == 1)
+    {
+        memset(dst, px[0], count);
+        return;
+    }
+
+    size_t i = 0;
+#if CPU_X86
+    if (bytesPerPixel == 4)
+    {
+        int value;
+        memcpy(&value, px, 4);
+        __m128i v = _mm_set1_epi32(value);
+        for (; i + 4 <= count; i += 4) _mm_storeu_si128((__m128i*)(dst + i * 4), v);
+    }
+    else if (bytesPerPixel == 3 && count >= 16)
+    {
+        // 16픽셀(48바이트) 패턴을 만들어 세 벡터로 반복 저장
+        unsigned char pattern[48];
+        for (int k = 0; k < 48; k++) pattern[k] = px[k % 3];
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(pattern));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(pattern + 16));
+        __m128i p2 = _mm_loadu_si128((const __m128i*)(pattern + 32));
+        for (; i + 16 <= count; i += 16)
+        {
+            unsigned char* d = dst + i * 3;
+            _mm_storeu_si128((__m128i*)(d), p0);
+            _mm_storeu_si128((__m128i*)(d + 16), p1);
+            _mm_storeu_si128((__m128i*)(d + 32), p2);
+        }
+    }
+#endif
+    for (; i < count; i++) memcpy(dst + i * bytesPerPixel, px, bytesPerPixel);
+}
+
+// TGA RLE (이미지 타입 9/10/11) 디코딩. 채널 순서는 그대로 둠 (이후 SwapRB 로 일괄 변환)
+// 반환값: 소비한 입력 바이트 수, 데이터가 모자라거나 깨졌으면 0
+inline size_t DecodeRLE(const unsigned char* src, size_t srcSize, unsigned char* dst, size_t pixelCount, int bytesPerPixel)
+{
+    size_t in = 0, out = 0;
+    while (out < pixelCount)
+    {
+        if (in >= srcSize) return 0;
+        unsigned char header = src[in++];
+        size_t n = (size_t)(header & 0x7F) + 1;
+        if (n > pixelCount - out) n = pixelCount - out; // 행 끝을 넘는 잘못된 패킷은 잘라냄
+
+        if (header & 0x80)
+        {
+            if (in + bytesPerPixel > srcSize) return 0;
+            FillPixel(dst + out * bytesPerPixel, src + in, bytesPerPixel, n);
+            in += bytesPerPixel;
+        }
+        else
+        {
+            size_t bytes = n * bytesPerPixel;
+            if (in + bytes > srcSize) return 0;
+            memcpy(dst + out * bytesPerPixel, src + in, bytes);
+            in += bytes;
+        }
+        out += n;
+    }
+    return in;
+}
+
+// 행 순서 뒤집기 (top-left 원점 이미지를 GL 의 bottom-left 로)
+inline void FlipRows(unsigned char* data, size_t rowBytes, int rows)
+{
+    unsigned char tmp[1024];
+    for (int top = 0, bottom = rows - 1; top < bottom; top++, bottom--)
+    {
+        unsigned char* a = data + rowBytes * top;
+        unsigned char* b = data + rowBytes * bottom;
+        for (size_t off = 0; off < rowBytes; off += sizeof(tmp))
+        {
+            size_t n = (rowBytes - off < sizeof(tmp)) ? rowBytes - off : sizeof(tmp);
+            memcpy(tmp, a + off, n);
+            memcpy(a + off, b + off, n);
+            memcpy(b + off, tmp, n);
+        }
+    }
+}
+
+} // namespace PixelConvert
+
+#endif // PIXEL_CONVERT_H_INCLUDED
@@ -0,0 +1,507 @@
+//-----------------------------------------------------------------------------
+//           Name: ply_loader.h
+//    Description: Stanford PLY 메쉬 로더 (ASCII 병렬 파싱, binary little/big endian)
+//-----------------------------------------------------------------------------
+// ASCII 는 파일을 매핑한 뒤 행 경계에서 청크로 나눠 두 단계로 병렬 처리합니다.
+//   1) 청크마다 행 수를 세서 각 청크의 시작 행 번호를 구함
+//   2) 행 번호로 어느 element(vertex/face/...)의 몇 번째 레코드인지 알 수 있으므로
+//      청크마다 독립적으로 정점은 제자리에 쓰고, 면은 청크별 인덱스 배열에 모은 뒤 이어붙임
+// 숫자는 strtod 대신 text_parse.h 의 전용 파서로 읽습니다. (로케일/할당 없음)
+// 결과는 위치+법선(면적 가중 평균) 인터리브 정점과 삼각형 인덱스. 다각형은 팬으로 나눔.
+
+#ifndef PLY_LOADER_H_INCLUDED
+#define PLY_LOADER_H_INCLUDED
+
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include "mapped_file.h"
+#include "text_parse.h"
+
+struct PlyMesh
+{
+    std::vector<float> vertices;        // x y z nx ny nz 반복
+    std::vector<unsigned int> indices;  // 삼각형 리스트
+
+    size_t vertexCount() const { return vertices.size() / 6; }
+    size_t triangleCount() const { return indices.size() / 3; }
+};
+
+class PlyLoader
+{
+public:
+    enum PlyLoadError
+    {
+        PLY_NO_ERROR = 1,   // No error
+        PLY_FILE_NOT_FOUND, // File was not found or could not be mapped
+        PLY_BAD_HEADER,     // Not a PLY file or malformed header
+        PLY_UNSUPPORTED,    // Missing x/y/z or face list, list properties on vertices (binary)
+        PLY_BAD_DATA        // Truncated body, unparsable numbers or out of range indices
+    };
+
+    // threads 0 = 하드웨어 스레드 수
+    static PlyLoadError load(const char* path, PlyMesh& mesh, int threads = 0)
+    {
+        MappedFile file;
+        if (!file.open(path)) return PLY_FILE_NOT_FOUND;
+        return parse(file.data(), file.size(), mesh, threads);
+    }
+
+    static PlyLoadError parse(const unsigned char* data, size_t size, PlyMesh& mesh, int threads = 0)
+    {
+        Header h;
+        PlyLoadError err = parseHeader((const char*)data, size, h);
+        if (err != PLY_NO_ERROR) return err;
+
+        // 정점 수를 믿고 할당하기 전에 본문에 들어갈 수 있는 수인지 확인 (깨진 헤더의 거대한 count 방지)
+        const Element& ve = h.elements[h.vertexElement];
+        size_t available = size - h.bodyOffset + (h.format == FORMAT_ASCII ? 1 : 0);
+        size_t minRecord = MinRecordSize(h, ve);
+        if (ve.count > 0 && (minRecord == 0 || ve.count > available / minRecord)) return PLY_BAD_DATA;
+
+        mesh.vertices.assign(ve.count * 6, 0.0f);
+        mesh.indices.clear();
+
+        const char* body = (const char*)data + h.bodyOffset;
+        const char* end = (const char*)data + size;
+        if (h.format == FORMAT_ASCII) err = parseAscii(h, body, end, mesh, threads);
+        else err = parseBinary(h, (const unsigned char*)body, (const unsigned char*)end, mesh);
+        if (err != PLY_NO_ERROR) return err;
+
+        ComputeNormals(mesh);
+        return PLY_NO_ERROR;
+    }
+
+    // 면적 가중 정점 법선 (외적을 정규화하지 않고 누적)
+    static void ComputeNormals(PlyMesh& mesh)
+    {
+        float* v = mesh.vertices.data();
+        size_t n = mesh.vertexCount();
+        for (size_t i = 0; i < n; i++) v[i * 6 + 3] = v[i * 6 + 4] = v[i * 6 + 5] = 0.0f;
+
+        for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+        {
+            const float* a = v + mesh.indices[t] * 6;
+            const float* b = v + mesh.indices[t + 1] * 6;
+            const float* c = v + mesh.indices[t + 2] * 6;
+            float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            float nx = e1[1] * e2[2] - e1[2] * e2[1];
+            float ny = e1[2] * e2[0] - e1[0] * e2[2];
+            float nz = e1[0] * e2[1] - e1[1] * e2[0];
+            for (int k = 0; k < 3; k++)
+            {
+                float* dst = v + mesh.indices[t + k] * 6 + 3;
+                dst[0] += nx; dst[1] += ny; dst[2] += nz;
+            }
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            float* nrm = v + i * 6 + 3;
+            float len = sqrtf(nrm[0] * nrm[0] + nrm[1] * nrm[1] + nrm[2] * nrm[2]);
+            if (len > 0.0f) { nrm[0] /= len; nrm[1] /= len; nrm[2] /= len; }
+            else nrm[1] = 1.0f;
+        }
+    }
+
+private:
+    enum Format { FORMAT_ASCII, FORMAT_BINARY_LE, FORMAT_BINARY_BE };
+    enum Type { TYPE_NONE, TYPE_INT8, TYPE_UINT8, TYPE_INT16, TYPE_UINT16, TYPE_INT32, TYPE_UINT32, TYPE_FLOAT32, TYPE_FLOAT64 };
+
+    struct Property
+    {
+        std::string name;
+        Type type;
+        Type countType;     // 리스트일 때만 TYPE_NONE 이 아님
+    };
+
+    struct Element
+    {
+        std::string name;
+        size_t count;
+        size_t firstLine;   // ASCII 본문에서 이 element 가 시작하는 행
+        std::vector<Property> props;
+    };
+
+    struct Header
+    {
+        Format format;
+        size_t bodyOffset;
+        std::vector<Element> elements;
+        int vertexElement, faceElement;
+        int xyz[3];         // vertex element 안에서 x/y/z 속성 위치
+        int faceList;       // face element 안에서 정점 인덱스 리스트 위치
+    };
+
+    static Type ParseType(const std::string& s)
+    {
+        if (s == "char" || s == "int8") return TYPE_INT8;
+        if (s == "uchar" || s == "uint8") return TYPE_UINT8;
+        if (s == "short" || s == "int16") return TYPE_INT16;
+        if (s == "ushort" || s == "uint16") return TYPE_UINT16;
+        if (s == "int" || s == "int32") return TYPE_INT32;
+        if (s == "uint" || s == "uint32") return TYPE_UINT32;
+        if (s == "float" || s == "float32") return TYPE_FLOAT32;
+        if (s == "double" || s == "float64") return TYPE_FLOAT64;
+        return TYPE_NONE;
+    }
+
+    static int TypeSize(Type t)
+    {
+        switch (t)
+        {
+        case TYPE_INT8: case TYPE_UINT8: return 1;
+        case TYPE_INT16: case TYPE_UINT16: return 2;
+        case TYPE_FLOAT64: return 8;
+        default: return 4;
+        }
+    }
+
+    // 레코드 하나가 본문에서 차지하는 최소 바이트. binary 는 속성 크기 합 (리스트는 개수 필드만),
+    // ASCII 는 속성마다 숫자 한 글자 + 구분자 한 글자 (마지막 행의 줄바꿈은 없을 수 있어 호출 쪽에서 +1)
+    static size_t MinRecordSize(const Header& h, const Element& e)
+    {
+        size_t bytes = 0;
+        for (auto& p : e.props)
+        {
+            if (h.format == FORMAT_ASCII) bytes += 2;
+            else bytes += TypeSize(p.countType != TYPE_NONE ? p.countType : p.type);
+        }
+        return bytes;
+    }
+
+    static PlyLoadError parseHeader(const char* data, size_t size, Header& h)
+    {
+        if (size < 4 || memcmp(data, "ply", 3) != 0 || (data[3] != '\n' && data[3] != '\r')) return PLY_BAD_HEADER;
+
+        h.vertexElement = h.faceElement = -1;
+        h.xyz[0] = h.xyz[1] = h.xyz[2] = -1;
+        h.faceList = -1;
+        bool hasFormat = false;
+
+        size_t pos = 0;
+        for (;;)
+        {
+            size_t eol = pos;
+            while (eol < size && data[eol] != '\n') eol++;
+            if (eol >= size) return PLY_BAD_HEADER;
+
+            // 행을 공백 단위 토큰으로
+            std::vector<std::string> tok;
+            for (size_t i = pos; i < eol;)
+            {
+                while (i < eol && (data[i] == ' ' || data[i] == '\t' || data[i] == '\r')) i++;
+                size_t start = i;
+                while (i < eol && data[i] != ' ' && data[i] != '\t' && data[i] != '\r') i++;
+                if (i > start) tok.push_back(std::string(data + start, i - start));
+            }
+            pos = eol + 1;
+
+            if (tok.empty() || tok[0] == "ply" || tok[0] == "comment" || tok[0] == "obj_info") continue;
+            if (tok[0] == "end_header") break;
+
+            if (tok[0] == "format" && tok.size() >= 2)
+            {
+                if (tok[1] == "ascii") h.format = FORMAT_ASCII;
+                else if (tok[1] == "binary_little_endian") h.format = FORMAT_BINARY_LE;
+                else if (tok[1] == "binary_big_endian") h.format = FORMAT_BINARY_BE;
+                else return PLY_BAD_HEADER;
+                hasFormat = true;
+            }
+            else if (tok[0] == "element" && tok.size() >= 3)
+            {
+                Element e;
+                e.name = tok[1];
+                e.count = (size_t)strtoul(tok[2].c_str(), NULL, 10);
+                e.firstLine = 0;
+                if (e.name == "vertex") h.vertexElement = (int)h.elements.size();
+                if (e.name == "face") h.faceElement = (int)h.elements.size();
+                h.elements.push_back(e);
+            }
+            else if (tok[0] == "property" && !h.elements.empty())
+            {
+                Property p;
+                if (tok.size() >= 5 && tok[1] == "list")
+                {
+                    p.countType = ParseType(tok[2]);
+                    p.type = ParseType(tok[3]);
+                    p.name = tok[4];
+                    if (p.countType == TYPE_NONE || p.countType == TYPE_FLOAT32 || p.countType == TYPE_FLOAT64) return PLY_BAD_HEADER;
+                }
+                else if (tok.size() >= 3)
+                {
+                    p.countType = TYPE_NONE;
+                    p.type = ParseType(tok[1]);
+                    p.name = tok[2];
+                }
+                else return PLY_BAD_HEADER;
+                if (p.type == TYPE_NONE) return PLY_BAD_HEADER;
+                h.elements.back().props.push_back(p);
+            }
+            else return PLY_BAD_HEADER;
+        }
+
+        if (!hasFormat || h.vertexElement < 0) return PLY_BAD_HEADER;
+        h.bodyOffset = pos;
+
+        const Element& ve = h.elements[h.vertexElement];
+        for (size_t i = 0; i < ve.props.size(); i++)
+        {
+            if (ve.props[i].countType != TYPE_NONE) continue;
+            if (ve.props[i].name == "x") h.xyz[0] = (int)i;
+            if (ve.props[i].name == "y") h.xyz[1] = (int)i;
+            if (ve.props[i].name == "z") h.xyz[2] = (int)i;
+        }
+        if (h.xyz[0] < 0 || h.xyz[1] < 0 || h.xyz[2] < 0) return PLY_UNSUPPORTED;
+
+        if (h.faceElement >= 0)
+        {
+            const Element& fe = h.elements[h.faceElement];
+            for (size_t i = 0; i < fe.props.size(); i++)
+                if (fe.props[i].countType != TYPE_NONE && (fe.props[i].name == "vertex_indices" || fe.props[i].name == "vertex_index"))
+                    h.faceList = (int)i;
+            if (h.faceList < 0) return PLY_UNSUPPORTED;
+        }
+
+        size_t line = 0;
+        for (auto& e : h.elements)
+        {
+            e.firstLine = line;
+            line += e.count;
+        }
+        return PLY_NO_ERROR;
+    }
+
+    // ---------------------------------------------------------------- ASCII
+
+    struct AsciiChunk
+    {
+        const char* begin;
+        const char* end;
+        size_t firstLine;
+        std::vector<unsigned int> indices;
+        bool ok;
+    };
+
+    static PlyLoadError parseAscii(const Header& h, const char* body, const char* end, PlyMesh& mesh, int threads)
+    {
+        if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+        if (threads <= 0) threads = 1;
+        // 작은 파일은 스레드 생성 비용이 더 큼
+        size_t minChunk = 128 * 1024;
+        if ((size_t)(end - body) / minChunk < (size_t)threads) threads = (int)((end - body) / minChunk) + 1;
+
+        // 행 경계로 자른 청크
+        std::vector<AsciiChunk> chunks(threads);
+        const char* p = body;
+        for (int i = 0; i < threads; i++)
+        {
+            chunks[i].begin = p;
+            const char* q = (i == threads - 1) ? end : body + (end - body) * (i + 1) / threads;
+            if (q < p) q = p;
+            const char* nl = (q < end) ? (const char*)memchr(q, '\n', end - q) : NULL;
+            p = (i == threads - 1 || !nl) ? end : nl + 1;
+            chunks[i].end = p;
+            chunks[i].ok = true;
+        }
+
+        // 1) 청크별 행 수 -> 시작 행 번호
+        std::vector<size_t> lineCounts(threads, 0);
+        RunParallel(threads, [&](int i) {
+            const char* s = chunks[i].begin;
+            size_t n = 0;
+            while (s < chunks[i].end && (s = (const char*)memchr(s, '\n', chunks[i].end - s)) != NULL) { n++; s++; }
+            lineCounts[i] = n;
+        });
+        size_t line = 0;
+        for (int i = 0; i < threads; i++)
+        {
+            chunks[i].firstLine = line;
+            line += lineCounts[i];
+        }
+
+        // 2) 청크별 파싱
+        size_t vertexCount = h.elements[h.vertexElement].count;
+        RunParallel(threads, [&](int i) { chunks[i].ok = parseAsciiChunk(h, chunks[i], mesh.vertices.data(), vertexCount); });
+
+        size_t total = 0;
+        for (auto& c : chunks)
+        {
+            if (!c.ok) return PLY_BAD_DATA;
+            total += c.indices.size();
+        }
+
+        // 본문이 header 의 레코드 수보다 짧은 경우
+        const Element& last = h.elements.back();
+        if (line + (end > body && end[-1] != '\n' ? 1 : 0) < last.firstLine + last.count) return PLY_BAD_DATA;
+
+        mesh.indices.reserve(total);
+        for (auto& c : chunks) mesh.indices.insert(mesh.indices.end(), c.indices.begin(), c.indices.end());
+        return PLY_NO_ERROR;
+    }
+
+    static bool parseAsciiChunk(const Header& h, AsciiChunk& chunk, float* vertices, size_t vertexCount)
+    {
+        const Element& ve = h.elements[h.vertexElement];
+        const Element* fe = (h.faceElement >= 0) ? &h.elements[h.faceElement] : NULL;
+
+        const char* p = chunk.begin;
+        size_t line = chunk.firstLine;
+        std::vector<unsigned int> poly;
+
+        while (p < chunk.end)
+        {
+            const char* eol = (const char*)memchr(p, '\n', chunk.end - p);
+            if (!eol) eol = chunk.end;
+
+            if (line >= ve.firstLine && line < ve.firstLine + ve.count)
+            {
+                float* v = vertices + (line - ve.firstLine) * 6;
+                for (size_t k = 0; k < ve.props.size(); k++)
+                {
+                    double value;
+                    if (ve.props[k].countType != TYPE_NONE)
+                    {
+                        if (!TextParse::ParseFloat(p, eol, value)) return false;
+                        for (int n = (int)value; n > 0; n--) if (!TextParse::ParseFloat(p, eol, value)) return false;
+                        continue;
+                    }
+                    if (!TextParse::ParseFloat(p, eol, value)) return false;
+                    if ((int)k == h.xyz[0]) v[0] = (float)value;
+                    else if ((int)k == h.xyz[1]) v[1] = (float)value;
+                    else if ((int)k == h.xyz[2]) v[2] = (float)value;
+                }
+            }
+            else if (fe && line >= fe->firstLine && line < fe->firstLine + fe->count)
+            {
+                for (size_t k = 0; k < fe->props.size(); k++)
+                {
+                    double value;
+                    if (!TextParse::ParseFloat(p, eol, value)) return false;
+                    if (fe->props[k].countType == TYPE_NONE) continue;
+
+                    int n = (int)value;
+                    if (n < 0) return false;
+                    poly.clear();
+                    for (int j = 0; j < n; j++)
+                    {
+                        if (!TextParse::ParseFloat(p, eol, value)) return false;
+                        poly.push_back((unsigned int)value);
+                    }
+                    if ((int)k != h.faceList) continue;
+                    if (!AppendPolygon(poly, vertexCount, chunk.indices)) return false;
+                }
+            }
+
+            p = eol + 1;
+            line++;
+        }
+        return true;
+    }
+
+    // 다각형을 삼각형 팬으로 (인덱스 범위 검사 포함)
+    static bool AppendPolygon(const std::vector<unsigned int>& poly, size_t vertexCount, std::vector<unsigned int>& out)
+    {
+        for (unsigned int idx : poly) if (idx >= vertexCount) return false;
+        for (size_t j = 2; j < poly.size(); j++)
+        {
+            out.push_back(poly[0]);
+            out.push_back(poly[j - 1]);
+            out.push_back(poly[j]);
+        }
+        return true;
+    }
+
+    template <typename Func>
+    static void RunParallel(int count, Func func)
+    {
+        if (count == 1) { func(0); return; }
+        std::vector<std::thread> workers;
+        for (int i = 1; i < count; i++) workers.push_back(std::thread(func, i));
+        func(0);
+        for (auto& t : workers) t.join();
+    }
+
+    // --------------------------------------------------------------- binary
+
+    static bool ReadScalar(const unsigned char*& p, const unsigned char* end, Type type, bool swap, double& out)
+    {
+        int size = TypeSize(type);
+        if (end - p < size) return false;
+        unsigned char b[8];
+        for (int i = 0; i < size; i++) b[i] = swap ? p[size - 1 - i] : p[i];
+        p += size;
+
+        switch (type)
+        {
+        case TYPE_INT8:    out = (signed char)b[0]; break;
+        case TYPE_UINT8:   out = b[0]; break;
+        case TYPE_INT16:   { short v; memcpy(&v, b, 2); out = v; } break;
+        case TYPE_UINT16:  { unsigned short v; memcpy(&v, b, 2); out = v; } break;
+        case TYPE_INT32:   { int v; memcpy(&v, b, 4); out = v; } break;
+        case TYPE_UINT32:  { unsigned int v; memcpy(&v, b, 4); out = v; } break;
+        case TYPE_FLOAT32: { float v; memcpy(&v, b, 4); out = v; } break;
+        case TYPE_FLOAT64: { double v; memcpy(&v, b, 8); out = v; } break;
+        default: return false;
+        }
+        return true;
+    }
+
+    static PlyLoadError parseBinary(const Header& h, const unsigned char* p, const unsigned char* end, PlyMesh& mesh)
+    {
+        const unsigned short probe = 1;
+        bool littleHost = *(const unsigned char*)&probe == 1;
+        bool swap = (h.format == FORMAT_BINARY_LE) != littleHost;
+
+        size_t vertexCount = h.elements[h.vertexElement].count;
+        std::vector<unsigned int> poly;
+
+        for (int e = 0; e < (int)h.elements.size(); e++)
+        {
+            const Element& el = h.elements[e];
+            for (size_t r = 0; r < el.count; r++)
+            {
+                float* v = (e == h.vertexElement) ? &mesh.vertices[r * 6] : NULL;
+                for (size_t k = 0; k < el.props.size(); k++)
+                {
+                    const Property& prop = el.props[k];
+                    double value;
+                    if (prop.countType == TYPE_NONE)
+                    {
+                        if (!ReadScalar(p, end, prop.type, swap, value)) return PLY_BAD_DATA;
+                        if (v && (int)k == h.xyz[0]) v[0] = (float)value;
+                        else if (v && (int)k == h.xyz[1]) v[1] = (float)value;
+                        else if (v && (int)k == h.xyz[2]) v[2] = (float)value;
+                        continue;
+                    }
+
+                    if (!ReadScalar(p, end, prop.countType, swap, value) || value < 0) return PLY_BAD_DATA;
+                    int n = (int)value;
+                    bool keep = (e == h.faceElement && (int)k == h.faceList);
+                    if (!keep)
+                    {
+                        // 쓰지 않는 리스트는 건너뜀
+                        size_t skip = (size_t)n * TypeSize(prop.type);
+                        if ((size_t)(end - p) < skip) return PLY_BAD_DATA;
+                        p += skip;
+                        continue;
+                    }
+
+                    poly.clear();
+                    for (int j = 0; j < n; j++)
+                    {
+                        if (!ReadScalar(p, end, prop.type, swap, value) || value < 0) return PLY_BAD_DATA;
+                        poly.push_back((unsigned int)value);
+                    }
+                    if (!AppendPolygon(poly, vertexCount, mesh.indices)) return PLY_BAD_DATA;
+                }
+            }
+        }
+        return PLY_NO_ERROR;
+    }
+};
+
+#endif // PLY_LOADER_H_INCLUDED
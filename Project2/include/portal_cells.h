@@ -0,0 +1,313 @@
+//-----------------------------------------------------------------------------
+//           Name: portal_cells.h
+//    Description: 셀-포털 가시성 (방 = AABB 셀, 문 구멍 = 볼록 다각형 포털)
+//-----------------------------------------------------------------------------
+// update() 는 눈이 있는 셀에서 시작해 열린 포털마다
+//   1) 포털 다각형을 지금 절두체 평면들로 자르고 (Sutherland-Hodgman)
+//   2) 남은 다각형이 있으면 눈과 그 변들로 좁힌 절두체(+ 포털 평면) 를 만들어 건너편 셀로 내려감.
+// 셀마다 그 셀을 보는 좁혀진 절두체 목록이 남고, 오브젝트는 걸친 셀 중 하나의 절두체 안에 있어야 보임.
+// 닫힌 포털, 화면 밖이나 다른 포털에 가려진 포털 너머 셀은 통째로 빠짐. 같은 경로로 같은 셀을 두 번
+// 지나지 않고 깊이 MAX_DEPTH 까지만 내려가므로, 방이 많아도 비용은 실제로 보이는 포털 수에 비례
+// (눈이 있는 셀 찾기만 셀 수에 비례).
+// 눈이 어느 셀에도 없으면 (바깥) 모든 셀이 원래 절두체로 보임.
+
+#ifndef PORTAL_CELLS_H_INCLUDED
+#define PORTAL_CELLS_H_INCLUDED
+
+#include <math.h>
+#include <vector>
+
+class PortalCells
+{
+public:
+    struct Stats
+    {
+        int cellsVisible;
+        int portalsTested;      // 열린 포털 중 눈 쪽에서 검사한 수
+        int portalsPassed;      // 잘린 뒤에도 남아서 건너간 수
+    };
+
+    enum { MAX_DEPTH = 32, MAX_FRUSTA_PER_CELL = 16 };
+
+    PortalCells() : m_eyeCell(-1)
+    {
+        m_stats.cellsVisible = m_stats.portalsTested = m_stats.portalsPassed = 0;
+    }
+
+    int addCell(const float boxMin[3], const float boxMax[3])
+    {
+        Cell c;
+        for (int k = 0; k < 3; k++) { c.min[k] = boxMin[k]; c.max[k] = boxMax[k]; }
+        c.visible = false;
+        m_cells.push_back(c);
+        return (int)m_cells.size() - 1;
+    }
+
+    // corners: 볼록 다각형 꼭짓점 count 개 (둘레 순서, 한 평면 위)
+    int addPortal(int cellA, int cellB, const float* corners, int count)
+    {
+        Portal p;
+        p.cells[0] = cellA;
+        p.cells[1] = cellB;
+        p.open = true;
+        for (int i = 0; i < count; i++) p.polygon.push_back(Vec3(corners[i * 3], corners[i * 3 + 1], corners[i * 3 + 2]));
+
+        // 평면: 법선이 cellB 쪽을 향하게
+        Vec3 n = cross(p.polygon[1] - p.polygon[0], p.polygon[2] - p.polygon[0]);
+        n = n * (1.0f / sqrtf(dot(n, n)));
+        float d = -dot(n, p.polygon[0]);
+        if (dot(n, cellCenter(cellB)) + d < 0.0f) { n = n * -1.0f; d = -d; }
+        p.plane = Plane(n, d);
+
+        int id = (int)m_portals.size();
+        m_portals.push_back(p);
+        m_cells[cellA].portals.push_back(id);
+        m_cells[cellB].portals.push_back(id);
+        return id;
+    }
+
+    void setOpen(int portal, bool open) { m_portals[portal].open = open; }
+    bool isOpen(int portal) const { return m_portals[portal].open; }
+    int cellCount() const { return (int)m_cells.size(); }
+    int eyeCell() const { return m_eyeCell; }
+
+    int findCell(const float p[3]) const
+    {
+        for (int i = 0; i < (int)m_cells.size(); i++)
+        {
+            const Cell& c = m_cells[i];
+            if (p[0] >= c.min[0] && p[0] < c.max[0] && p[1] >= c.min[1] && p[1] < c.max[1] && p[2] >= c.min[2] && p[2] < c.max[2]) return i;
+        }
+        return -1;
+    }
+
+    // AABB 가 (경계 포함) 겹치는 셀 번호 (벽처럼 두 방 경계에 걸친 것은 둘 다)
+    void overlappingCells(const float boxMin[3], const float boxMax[3], std::vector<int>& out) const
+    {
+        out.clear();
+        for (int i = 0; i < (int)m_cells.size(); i++)
+        {
+            const Cell& c = m_cells[i];
+            if (boxMin[0] <= c.max[0] && boxMax[0] >= c.min[0] && boxMin[1] <= c.max[1] && boxMax[1] >= c.min[1] &&
+                boxMin[2] <= c.max[2] && boxMax[2] >= c.min[2]) out.push_back(i);
+        }
+    }
+
+    // planes: 시야 절두체 (a*x + b*y + c*z + d >= 0 이 안쪽). 반환: 보이는 셀 수
+    int update(const float eye[3], const float planes[][4], int planeCount)
+    {
+        m_stats.cellsVisible = m_stats.portalsTested = m_stats.portalsPassed = 0;
+        // 지난번에 보인 셀만 지움 (방이 많아도 보이는 셀 수에 비례)
+        for (int i : m_visibleList)
+        {
+            m_cells[i].visible = false;
+            m_cells[i].frusta.clear();
+        }
+        m_visibleList.clear();
+
+        Frustum view;
+        for (int i = 0; i < planeCount; i++) view.push_back(Plane(Vec3(planes[i][0], planes[i][1], planes[i][2]), planes[i][3]));
+
+        m_eye = Vec3(eye[0], eye[1], eye[2]);
+        m_eyeCell = findCell(eye);
+        if (m_eyeCell < 0)
+        {
+            for (int i = 0; i < (int)m_cells.size(); i++) markVisible(i, view);
+        }
+        else
+        {
+            std::vector<int> path;
+            flood(m_eyeCell, -1, view, path);
+        }
+
+        m_stats.cellsVisible = (int)m_visibleList.size();
+        return m_stats.cellsVisible;
+    }
+
+    bool cellVisible(int cell) const { return m_cells[cell].visible; }
+
+    // 구가 cells 중 하나를 보는 절두체 안에 있으면 true. cells 가 비었으면 (셀 밖 오브젝트) 항상 true
+    bool sphereVisible(const std::vector<int>& cells, const float center[3], float radius) const
+    {
+        if (cells.empty()) return true;
+        Vec3 c(center[0], center[1], center[2]);
+        for (int cell : cells)
+        {
+            for (const Frustum& f : m_cells[cell].frusta)
+                if (sphereInside(f, c, radius)) return true;
+        }
+        return false;
+    }
+
+    const Stats& stats() const { return m_stats; }
+
+private:
+    struct Vec3
+    {
+        float x, y, z;
+        Vec3() : x(0.0f), y(0.0f), z(0.0f) {}
+        Vec3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+        Vec3 operator+(const Vec3& o) const { return Vec3(x + o.x, y + o.y, z + o.z); }
+        Vec3 operator-(const Vec3& o) const { return Vec3(x - o.x, y - o.y, z - o.z); }
+        Vec3 operator*(float s) const { return Vec3(x * s, y * s, z * s); }
+    };
+
+    struct Plane
+    {
+        Vec3 n;
+        float d;
+        Plane() : d(0.0f) {}
+        Plane(const Vec3& n_, float d_) : n(n_), d(d_) {}
+        float distance(const Vec3& p) const { return n.x * p.x + n.y * p.y + n.z * p.z + d; }
+    };
+
+    typedef std::vector<Plane> Frustum;
+
+    struct Cell
+    {
+        float min[3], max[3];
+        std::vector<int> portals;
+        bool visible;
+        std::vector<Frustum> frusta;    // 이 셀을 보는 (좁혀진) 절두체들
+    };
+
+    struct Portal
+    {
+        int cells[2];
+        std::vector<Vec3> polygon;
+        Plane plane;                    // 법선이 cells[1] 쪽
+        bool open;
+    };
+
+    static float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    static Vec3 cross(const Vec3& a, const Vec3& b) { return Vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x); }
+
+    Vec3 cellCenter(int cell) const
+    {
+        const Cell& c = m_cells[cell];
+        return Vec3((c.min[0] + c.max[0]) * 0.5f, (c.min[1] + c.max[1]) * 0.5f, (c.min[2] + c.max[2]) * 0.5f);
+    }
+
+    // 구 검사는 정규화된 평면 기준 (잘라서 만든 평면은 정규화해 둠)
+    static bool sphereInside(const Frustum& f, const Vec3& c, float radius)
+    {
+        for (const Plane& p : f)
+        {
+            float len = sqrtf(dot(p.n, p.n));
+            if (p.distance(c) < -radius * len) return false;
+        }
+        return true;
+    }
+
+    void markVisible(int cell, const Frustum& f)
+    {
+        Cell& c = m_cells[cell];
+        if (!c.visible) m_visibleList.push_back(cell);
+        c.visible = true;
+        if (c.frusta.size() < MAX_FRUSTA_PER_CELL) c.frusta.push_back(f);
+        else c.frusta[MAX_FRUSTA_PER_CELL - 1] = loosest(c.frusta[MAX_FRUSTA_PER_CELL - 1], f);
+    }
+
+    // 절두체가 너무 많이 쌓이면 마지막 칸은 두 절두체 모두를 담도록 공통 평면만 남김 (보수적으로 넓게)
+    static Frustum loosest(const Frustum& a, const Frustum& b)
+    {
+        Frustum out;
+        for (const Plane& p : a)
+            for (const Plane& q : b)
+                if (p.n.x == q.n.x && p.n.y == q.n.y && p.n.z == q.n.z && p.d == q.d) out.push_back(p);
+        return out;
+    }
+
+    void flood(int cell, int fromPortal, const Frustum& frustum, std::vector<int>& path)
+    {
+        markVisible(cell, frustum);
+        if ((int)path.size() >= MAX_DEPTH) return;
+        path.push_back(cell);
+
+        for (int id : m_cells[cell].portals)
+        {
+            const Portal& portal = m_portals[id];
+            if (id == fromPortal || !portal.open) continue;
+            int next = (portal.cells[0] == cell) ? portal.cells[1] : portal.cells[0];
+            bool onPath = false;
+            for (int c : path) onPath = onPath || c == next;
+            if (onPath) continue;
+
+            // 포털 평면을 이 셀 -> 건너편 방향으로. 눈이 이미 건너편에 있으면 뒤에서 본 것
+            Plane toward = portal.plane;
+            if (portal.cells[0] != cell) toward = Plane(toward.n * -1.0f, -toward.d);
+            float eyeSide = toward.distance(m_eye);
+            if (eyeSide > 0.0f) continue;
+            m_stats.portalsTested++;
+
+            // 눈이 포털 평면에 거의 붙어 있으면 (문턱에 선 경우) 좁히지 않고 그대로 넘김
+            if (eyeSide > -0.05f)
+            {
+                m_stats.portalsPassed++;
+                flood(next, id, frustum, path);
+                continue;
+            }
+
+            std::vector<Vec3> polygon = portal.polygon;
+            for (const Plane& p : frustum)
+            {
+                clip(polygon, p);
+                if (polygon.size() < 3) break;
+            }
+            if (polygon.size() < 3) continue;
+
+            m_stats.portalsPassed++;
+            flood(next, id, narrow(polygon, toward), path);
+        }
+        path.pop_back();
+    }
+
+    // 눈과 다각형 변마다 평면 하나 (다각형 중심이 안쪽) + 포털 평면 자체 (건너편이 안쪽)
+    Frustum narrow(const std::vector<Vec3>& polygon, const Plane& portalPlane) const
+    {
+        Vec3 centroid;
+        for (const Vec3& v : polygon) centroid = centroid + v;
+        centroid = centroid * (1.0f / polygon.size());
+
+        Frustum out;
+        for (size_t i = 0; i < polygon.size(); i++)
+        {
+            const Vec3& a = polygon[i];
+            const Vec3& b = polygon[(i + 1) % polygon.size()];
+            Vec3 n = cross(a - m_eye, b - m_eye);
+            float len = sqrtf(dot(n, n));
+            if (len < 1e-6f) continue;
+            n = n * (1.0f / len);
+            Plane p(n, -dot(n, m_eye));
+            if (p.distance(centroid) < 0.0f) p = Plane(n * -1.0f, -p.d);
+            out.push_back(p);
+        }
+        out.push_back(portalPlane);
+        return out;
+    }
+
+    // 다각형에서 평면 바깥(음수) 부분을 잘라냄
+    static void clip(std::vector<Vec3>& polygon, const Plane& plane)
+    {
+        std::vector<Vec3> out;
+        size_t n = polygon.size();
+        for (size_t i = 0; i < n; i++)
+        {
+            const Vec3& a = polygon[i];
+            const Vec3& b = polygon[(i + 1) % n];
+            float da = plane.distance(a), db = plane.distance(b);
+            if (da >= 0.0f) out.push_back(a);
+            if ((da >= 0.0f) != (db >= 0.0f)) out.push_back(a + (b - a) * (da / (da - db)));
+        }
+        polygon.swap(out);
+    }
+
+    std::vector<Cell> m_cells;
+    std::vector<Portal> m_portals;
+    std::vector<int> m_visibleList;     // visible 이 켜진 셀 (다음 update 에서 지울 것)
+    Vec3 m_eye;
+    int m_eyeCell;
+    Stats m_stats;
+};
+
+#endif // PORTAL_CELLS_H_INCLUDED
@@ -0,0 +1,180 @@
+//-----------------------------------------------------------------------------
+//           Name: ppm.h
+//    Description: Netpbm PPM/PGM loader (P6/P5 binary, P3/P2 ASCII)
+//-----------------------------------------------------------------------------
+// The file is memory mapped and rows are copied bottom-up for OpenGL in one
+// pass. Grayscale (PGM) images are expanded to RGB with the SIMD kernels in
+// pixel_convert.h, 16-bit and non-255 maxval samples are rescaled to 8 bits.
+
+#ifndef PPM_H_INCLUDED
+#define PPM_H_INCLUDED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include <gl/gl.h>
+#include "mapped_file.h"
+#include "pixel_convert.h"
+
+class ppmImageFile
+{
+public:
+
+    ppmImageFile(void) :
+        m_texFormat(-1),
+        m_nImageWidth(0),
+        m_nImageHeight(0),
+        m_nImageData(NULL) {}
+
+    ~ppmImageFile(void)
+    {
+        if( m_nImageData != NULL )
+        {
+            free( m_nImageData );
+            m_nImageData = NULL;
+        }
+    }
+
+    enum PPMLoadError
+    {
+        PPM_NO_ERROR = 1,   // No error
+        PPM_FILE_NOT_FOUND, // File was not found
+        PPM_BAD_FORMAT,     // Not a P2/P3/P5/P6 file or bad header values
+        PPM_BAD_DATA        // Pixel data is missing or truncated
+    };
+
+    PPMLoadError load( const char *name );
+
+    GLenum m_texFormat;     // Always GL_RGB
+    int    m_nImageWidth;
+    int    m_nImageHeight;
+    unsigned char * m_nImageData;
+
+private:
+
+    // Reads the next header integer, skipping whitespace and # comments.
+    static bool readInt( const unsigned char *data, size_t size, size_t &pos, int &value )
+    {
+        while( pos < size )
+        {
+            if( data[pos] == '#' )
+                while( pos < size && data[pos] != '\n' ) pos++;
+            else if( data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n' )
+                pos++;
+            else
+                break;
+        }
+
+        if( pos >= size || data[pos] < '0' || data[pos] > '9' )
+            return false;
+
+        value = 0;
+        while( pos < size && data[pos] >= '0' && data[pos] <= '9' )
+        {
+            value = value * 10 + (data[pos] - '0');
+            if( value > 1 << 24 ) return false;
+            pos++;
+        }
+        return true;
+    }
+};
+
+inline ppmImageFile::PPMLoadError ppmImageFile::load( const char *name )
+{
+    MappedFile file;
+    if( !file.open( name ) )
+        return PPM_FILE_NOT_FOUND;
+
+    const unsigned char *data = file.data();
+    size_t size = file.size();
+
+    if( size < 3 || data[0] != 'P' || (data[1] != '2' && data[1] != '3' && data[1] != '5' && data[1] != '6') )
+        return PPM_BAD_FORMAT;
+
+    bool binary = (data[1] == '5' || data[1] == '6');
+    int channels = (data[1] == '3' || data[1] == '6') ? 3 : 1;
+
+    size_t pos = 2;
+    int width, height, maxValue;
+    if( !readInt( data, size, pos, width ) || !readInt( data, size, pos, height ) ||
+        !readInt( data, size, pos, maxValue ) )
+        return PPM_BAD_FORMAT;
+
+    if( width <= 0 || height <= 0 || width > 16384 || height > 16384 || maxValue <= 0 || maxValue > 65535 )
+        return PPM_BAD_FORMAT;
+
+    pos++; // single whitespace after maxval
+
+    size_t rowOut = (size_t)width * 3;
+    unsigned char *rgb = (unsigned char *)malloc( rowOut * height );
+    if( rgb == NULL )
+        return PPM_BAD_DATA;
+
+    int sampleBytes = (maxValue > 255) ? 2 : 1;
+    size_t rowIn = (size_t)width * channels * sampleBytes;
+    unsigned char *row = (unsigned char *)malloc( (size_t)width * channels );
+
+    for( int y = 0; y < height; y++ )
+    {
+        // PPM rows are top to bottom, OpenGL wants bottom to top
+        unsigned char *dst = rgb + rowOut * (height - 1 - y);
+        const unsigned char *samples = NULL;
+
+        if( binary )
+        {
+            if( pos + rowIn > size )
+            {
+                free( row );
+                free( rgb );
+                return PPM_BAD_DATA;
+            }
+
+            if( sampleBytes == 1 && maxValue == 255 )
+                samples = data + pos;
+            else
+            {
+                for( int i = 0; i < width * channels; i++ )
+                {
+                    int v = (sampleBytes == 2) ? (data[pos + i * 2] << 8 | data[pos + i * 2 + 1]) : data[pos + i];
+                    row[i] = (unsigned char)(v * 255 / maxValue);
+                }
+                samples = row;
+            }
+            pos += rowIn;
+        }
+        else
+        {
+            for( int i = 0; i < width * channels; i++ )
+            {
+                int v;
+                if( !readInt( data, size, pos, v ) )
+                {
+                    free( row );
+                    free( rgb );
+                    return PPM_BAD_DATA;
+                }
+                row[i] = (unsigned char)((v > maxValue ? maxValue : v) * 255 / maxValue);
+            }
+            samples = row;
+        }
+
+        if( channels == 3 )
+            memcpy( dst, samples, rowOut );
+        else
+            PixelConvert::ExpandGray( samples, dst, width, 3 );
+    }
+
+    free( row );
+
+    if( m_nImageData != NULL )
+        free( m_nImageData );
+
+    m_nImageData   = rgb;
+    m_nImageWidth  = width;
+    m_nImageHeight = height;
+    m_texFormat    = GL_RGB;
+    return PPM_NO_ERROR;
+}
+
+#endif // PPM_H_INCLUDED
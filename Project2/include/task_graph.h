@@ -0,0 +1,182 @@
+//-----------------------------------------------------------------------------
+//           Name: task_graph.h
+//    Description: 의존성 그래프 작업 실행기 (시작 로딩용: 워커 풀 + GL 스레드 전용 작업)
+//-----------------------------------------------------------------------------
+// add() 로 작업과 선행 작업 번호를 등록하고 run() 한 번으로 전부 실행합니다.
+// ANY_THREAD 작업(디코딩, 파싱, 생성)은 워커 풀에서 병렬로, MAIN_THREAD 작업(GL 업로드)은
+// run() 을 부른 스레드에서 등록 순서대로 하나씩 실행되므로 GL 컨텍스트를 따로 넘길 필요 없음.
+// 선행 작업이 모두 끝난 작업만 시작하고, 실패는 작업 안에서 처리 (뒤 작업은 결과를 보고 판단).
+// 작업마다 시작 시각과 걸린 시간을 기록해서 시작 시간 분석에 씁니다.
+
+#ifndef TASK_GRAPH_H_INCLUDED
+#define TASK_GRAPH_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <initializer_list>
+
+class TaskGraph
+{
+public:
+    enum Affinity { ANY_THREAD, MAIN_THREAD };
+
+    struct Timing
+    {
+        std::string name;
+        bool mainThread;
+        double startMs;     // run() 시작 기준
+        double ms;
+    };
+
+    TaskGraph() : m_wallMs(0.0) {}
+
+    // deps: 먼저 끝나야 하는 작업 번호 (add 가 돌려준 값). 반환: 이 작업 번호
+    int add(const char* name, std::function<void()> func, Affinity affinity = ANY_THREAD, std::initializer_list<int> deps = {})
+    {
+        Task t;
+        t.name = name;
+        t.func = func;
+        t.affinity = affinity;
+        t.waiting = 0;
+        t.startMs = t.ms = 0.0;
+        int id = (int)m_tasks.size();
+        for (int d : deps)
+        {
+            if (d < 0 || d >= id) continue;
+            m_tasks[d].dependents.push_back(id);
+            t.waiting++;
+        }
+        m_tasks.push_back(t);
+        return id;
+    }
+
+    // threads: 워커 수 (0 이하면 코어 수, 최소 2: 호출 스레드는 대부분 기다리므로 코어를 따로 떼지 않음)
+    // 모든 작업이 끝나면 반환
+    void run(int threads = 0)
+    {
+        if (threads <= 0)
+        {
+            threads = (int)std::thread::hardware_concurrency();
+            if (threads < 2) threads = 2;
+        }
+
+        m_start = std::chrono::steady_clock::now();
+        m_remaining = (int)m_tasks.size();
+        for (int i = 0; i < (int)m_tasks.size(); i++)
+            if (m_tasks[i].waiting == 0) m_ready[m_tasks[i].affinity].push_back(i);
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < threads; i++) workers.push_back(std::thread(&TaskGraph::workerLoop, this));
+
+        for (;;)
+        {
+            int id;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cond.wait(lock, [this] { return m_remaining == 0 || !m_ready[MAIN_THREAD].empty(); });
+                if (m_ready[MAIN_THREAD].empty()) break;
+                id = popFirst(m_ready[MAIN_THREAD]);
+            }
+            execute(id);
+        }
+        m_cond.notify_all();
+        for (auto& t : workers) t.join();
+        m_wallMs = elapsedMs();
+    }
+
+    // 작업별 기록 (등록 순서)
+    std::vector<Timing> timings() const
+    {
+        std::vector<Timing> out;
+        for (auto& t : m_tasks)
+        {
+            Timing timing = { t.name, t.affinity == MAIN_THREAD, t.startMs, t.ms };
+            out.push_back(timing);
+        }
+        return out;
+    }
+
+    double wallMs() const { return m_wallMs; }
+
+    // 모든 작업 시간의 합 (wallMs 와의 비율이 병렬화 정도)
+    double busyMs() const
+    {
+        double sum = 0.0;
+        for (auto& t : m_tasks) sum += t.ms;
+        return sum;
+    }
+
+private:
+    struct Task
+    {
+        std::string name;
+        std::function<void()> func;
+        Affinity affinity;
+        int waiting;                // 아직 끝나지 않은 선행 작업 수
+        std::vector<int> dependents;
+        double startMs, ms;
+    };
+
+    // 등록 순서가 빠른 작업부터 (MAIN_THREAD 작업의 업로드 순서를 원래 코드와 같게)
+    static int popFirst(std::deque<int>& ready)
+    {
+        auto first = ready.begin();
+        for (auto it = ready.begin(); it != ready.end(); ++it)
+            if (*it < *first) first = it;
+        int id = *first;
+        ready.erase(first);
+        return id;
+    }
+
+    void workerLoop()
+    {
+        for (;;)
+        {
+            int id;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cond.wait(lock, [this] { return m_remaining == 0 || !m_ready[ANY_THREAD].empty(); });
+                if (m_ready[ANY_THREAD].empty()) return;
+                id = popFirst(m_ready[ANY_THREAD]);
+            }
+            execute(id);
+        }
+    }
+
+    void execute(int id)
+    {
+        Task& t = m_tasks[id];
+        t.startMs = elapsedMs();
+        if (t.func) t.func();
+        t.ms = elapsedMs() - t.startMs;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (int d : t.dependents)
+                if (--m_tasks[d].waiting == 0) m_ready[m_tasks[d].affinity].push_back(d);
+            m_remaining--;
+        }
+        m_cond.notify_all();
+    }
+
+    double elapsedMs() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    std::vector<Task> m_tasks;
+    std::deque<int> m_ready[2];
+    int m_remaining;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::chrono::steady_clock::time_point m_start;
+    double m_wallMs;
+};
+
+#endif // TASK_GRAPH_H_INCLUDED
@@ -0,0 +1,86 @@
+//-----------------------------------------------------------------------------
+//           Name: text_parse.h
+//    Description: 매핑된 텍스트 버퍼용 숫자 파서 (PLY / ASE 로더 공용)
+//-----------------------------------------------------------------------------
+// strtod/atof 는 널 종료 문자열과 로케일을 요구하고 느리므로, [p, end) 범위를 직접 읽습니다.
+// 성공하면 p 를 숫자 바로 뒤로 옮기고 true, 숫자가 없으면 false.
+
+#ifndef TEXT_PARSE_H_INCLUDED
+#define TEXT_PARSE_H_INCLUDED
+
+#include <math.h>
+
+namespace TextParse
+{
+    inline double Pow10(int e)
+    {
+        static const double table[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        return (e <= 22) ? table[e] : pow(10.0, e);
+    }
+
+    // 빠른 10진 실수 파서: [공백][+-]digits[.digits][e[+-]digits]
+    inline bool ParseFloat(const char*& p, const char* end, double& out)
+    {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        bool neg = false;
+        if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+
+        unsigned long long mantissa = 0;
+        int exponent = 0, digits = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+        {
+            if (mantissa < 100000000000000000ULL) mantissa = mantissa * 10 + (*p - '0');
+            else exponent++;
+        }
+        if (p < end && *p == '.')
+        {
+            for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+            {
+                if (mantissa < 100000000000000000ULL) { mantissa = mantissa * 10 + (*p - '0'); exponent--; }
+            }
+        }
+        if (digits == 0) return false;
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            const char* q = p + 1;
+            bool expNeg = false;
+            if (q < end && (*q == '-' || *q == '+')) expNeg = (*q++ == '-');
+            int e = 0;
+            if (q < end && *q >= '0' && *q <= '9')
+            {
+                for (; q < end && *q >= '0' && *q <= '9'; q++) if (e < 10000) e = e * 10 + (*q - '0');
+                exponent += expNeg ? -e : e;
+                p = q;
+            }
+        }
+
+        double v = (double)mantissa;
+        if (exponent < 0) v /= Pow10(-exponent);
+        else if (exponent > 0) v *= Pow10(exponent);
+        out = neg ? -v : v;
+        return true;
+    }
+
+    inline bool ParseFloat(const char*& p, const char* end, float& out)
+    {
+        double v;
+        if (!ParseFloat(p, end, v)) return false;
+        out = (float)v;
+        return true;
+    }
+
+    // 부호 없는 정수. 끝에 붙은 ':' 는 호출자가 건너뜀 (ASE 의 "A:" 같은 라벨)
+    inline bool ParseUInt(const char*& p, const char* end, unsigned int& out)
+    {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p >= end || *p < '0' || *p > '9') return false;
+        unsigned int v = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++) v = v * 10 + (*p - '0');
+        out = v;
+        return true;
+    }
+}
+
+#endif // TEXT_PARSE_H_INCLUDED
@@ -0,0 +1,114 @@
+//-----------------------------------------------------------------------------
+//           Name: texture_cache.h
+//    Description: 오프라인 베이크된 압축 텍스처 캐시(.txc) 포맷
+//-----------------------------------------------------------------------------
+// 파일 구조: [TexCacheHeader][TexCacheLevel x mipCount][레벨 데이터 (16바이트 정렬)]
+// 레벨 데이터는 S3TC(BC1/BC3) 블록 그대로라서 glCompressedTexImage2D 에 바로 넘깁니다.
+// 캐시 파일은 원본 옆의 Cache 폴더에 "<원본 파일명>.txc" 로 저장됩니다.
+//   ../Data/Cube.bmp  ->  ../Data/Cache/Cube.bmp.txc
+
+#ifndef TEXTURE_CACHE_H_INCLUDED
+#define TEXTURE_CACHE_H_INCLUDED
+
+#include <stddef.h>
+#include <string.h>
+#include <string>
+
+#ifdef _MSC_VER
+typedef unsigned __int32 txc_uint32;
+#else
+#include <stdint.h>
+typedef uint32_t txc_uint32;
+#endif
+
+enum TexCacheFormat
+{
+    TEXCACHE_BC1 = 1,   // RGB, 8 bytes / 4x4 block
+    TEXCACHE_BC3 = 3    // RGBA, 16 bytes / 4x4 block
+};
+
+struct TexCacheHeader
+{
+    char       magic[4];    // "TXC1"
+    txc_uint32 version;
+    txc_uint32 format;      // TexCacheFormat
+    txc_uint32 width;
+    txc_uint32 height;
+    txc_uint32 mipCount;
+    txc_uint32 reserved[2];
+};
+
+struct TexCacheLevel
+{
+    txc_uint32 width;
+    txc_uint32 height;
+    txc_uint32 offset;      // 파일 시작 기준
+    txc_uint32 size;
+};
+
+const txc_uint32 TEXCACHE_VERSION = 1;
+const int TEXCACHE_MAX_MIPS = 16;
+
+// 메모리에 올라온 캐시 파일의 헤더/레벨 테이블 검증 (데이터 수명은 호출자가 보장)
+class TextureCacheFile
+{
+public:
+    TextureCacheFile() : m_pData(NULL), m_nSize(0), m_pHeader(NULL), m_pLevels(NULL) {}
+
+    bool parse(const unsigned char* data, size_t size)
+    {
+        m_pData = data;
+        m_nSize = size;
+        m_pHeader = NULL;
+        m_pLevels = NULL;
+
+        if (size < sizeof(TexCacheHeader)) return false;
+        const TexCacheHeader* h = (const TexCacheHeader*)data;
+        if (memcmp(h->magic, "TXC1", 4) != 0 || h->version != TEXCACHE_VERSION) return false;
+        if (h->format != TEXCACHE_BC1 && h->format != TEXCACHE_BC3) return false;
+        if (h->mipCount == 0 || h->mipCount > TEXCACHE_MAX_MIPS || h->width == 0 || h->height == 0) return false;
+
+        size_t tableEnd = sizeof(TexCacheHeader) + sizeof(TexCacheLevel) * h->mipCount;
+        if (tableEnd > size) return false;
+
+        const TexCacheLevel* levels = (const TexCacheLevel*)(data + sizeof(TexCacheHeader));
+        for (txc_uint32 i = 0; i < h->mipCount; i++)
+        {
+            if (levels[i].size != LevelSize(h->format, levels[i].width, levels[i].height)) return false;
+            if ((size_t)levels[i].offset + levels[i].size > size || levels[i].offset < tableEnd) return false;
+        }
+
+        m_pHeader = h;
+        m_pLevels = levels;
+        return true;
+    }
+
+    const TexCacheHeader& header() const { return *m_pHeader; }
+    const TexCacheLevel& level(int i) const { return m_pLevels[i]; }
+    const unsigned char* levelData(int i) const { return m_pData + m_pLevels[i].offset; }
+
+    // 4x4 블록 단위 크기 (1x1, 2x2 레벨도 블록 하나)
+    static txc_uint32 LevelSize(txc_uint32 format, txc_uint32 w, txc_uint32 h)
+    {
+        txc_uint32 blocks = ((w + 3) / 4) * ((h + 3) / 4);
+        return blocks * (format == TEXCACHE_BC1 ? 8 : 16);
+    }
+
+    // "../Data/Cube.bmp" -> "../Data/Cache/Cube.bmp.txc"
+    static std::string CachePathFor(const char* sourcePath)
+    {
+        std::string path = sourcePath;
+        size_t slash = path.find_last_of("/\\");
+        std::string dir = (slash == std::string::npos) ? "" : path.substr(0, slash + 1);
+        std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+        return dir + "Cache/" + name + ".txc";
+    }
+
+private:
+    const unsigned char* m_pData;
+    size_t m_nSize;
+    const TexCacheHeader* m_pHeader;
+    const TexCacheLevel* m_pLevels;
+};
+
+#endif // TEXTURE_CACHE_H_INCLUDED
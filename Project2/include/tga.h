@@ -3,6 +3,8 @@
 #include <string.h>
 #include <windows.h>
 #include <gl/gl.h>
+#include "mapped_file.h"
+#include "pixel_convert.h"
 
 class tgaImageFile
 {
@@ -13,7 +15,8 @@ public:
         m_nImageWidth(0),
         m_nImageHeight(0),
         m_nImageBits(0),
-        m_nImageData(NULL) {}
+        m_nImageData(NULL),
+        m_pUnpacked(NULL) {}
 
     ~tgaImageFile(void);
 
@@ -21,13 +24,13 @@ public:
     {
         TGA_NO_ERROR = 1,   // No error
         TGA_FILE_NOT_FOUND, // File was not found 
-        TGA_BAD_IMAGE_TYPE, // Color mapped image or image is not uncompressed
-        TGA_BAD_DIMENSION,  // Dimension is not a power of 2 
+        TGA_BAD_IMAGE_TYPE, // Color mapped image (uncompressed and RLE true-color/gray are supported)
+        TGA_BAD_DIMENSION,  // Dimension is zero or unreasonably large
         TGA_BAD_BITS,       // Image bits is not 8, 24 or 32 
         TGA_BAD_DATA        // Image data could not be loaded 
 	};
 
-    tgaImageFile::TGALoadError load( char *name );
+    TGALoadError load( const char *name );
 
     GLenum m_texFormat;
     int    m_nImageWidth;
@@ -38,10 +41,12 @@ public:
 private:
 
     bool checkSize(int x);
-    int returnError(FILE *s, int error);
-    unsigned char *getRGBA(FILE *s, int size);
-    unsigned char *getRGB(FILE *s, int size);
-    unsigned char *getGray(FILE *s, int size);
+    const unsigned char *unpackRLE(const unsigned char *src, size_t avail, int size, int bytesPerPixel);
+    unsigned char *getRGBA(const unsigned char *src, size_t avail, int size, bool rle);
+    unsigned char *getRGB(const unsigned char *src, size_t avail, int size, bool rle);
+    unsigned char *getGray(const unsigned char *src, size_t avail, int size, bool rle);
+
+    unsigned char *m_pUnpacked;  // RLE decode scratch, freed after load
 };
 
 tgaImageFile::~tgaImageFile( void )
@@ -55,161 +60,158 @@ tgaImageFile::~tgaImageFile( void )
 
 bool tgaImageFile::checkSize( int x )
 {
-    // Make sure its a power of 2.
-    if( x == 2	 || x == 4   || 
-        x == 8	 || x == 16  || 
-        x == 32  || x == 64  ||
-        x == 128 || x == 256 || 
-        x == 512 )
-        return true;
-
-    return false;
+    // Any size is fine now (GL 2.0+ handles non power of 2 textures),
+    // just reject empty or absurd dimensions from a corrupt header.
+    return x > 0 && x <= 16384;
 }
 
-int tgaImageFile::returnError( FILE *s, int error )
+const unsigned char *tgaImageFile::unpackRLE( const unsigned char *src, size_t avail, int size, int bytesPerPixel )
 {
-    // Called when there is an error loading the .tga texture file.
-    fclose( s );
-    return error;
+    // Expand RLE packets (still in file channel order) into the scratch buffer.
+    m_pUnpacked = (unsigned char *)malloc( (size_t)size * bytesPerPixel );
+
+    if( m_pUnpacked == NULL ||
+        PixelConvert::DecodeRLE( src, avail, m_pUnpacked, size, bytesPerPixel ) == 0 )
+        return 0;
+
+    return m_pUnpacked;
 }
 
-unsigned char *tgaImageFile::getRGBA( FILE *s, int size )
+unsigned char *tgaImageFile::getRGBA( const unsigned char *src, size_t avail, int size, bool rle )
 {
     // Read in RGBA data for a 32bit image. 
-    unsigned char *rgba;
-    unsigned char temp;
-    int bread;
-    int i;
-
-    rgba = (unsigned char *)malloc( size * 4 );
-
-    if( rgba == NULL )
+    if( rle )
+        src = unpackRLE( src, avail, size, 4 );
+    else if( avail < (size_t)size * 4 )
         return 0;
 
-    bread = fread( rgba, sizeof (unsigned char), size * 4, s ); 
+    unsigned char *rgba = (unsigned char *)malloc( (size_t)size * 4 );
 
-    // TGA is stored in BGRA, make it RGBA  
-    if( bread != size * 4 )
+    if( src == NULL || rgba == NULL )
     {
         free( rgba );
         return 0;
     }
 
-    for( i = 0; i < size * 4; i += 4 )
-    {
-        temp = rgba[i];
-        rgba[i] = rgba[i + 2];
-        rgba[i + 2] = temp;
-    }
+    // TGA is stored in BGRA, make it RGBA (straight from the mapped file)
+    PixelConvert::SwapRB32( src, rgba, size );
 
     m_texFormat = GL_RGBA;
     return rgba;
 }
 
-unsigned char *tgaImageFile::getRGB( FILE *s, int size )
+unsigned char *tgaImageFile::getRGB( const unsigned char *src, size_t avail, int size, bool rle )
 {
     // Read in RGB data for a 24bit image. 
-    unsigned char *rgb;
-    unsigned char temp;
-    int bread;
-    int i;
-
-    rgb = (unsigned char*)malloc( size * 3 );
-
-    if( rgb == NULL )
+    if( rle )
+        src = unpackRLE( src, avail, size, 3 );
+    else if( avail < (size_t)size * 3 )
         return 0;
 
-    bread = fread( rgb, sizeof (unsigned char), size * 3, s );
+    unsigned char *rgb = (unsigned char *)malloc( (size_t)size * 3 );
 
-    if(bread != size * 3)
+    if( src == NULL || rgb == NULL )
     {
         free( rgb );
         return 0;
     }
 
     // TGA is stored in BGR, make it RGB  
-    for( i = 0; i < size * 3; i += 3 )
-    {
-        temp = rgb[i];
-        rgb[i] = rgb[i + 2];
-        rgb[i + 2] = temp;
-    }
+    PixelConvert::SwapRB24( src, rgb, size );
 
     m_texFormat = GL_RGB;
-
     return rgb;
 }
 
-unsigned char *tgaImageFile::getGray( FILE *s, int size )
+unsigned char *tgaImageFile::getGray( const unsigned char *src, size_t avail, int size, bool rle )
 {
     // Gets the grayscale image data.  Used as an alpha channel.
-    unsigned char *grayData;
-    int bread;
-
-    grayData = (unsigned char*)malloc( size );
+    unsigned char *grayData = (unsigned char *)malloc( size );
 
     if( grayData == NULL )
         return 0;
 
-    bread = fread( grayData, sizeof (unsigned char), size, s );
-
-    if( bread != size )
+    if( rle ? PixelConvert::DecodeRLE( src, avail, grayData, size, 1 ) == 0 : avail < (size_t)size )
     {
         free( grayData );
         return 0;
     }
 
+    if( !rle )
+        memcpy( grayData, src, size );
+
     m_texFormat = GL_ALPHA;
 
     return grayData;
 }
 
-tgaImageFile::TGALoadError tgaImageFile::load( char *name )
+tgaImageFile::TGALoadError tgaImageFile::load( const char *name )
 {
-    // Loads up a targa file. Supported types are 8, 24 and 32 
-    // uncompressed images.
-    unsigned char type[4];
-    unsigned char info[7];
-    FILE *s = NULL;
+    // Loads up a targa file. Supported types are 8, 24 and 32 bit,
+    // uncompressed (2, 3) or run-length encoded (10, 11) images.
+    MappedFile file;
     int size = 0;
     
-    if( !(s = fopen( name, "rb" )) )
+    if( !file.open( name ) )
         return TGA_FILE_NOT_FOUND;
 
-    fread( &type, sizeof (char), 3, s );   // Read in colormap info and image type, byte 0 ignored
-    fseek( s, 12, SEEK_SET);			   // Seek past the header and useless info
-    fread( &info, sizeof (char), 6, s );
+    if( file.size() < 18 )
+        return TGA_BAD_DATA;
 
-    if( type[1] != 0 || (type[2] != 2 && type[2] != 3) )
-        returnError( s, TGA_BAD_IMAGE_TYPE );
+    const unsigned char *header = file.data();
+    int idLength      = header[0];
+    int colorMapType  = header[1];
+    int imageType     = header[2];
+    int colorMapBytes = (header[5] + header[6] * 256) * ((header[7] + 7) / 8);
+    int descriptor    = header[17];
 
-    m_nImageWidth  = info[0] + info[1] * 256; 
-    m_nImageHeight = info[2] + info[3] * 256;
-    m_nImageBits   = info[4]; 
+    if( colorMapType != 0 ||
+        (imageType != 2 && imageType != 3 && imageType != 10 && imageType != 11) )
+        return TGA_BAD_IMAGE_TYPE;
+
+    bool rle = (imageType == 10 || imageType == 11);
+
+    m_nImageWidth  = header[12] + header[13] * 256; 
+    m_nImageHeight = header[14] + header[15] * 256;
+    m_nImageBits   = header[16]; 
 
     size = m_nImageWidth * m_nImageHeight;
 
-    // Make sure dimension is a power of 2  
     if( !checkSize(m_nImageWidth) || !checkSize(m_nImageHeight))
-        returnError( s, TGA_BAD_DIMENSION);
+        return TGA_BAD_DIMENSION;
 
     // Make sure we are loading a supported type  
     if( m_nImageBits != 32 && m_nImageBits != 24 && m_nImageBits != 8 )
-        returnError( s, TGA_BAD_BITS );
+        return TGA_BAD_BITS;
+
+    // Skip the image ID field and any (unused) color map data
+    size_t offset = 18 + idLength + colorMapBytes;
+    if( offset > file.size() )
+        return TGA_BAD_DATA;
+
+    const unsigned char *src = header + offset;
+    size_t avail = file.size() - offset;
+
+    if( m_nImageData != NULL )
+        free( m_nImageData );
 
     if( m_nImageBits == 32 )
-        m_nImageData = getRGBA( s, size );
+        m_nImageData = getRGBA( src, avail, size, rle );
     else if( m_nImageBits == 24 )
-        m_nImageData = getRGB( s, size );	
+        m_nImageData = getRGB( src, avail, size, rle );	
     else if( m_nImageBits == 8 )
-        m_nImageData = getGray( s, size );
+        m_nImageData = getGray( src, avail, size, rle );
+
+    free( m_pUnpacked );
+    m_pUnpacked = NULL;
 
     // No image data 
     if( m_nImageData == NULL )
-        returnError( s, TGA_BAD_DATA );
+        return TGA_BAD_DATA;
 
-    fclose( s );
+    // Top-left origin (descriptor bit 5) -> flip to OpenGL's bottom-left
+    if( descriptor & 0x20 )
+        PixelConvert::FlipRows( m_nImageData, (size_t)m_nImageWidth * (m_nImageBits / 8), m_nImageHeight );
 
     return TGA_NO_ERROR;
 }
-
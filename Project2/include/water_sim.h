@@ -0,0 +1,448 @@
+//-----------------------------------------------------------------------------
+//           Name: water_sim.h
+//    Description: 높이장 물결 시뮬레이션 (Water.ini 설정, SSE2 / AVX 스텐실, 행 띠 멀티스레드)
+//-----------------------------------------------------------------------------
+// 버퍼 두 개(현재 / 이전)를 번갈아 쓰는 고전적인 물결 식:
+//   next[r][c] = ((cur[r][c-1] + cur[r][c+1] + cur[r-1][c] + cur[r+1][c]) / 2 - prev[r][c]) * damping
+// next 는 prev 자리에 덮어쓰고(같은 칸만 읽으므로 안전) 두 버퍼를 바꿉니다. 테두리는 0 고정.
+// 배치는 SoA: 높이 평면 2개와 법선 평면(nx, nz) 2개, 행 간격(stride)은 8 의 배수.
+//
+// 행마다 최대 |높이| 를 기록해서, 자기와 이웃 행이 모두 잠잠하면(임계값 이하) 계산하지 않고
+// 0 으로 둡니다. 법선도 이번 단계에 높이가 바뀐 행 근처만 다시 계산하고, 바뀐 행 구간은
+// dirtyBegin/End 에 모아 두어 렌더러가 그 구간만 VBO 로 올리고 clearDirty() 하게 합니다.
+// 행 구간은 스레드 수만큼 띠로 나눠 병렬 처리 (스텐실 단계 -> 법선 단계, 단계마다 합류).
+//
+// Water.ini 형식: "[KEY]" 다음 줄에 값, "//" 주석
+//   GRIDX/GRIDZ 격자 크기, BLEND 0/1/2 투명도, POWER 물방울 세기, DENSITY 감쇠,
+//   FREQUENCY 물방울 빈도 1~10, RAGGIO 물방울 반지름(칸)
+
+#ifndef WATER_SIM_H_INCLUDED
+#define WATER_SIM_H_INCLUDED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "cpu_features.h"
+
+struct WaterConfig
+{
+    int gridX, gridZ;
+    int blend;          // 0: 많이 투명, 1: 30% 투명, 2: 불투명
+    float power;
+    float density;
+    int frequency;
+    int radius;
+
+    WaterConfig() : gridX(151), gridZ(151), blend(1), power(1.0f), density(0.02f), frequency(1), radius(2) {}
+
+    // 없는 키는 기본값 유지. 파일이 없으면 false
+    bool load(const char* path)
+    {
+        FILE* fp = fopen(path, "r");
+        if (!fp) return false;
+
+        char line[256], key[64] = "";
+        while (fgets(line, sizeof(line), fp))
+        {
+            char* p = line;
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == '\0' || *p == '\r' || *p == '\n' || (p[0] == '/' && p[1] == '/')) continue;
+            if (*p == '[')
+            {
+                char* close = strchr(p, ']');
+                size_t n = close ? (size_t)(close - p - 1) : 0;
+                if (n >= sizeof(key)) n = sizeof(key) - 1;
+                memcpy(key, p + 1, n);
+                key[n] = '\0';
+                continue;
+            }
+
+            double v = atof(p);
+            if (!strcmp(key, "GRIDX")) gridX = (int)v;
+            else if (!strcmp(key, "GRIDZ")) gridZ = (int)v;
+            else if (!strcmp(key, "BLEND")) blend = (int)v;
+            else if (!strcmp(key, "POWER")) power = (float)v;
+            else if (!strcmp(key, "DENSITY")) density = (float)v;
+            else if (!strcmp(key, "FREQUENCY")) frequency = (int)v;
+            else if (!strcmp(key, "RAGGIO")) radius = (int)v;
+            key[0] = '\0';
+        }
+        fclose(fp);
+
+        // 원래 프로그램은 256 까지, 여기서는 1024 까지 허용
+        gridX = (gridX < 3) ? 3 : (gridX > 1024 ? 1024 : gridX);
+        gridZ = (gridZ < 3) ? 3 : (gridZ > 1024 ? 1024 : gridZ);
+        blend = (blend < 0) ? 0 : (blend > 2 ? 2 : blend);
+        density = (density < 0.0f) ? 0.0f : (density > 0.5f ? 0.5f : density);
+        frequency = (frequency < 1) ? 1 : (frequency > 10 ? 10 : frequency);
+        if (radius < 1) radius = 1;
+        return true;
+    }
+};
+
+namespace WaterKernel
+{
+
+// 한 행의 [begin, end) 칸. 처리한 끝 위치를 반환하고 rowMax 에 최대 |next| 를 합침
+inline size_t StepRowScalar(const float* up, const float* cur, const float* down, float* prev,
+                            size_t begin, size_t end, float damping, float& rowMax)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        float v = ((cur[i - 1] + cur[i + 1] + up[i] + down[i]) * 0.5f - prev[i]) * damping;
+        prev[i] = v;
+        float a = fabsf(v);
+        if (a > rowMax) rowMax = a;
+    }
+    return end;
+}
+
+#if CPU_X86
+// 4 칸씩
+SIMD_TARGET_SSE2 inline size_t StepRowSSE2(const float* up, const float* cur, const float* down, float* prev,
+                                           size_t begin, size_t end, float damping, float& rowMax)
+{
+    const __m128 half = _mm_set1_ps(0.5f), d = _mm_set1_ps(damping);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 m = _mm_setzero_ps();
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 s = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(cur + i - 1), _mm_loadu_ps(cur + i + 1)),
+                              _mm_add_ps(_mm_loadu_ps(up + i), _mm_loadu_ps(down + i)));
+        __m128 v = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(s, half), _mm_loadu_ps(prev + i)), d);
+        _mm_storeu_ps(prev + i, v);
+        m = _mm_max_ps(m, _mm_and_ps(v, absMask));
+    }
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    float a = _mm_cvtss_f32(m);
+    if (a > rowMax) rowMax = a;
+    return i;
+}
+
+// 8 칸씩, 두 묶음을 겹쳐 로드 지연을 숨김
+SIMD_TARGET_AVX2 inline size_t StepRowAVX(const float* up, const float* cur, const float* down, float* prev,
+                                          size_t begin, size_t end, float damping, float& rowMax)
+{
+    const __m256 half = _mm256_set1_ps(0.5f), d = _mm256_set1_ps(damping);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 m0 = _mm256_setzero_ps(), m1 = _mm256_setzero_ps();
+    size_t i = begin;
+    for (; i + 16 <= end; i += 16)
+    {
+        __m256 s0 = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(cur + i - 1), _mm256_loadu_ps(cur + i + 1)),
+                                  _mm256_add_ps(_mm256_loadu_ps(up + i), _mm256_loadu_ps(down + i)));
+        __m256 s1 = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(cur + i + 7), _mm256_loadu_ps(cur + i + 9)),
+                                  _mm256_add_ps(_mm256_loadu_ps(up + i + 8), _mm256_loadu_ps(down + i + 8)));
+        __m256 v0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(s0, half), _mm256_loadu_ps(prev + i)), d);
+        __m256 v1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(s1, half), _mm256_loadu_ps(prev + i + 8)), d);
+        _mm256_storeu_ps(prev + i, v0);
+        _mm256_storeu_ps(prev + i + 8, v1);
+        m0 = _mm256_max_ps(m0, _mm256_and_ps(v0, absMask));
+        m1 = _mm256_max_ps(m1, _mm256_and_ps(v1, absMask));
+    }
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 s = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(cur + i - 1), _mm256_loadu_ps(cur + i + 1)),
+                                 _mm256_add_ps(_mm256_loadu_ps(up + i), _mm256_loadu_ps(down + i)));
+        __m256 v = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(s, half), _mm256_loadu_ps(prev + i)), d);
+        _mm256_storeu_ps(prev + i, v);
+        m0 = _mm256_max_ps(m0, _mm256_and_ps(v, absMask));
+    }
+    __m256 m = _mm256_max_ps(m0, m1);
+    __m128 h = _mm_max_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+    h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_max_ss(h, _mm_shuffle_ps(h, h, 1));
+    float a = _mm_cvtss_f32(h);
+    if (a > rowMax) rowMax = a;
+    return i;
+}
+#endif
+
+// 공개 함수: 커널이 끝낸 뒤 남은 칸은 스칼라로. 반환값은 행의 최대 |next|
+inline float StepRow(const float* up, const float* cur, const float* down, float* prev, size_t begin, size_t end, float damping)
+{
+    float rowMax = 0.0f;
+    size_t done = begin;
+#if CPU_X86
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx2) done = StepRowAVX(up, cur, down, prev, begin, end, damping, rowMax);
+    else if (cpu.sse2) done = StepRowSSE2(up, cur, down, prev, begin, end, damping, rowMax);
+#endif
+    StepRowScalar(up, cur, down, prev, done, end, damping, rowMax);
+    return rowMax;
+}
+
+} // namespace WaterKernel
+
+class WaterSim
+{
+public:
+    WaterSim() : m_gx(0), m_gz(0), m_stride(0), m_cur(0), m_damping(0.98f), m_threads(1),
+                 m_dirtyBegin(0), m_dirtyEnd(0), m_cellsUpdated(0), m_forceScalar(false),
+                 m_jobBegin(0), m_jobEnd(0), m_jobBands(0), m_jobGeneration(0), m_jobsLeft(0), m_quit(false) {}
+
+    ~WaterSim() { StopWorkers(); }
+
+    // threads: 행 띠 수 (0 = 하드웨어 스레드 수). 1 이면 작업 스레드 없음
+    void Init(int gridX, int gridZ, float damping, int threads = 1)
+    {
+        StopWorkers();
+        m_gx = gridX;
+        m_gz = gridZ;
+        m_stride = ((size_t)gridX + 7) & ~(size_t)7;
+        m_damping = damping;
+        m_cur = 0;
+        size_t n = m_stride * gridZ;
+        for (int b = 0; b < 2; b++)
+        {
+            m_height[b].assign(n, 0.0f);
+            m_rowMax[b].assign(gridZ, 0.0f);
+        }
+        m_nx.assign(n, 0.0f);
+        m_nz.assign(n, 0.0f);
+        m_stepped.assign(gridZ, 0);
+        m_dirtyBegin = 0;
+        m_dirtyEnd = gridZ;
+
+        if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+        m_threads = (threads < 1) ? 1 : threads;
+        for (int i = 1; i < m_threads; i++) m_workers.push_back(std::thread(&WaterSim::WorkerLoop, this, i));
+    }
+
+    int gridX() const { return m_gx; }
+    int gridZ() const { return m_gz; }
+    size_t stride() const { return m_stride; }
+    int threadCount() const { return m_threads; }
+
+    // SoA 평면 (stride x gridZ). 법선 = normalize(nx, 2 * 칸 크기, nz)
+    const float* heights() const { return m_height[m_cur].data(); }
+    const float* normalX() const { return m_nx.data(); }
+    const float* normalZ() const { return m_nz.data(); }
+
+    // clearDirty() 이후 Step 들에서 높이/법선이 바뀐 행 [begin, end). 비어 있으면 begin == end
+    int dirtyBegin() const { return m_dirtyBegin; }
+    int dirtyEnd() const { return m_dirtyEnd; }
+    void clearDirty() { m_dirtyBegin = m_dirtyEnd = 0; }
+
+    // 마지막 Step 에서 스텐실을 계산한 칸 수 (잠잠한 행은 제외)
+    size_t cellsUpdated() const { return m_cellsUpdated; }
+
+    // 벤치마크용: SIMD 를 끄고 스칼라 커널만
+    void setForceScalar(bool on) { m_forceScalar = on; }
+
+    // 격자 좌표 (cx, cz) 에 코사인 모양 물방울. 테두리는 건드리지 않음
+    void Drop(float cx, float cz, float radius, float power)
+    {
+        int r0 = (int)floorf(cz - radius), r1 = (int)ceilf(cz + radius);
+        int c0 = (int)floorf(cx - radius), c1 = (int)ceilf(cx + radius);
+        if (r0 < 1) r0 = 1;
+        if (c0 < 1) c0 = 1;
+        if (r1 > m_gz - 2) r1 = m_gz - 2;
+        if (c1 > m_gx - 2) c1 = m_gx - 2;
+
+        float* h = m_height[m_cur].data();
+        for (int r = r0; r <= r1; r++)
+        {
+            for (int c = c0; c <= c1; c++)
+            {
+                float d = sqrtf((c - cx) * (c - cx) + (r - cz) * (r - cz)) / radius;
+                if (d >= 1.0f) continue;
+                float& v = h[r * m_stride + c];
+                v -= power * 0.5f * (cosf(d * 3.14159265f) + 1.0f);
+                if (fabsf(v) > m_rowMax[m_cur][r]) m_rowMax[m_cur][r] = fabsf(v);
+            }
+        }
+    }
+
+    void Step()
+    {
+        const std::vector<float>& curMax = m_rowMax[m_cur];
+        const std::vector<float>& nextMax = m_rowMax[1 - m_cur];
+
+        // 계산할 행 구간: 자기/이웃의 현재 값이나 자기의 이전 값이 살아 있는 행
+        int first = m_gz, last = -1;
+        for (int r = 1; r < m_gz - 1; r++)
+        {
+            bool active = curMax[r - 1] > QUIET || curMax[r] > QUIET || curMax[r + 1] > QUIET || nextMax[r] > QUIET;
+            m_stepped[r] = active;
+            if (active)
+            {
+                if (r < first) first = r;
+                last = r;
+            }
+        }
+        m_cellsUpdated = 0;
+        if (last < 0) return;
+
+        RunBands(first, last + 1, [this](int r0, int r1) { StepRows(r0, r1); });
+        for (int r = first; r <= last; r++)
+            if (m_stepped[r]) m_cellsUpdated += m_gx - 2;
+        m_cur = 1 - m_cur;
+
+        // 높이가 바뀐 행의 위아래까지 법선이 바뀜
+        int nb = (first > 1) ? first - 1 : 1;
+        int ne = (last + 2 < m_gz - 1) ? last + 2 : m_gz - 1;
+        RunBands(nb, ne, [this](int r0, int r1) { NormalRows(r0, r1); });
+        if (m_dirtyBegin == m_dirtyEnd)
+        {
+            m_dirtyBegin = nb;
+            m_dirtyEnd = ne;
+        }
+        else
+        {
+            if (nb < m_dirtyBegin) m_dirtyBegin = nb;
+            if (ne > m_dirtyEnd) m_dirtyEnd = ne;
+        }
+    }
+
+private:
+    // 이 값보다 작은 물결은 0 으로 정리 (완전히 0 이 되어야 행을 건너뛸 수 있음)
+    static constexpr float QUIET = 1e-4f;
+
+    void StepRows(int r0, int r1)
+    {
+        float* cur = m_height[m_cur].data();
+        float* next = m_height[1 - m_cur].data();
+        std::vector<float>& nextMax = m_rowMax[1 - m_cur];
+        for (int r = r0; r < r1; r++)
+        {
+            if (!m_stepped[r]) continue;
+            const float* c = cur + r * m_stride;
+            float* p = next + r * m_stride;
+            float rowMax;
+            if (m_forceScalar)
+            {
+                rowMax = 0.0f;
+                WaterKernel::StepRowScalar(c - m_stride, c, c + m_stride, p, 1, m_gx - 1, m_damping, rowMax);
+            }
+            else rowMax = WaterKernel::StepRow(c - m_stride, c, c + m_stride, p, 1, m_gx - 1, m_damping);
+
+            if (rowMax <= QUIET)
+            {
+                memset(p, 0, m_gx * sizeof(float));
+                rowMax = 0.0f;
+            }
+            nextMax[r] = rowMax;
+        }
+    }
+
+    // 중앙 차분: nx = h[c-1] - h[c+1], nz = h[r-1] - h[r+1] (y 성분은 셰이더가 칸 크기로)
+    void NormalRows(int r0, int r1)
+    {
+        const float* h = m_height[m_cur].data();
+        for (int r = r0; r < r1; r++)
+        {
+            const float* c = h + r * m_stride;
+            const float* up = c - m_stride;
+            const float* down = c + m_stride;
+            float* nx = &m_nx[r * m_stride];
+            float* nz = &m_nz[r * m_stride];
+            for (int i = 1; i < m_gx - 1; i++)
+            {
+                nx[i] = c[i - 1] - c[i + 1];
+                nz[i] = up[i] - down[i];
+            }
+        }
+    }
+
+    // [begin, end) 행을 띠로 나눠 작업 스레드와 함께 처리. 띠가 너무 작으면(깨우는 비용 > 계산) 혼자
+    void RunBands(int begin, int end, std::function<void(int, int)> func)
+    {
+        int rows = end - begin;
+        int bands = m_threads;
+        int maxBands = (int)((size_t)rows * m_gx / MIN_BAND_CELLS);
+        if (bands > maxBands) bands = maxBands;
+        if (bands <= 1)
+        {
+            func(begin, end);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = func;
+            m_jobBegin = begin;
+            m_jobEnd = end;
+            m_jobBands = bands;
+            m_jobsLeft = bands - 1;
+            m_jobGeneration++;
+        }
+        m_wake.notify_all();
+        func(begin, begin + rows / bands);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_jobsLeft == 0; });
+    }
+
+    void WorkerLoop(int index)
+    {
+        unsigned int seen = 0;
+        for (;;)
+        {
+            std::function<void(int, int)> job;
+            int r0 = 0, r1 = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_quit || m_jobGeneration != seen; });
+                if (m_quit) return;
+                seen = m_jobGeneration;
+                if (index >= m_jobBands) continue;
+                job = m_job;
+                int rows = m_jobEnd - m_jobBegin;
+                r0 = m_jobBegin + rows * index / m_jobBands;
+                r1 = m_jobBegin + rows * (index + 1) / m_jobBands;
+            }
+            job(r0, r1);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_jobsLeft == 0) m_done.notify_one();
+            }
+        }
+    }
+
+    void StopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_workers) t.join();
+        m_workers.clear();
+        m_quit = false;
+    }
+
+    enum { MIN_BAND_CELLS = 32768 };
+
+    int m_gx, m_gz;
+    size_t m_stride;
+    int m_cur;
+    float m_damping;
+    int m_threads;
+    std::vector<float> m_height[2];
+    std::vector<float> m_rowMax[2];
+    std::vector<float> m_nx, m_nz;
+    std::vector<unsigned char> m_stepped;
+    int m_dirtyBegin, m_dirtyEnd;
+    size_t m_cellsUpdated;
+    bool m_forceScalar;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake, m_done;
+    std::function<void(int, int)> m_job;
+    int m_jobBegin, m_jobEnd, m_jobBands;
+    unsigned int m_jobGeneration;
+    int m_jobsLeft;
+    bool m_quit;
+};
+
+#endif // WATER_SIM_H_INCLUDED
@@ -10,9 +10,42 @@
 #include <algorithm>
 #include <fstream>
 #include <deque>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <math.h>
+#include <string.h>
 #include <time.h>
+#include <sys/stat.h>
+
+#include "include/bmp_view.h"
+#include "include/tga.h"
+#include "include/ppm.h"
+#include "include/texture_cache.h"
+#include "include/ply_loader.h"
+#include "include/mesh_cache.h"
+#include "include/ase_loader.h"
+#include "include/max3ds_loader.h"
+#include "include/morph_targets.h"
+#include "include/heightfield.h"
+#include "include/water_sim.h"
+#include "include/jpeg_decoder.h"
+#include "include/asset_pack.h"
+#include "include/task_graph.h"
+#include "include/frustum_cull.h"
+#include "include/portal_cells.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
 
 // -------------------------------------------------------
 // [전역 설정]
@@ -26,13 +59,14 @@ struct particleData {
     float color[3];
 };
 
+// 파편은 생성 시점 값만 저장 (현재 위치/회전은 DebrisField 가 경과 틱으로 계산)
 struct debrisData {
-    float position[3];
-    float speed[3];
-    float orientation[3];
-    float orientationSpeed[3];
+    float position[3];          // 생성 위치
+    float speed[3];             // 틱당 0.1 배씩 이동
+    float orientationSpeed[3];  // 틱당 10 배 (도) 씩 x, y, z 회전
     float color[3];
     float scale[3];
+    float spawnTick;            // 생성될 때의 DebrisField::Clock()
 };
 
 using namespace std;
@@ -74,29 +108,281 @@ vec3 endCamUp(0.0f, 0.0f, -1.0f);         // 목표 Up 벡터
 GLuint skyTextureID; // 스카이박스 텍스처 ID 저장
 
 // -------------------------------------------------------
-// [BMP 로더 함수]
+// [에셋 팩] ../Data/Assets.pak (AssetPacker 로 생성) 이 있으면 매핑 로드를 전부 팩에서
+// -------------------------------------------------------
+AssetPack assetPack;
+
+// 팩에 있으면 파일 시스템을 보지 않음. 팩을 만든 뒤 추가된 파일은 stat 으로
+bool AssetExists(const char* path) {
+    if (AssetPack::Mounted() && AssetPack::Mounted()->contains(path)) return true;
+    struct stat st;
+    return stat(path, &st) == 0;
+}
+
+// -------------------------------------------------------
+// [BMP / TGA / PPM 로더 함수]
 // -------------------------------------------------------
+// CPU 쪽에서 픽셀이 필요한 경우용: 빈틈없는 bottom-up RGB 버퍼를 반환 (delete[] 필요)
 unsigned char* LoadBMP(const char* filename, int* width, int* height) {
-    FILE* file = fopen(filename, "rb");
-    if (!file) return NULL;
-    unsigned char header[54];
-    if (fread(header, 1, 54, file) != 54) { fclose(file); return NULL; }
-    *width = *(int*)&(header[0x12]);
-    *height = *(int*)&(header[0x16]);
-    int imageSize = *(int*)&(header[0x22]);
-    if (imageSize == 0) imageSize = (*width) * (*height) * 3;
-    unsigned char* data = new unsigned char[imageSize];
-    fread(data, 1, imageSize, file);
-    fclose(file);
-    for (int i = 0; i < imageSize - 2; i += 3) {
-        unsigned char temp = data[i]; data[i] = data[i + 2]; data[i + 2] = temp;
-    }
-    return data;
+    BmpView bmp;
+    if (bmp.open(filename) != BmpView::BMP_NO_ERROR) return NULL;
+    *width = bmp.width();
+    *height = bmp.height();
+    return bmp.decodeRGB();
+}
+
+// 텍스처 한 장 분량의 디코딩 결과
+// BMP 는 매핑된 파일 레이아웃 그대로(GL_BGR/GL_BGRA), TGA/PPM 은 SIMD 변환된 RGB(A) 버퍼
+// 면 아틀라스에서 레이어 칸 위/아래 여백 = 레이어 높이 / ATLAS_GUTTER_DIV
+// (높이를 이 값의 배수로 맞춰두므로 UV 계산에 실제 텍스처 크기가 필요 없음)
+const int ATLAS_GUTTER_DIV = 16;
+
+// 아틀라스 레이어 layer(0..layerCount-1) 안의 v(0..1) -> 전체 텍스처 v
+inline float AtlasLayerV(int layer, int layerCount, float v) {
+    return (layer + (1.0f + v * ATLAS_GUTTER_DIV) / (ATLAS_GUTTER_DIV + 2)) / layerCount;
 }
-GLuint LoadTexture(const char* filename) {
-    int w, h;
-    unsigned char* data = LoadBMP(filename, &w, &h);
-    if (!data) {
+
+class TextureImage {
+public:
+    TextureImage() : isBMP(false), isCompressed(false), width(0), height(0), format(GL_RGB), stride(0), compressedBytes(0), data(NULL, free) {}
+
+    bool Load(const char* filename, bool allowCache = true) {
+        if (allowCache && LoadCache(filename)) return true; // 베이크된 BC1/BC3 캐시 우선, 없으면 원본
+
+        string ext = GetExtension(filename);
+        if (ext == ".tga") {
+            tgaImageFile tga;
+            if (tga.load(filename) != tgaImageFile::TGA_NO_ERROR) return false;
+            return TakePixels(tga.m_nImageData, tga.m_nImageWidth, tga.m_nImageHeight, tga.m_texFormat, tga.m_nImageBits / 8);
+        }
+        if (ext == ".ppm" || ext == ".pgm") {
+            ppmImageFile ppm;
+            if (ppm.load(filename) != ppmImageFile::PPM_NO_ERROR) return false;
+            return TakePixels(ppm.m_nImageData, ppm.m_nImageWidth, ppm.m_nImageHeight, ppm.m_texFormat, 3);
+        }
+        if (ext == ".jpg" || ext == ".jpeg") {
+            unsigned char* pixels = NULL;
+            int w, h;
+            if (!LoadJpeg(filename, pixels, w, h)) return false;
+            return TakePixels(pixels, w, h, GL_RGB, 3);
+        }
+
+        if (bmp.open(filename) != BmpView::BMP_NO_ERROR) return false;
+        bmp.normalize(); // 팔레트/top-down 인 경우에만 변환
+        isBMP = true;
+        width = bmp.width();
+        height = bmp.height();
+        format = (bmp.bitsPerPixel() == 32) ? GL_BGRA : GL_BGR;
+        stride = bmp.stride();
+        return true;
+    }
+
+    // 여러 면 텍스처를 세로 띠 아틀라스 한 장으로 (레이어 i 는 아래에서 i 번째 칸)
+    // 모든 레이어는 첫 레이어 크기로 맞추고(높이는 ATLAS_GUTTER_DIV 배수), 칸 위아래에
+    // 가장자리 행을 복제한 여백을 둬서 GL_LINEAR 가 이웃 레이어를 섞지 않게 함
+    bool LoadAtlas(const vector<string>& files) {
+        if (files.empty()) return false;
+
+        vector<vector<unsigned char>> layers(files.size());
+        int w = 0, h = 0;
+        bool alpha = false;
+        for (size_t i = 0; i < files.size(); i++) {
+            int lw, lh;
+            if (!DecodeRGBA(files[i].c_str(), layers[i], lw, lh, alpha)) return false;
+            if (i == 0) {
+                w = lw;
+                h = (lh + ATLAS_GUTTER_DIV - 1) / ATLAS_GUTTER_DIV * ATLAS_GUTTER_DIV;
+            }
+            if (lw != w || lh != h) layers[i] = ResampleRGBA(layers[i], lw, lh, w, h);
+        }
+
+        int gutter = h / ATLAS_GUTTER_DIV;
+        int slot = h + 2 * gutter;
+        int channels = alpha ? 4 : 3;
+        unsigned char* atlas = (unsigned char*)malloc((size_t)w * slot * layers.size() * channels);
+        if (!atlas) return false;
+
+        unsigned char* dst = atlas;
+        for (auto& layer : layers) {
+            for (int y = 0; y < slot; y++) {
+                int sy = std::min(std::max(y - gutter, 0), h - 1);
+                const unsigned char* src = &layer[(size_t)sy * w * 4];
+                if (channels == 4) memcpy(dst, src, (size_t)w * 4);
+                else for (int x = 0; x < w; x++) memcpy(dst + x * 3, src + x * 4, 3);
+                dst += (size_t)w * channels;
+            }
+        }
+        return TakePixels(atlas, w, slot * (int)layers.size(), alpha ? GL_RGBA : GL_RGB, channels);
+    }
+
+    // pixels 는 클라이언트 메모리 주소이거나, PBO가 바인딩된 경우 버퍼 오프셋
+    // BMP 는 4바이트 행 정렬과 행 길이를 그대로 알려줘서 복사/스왑 없이 올림
+    // 압축 캐시는 레벨별 오프셋으로 전체 밉 체인을 올림
+    void TexImage(const void* pixels) const {
+        if (isCompressed) {
+            GLenum compressedFormat = (cache.header().format == TEXCACHE_BC3) ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            int levels = (int)cache.header().mipCount;
+            for (int i = 0; i < levels; i++) {
+                const TexCacheLevel& level = cache.level(i);
+                glCompressedTexImage2D(GL_TEXTURE_2D, i, compressedFormat, level.width, level.height, 0, level.size,
+                                       (const char*)pixels + level.offset);
+            }
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            return;
+        }
+
+        GLint internalFormat = format;
+        if (isBMP) internalFormat = bmp.hasAlpha() ? GL_RGBA : GL_RGB;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, isBMP ? 4 : 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    const unsigned char* Pixels() const { return isBMP ? bmp.pixels() : data.get(); }
+    size_t Bytes() const { return isCompressed ? compressedBytes : stride * height; }
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+    // GPU 에 올라간 크기 (BMP 32bit 무알파는 GL_RGB 로 저장)
+    size_t GpuBytes() const {
+        if (isCompressed) return compressedBytes - cache.level(0).offset;
+        int channels = (format == GL_RGBA || (isBMP && bmp.hasAlpha())) ? 4 : (format == GL_ALPHA ? 1 : 3);
+        return (size_t)width * height * channels;
+    }
+
+    static string GetExtension(const char* filename) {
+        const char* dot = strrchr(filename, '.');
+        string ext = dot ? dot : "";
+        for (auto& c : ext) c = (char)tolower((unsigned char)c);
+        return ext;
+    }
+
+private:
+    // ../Data/Cache/<파일명>.txc 를 한 번의 fread 로 통째로 읽음 (TextureBaker 로 생성)
+    // 캐시가 없거나, 원본보다 오래됐거나, S3TC 미지원이면 false -> 원본 로드
+    // 팩이 걸려 있으면 팩이 기준: 팩에 없으면 굽지 않은 것으로 보고 stat 도 하지 않음
+    bool LoadCache(const char* filename) {
+        if (!GLEW_EXT_texture_compression_s3tc) return false;
+
+        string path = TextureCacheFile::CachePathFor(filename);
+        size_t size = 0;
+        unsigned char* buffer = NULL;
+        bool ok = false;
+        if (AssetPack::Mounted()) {
+            const unsigned char* packed;
+            if (!AssetPack::Mounted()->find(path.c_str(), packed, size)) return false;
+            buffer = (unsigned char*)malloc(size);
+            ok = buffer != NULL;
+            if (ok) memcpy(buffer, packed, size);
+        }
+        else {
+            struct stat cacheStat, sourceStat;
+            if (stat(path.c_str(), &cacheStat) != 0) return false;
+            if (stat(filename, &sourceStat) == 0 && sourceStat.st_mtime > cacheStat.st_mtime) return false;
+
+            FILE* fp = fopen(path.c_str(), "rb");
+            if (!fp) return false;
+            size = (size_t)cacheStat.st_size;
+            buffer = (unsigned char*)malloc(size);
+            ok = buffer && fread(buffer, 1, size, fp) == size;
+            fclose(fp);
+        }
+
+        if (!ok || !cache.parse(buffer, size)) {
+            free(buffer);
+            return false;
+        }
+        data.reset(buffer);
+        isCompressed = true;
+        width = (int)cache.header().width;
+        height = (int)cache.header().height;
+        compressedBytes = size;
+        return true;
+    }
+
+    // 원본 이미지를 bottom-up RGBA8 로 (알파가 있으면 hasAlpha 를 켬)
+    static bool DecodeRGBA(const char* filename, vector<unsigned char>& rgba, int& w, int& h, bool& hasAlpha) {
+        TextureImage image;
+        if (!image.Load(filename, false)) return false;
+        w = image.width;
+        h = image.height;
+        rgba.resize((size_t)w * h * 4);
+
+        for (int y = 0; y < h; y++) {
+            unsigned char* d = &rgba[(size_t)y * w * 4];
+            if (image.isBMP) {
+                const unsigned char* s = image.bmp.row(y);
+                int bpp = image.bmp.bitsPerPixel() / 8;
+                for (int x = 0; x < w; x++, s += bpp, d += 4) {
+                    d[0] = s[2]; d[1] = s[1]; d[2] = s[0];
+                    d[3] = image.bmp.hasAlpha() ? s[3] : 255;
+                }
+                continue;
+            }
+            const unsigned char* s = image.data.get() + (size_t)y * image.stride;
+            for (int x = 0; x < w; x++, d += 4) {
+                if (image.format == GL_RGBA) memcpy(d, s + x * 4, 4);
+                else if (image.format == GL_ALPHA) { d[0] = d[1] = d[2] = 255; d[3] = s[x]; }
+                else { memcpy(d, s + x * 3, 3); d[3] = 255; }
+            }
+        }
+        if (image.format == GL_RGBA || image.format == GL_ALPHA || (image.isBMP && image.bmp.hasAlpha())) hasAlpha = true;
+        return true;
+    }
+
+    // 최근접 샘플링으로 크기 변경 (크기가 다른 레이어를 아틀라스 칸에 맞출 때만 사용)
+    static vector<unsigned char> ResampleRGBA(const vector<unsigned char>& src, int sw, int sh, int dw, int dh) {
+        vector<unsigned char> out((size_t)dw * dh * 4);
+        for (int y = 0; y < dh; y++) {
+            int sy = (int)((long long)y * sh / dh);
+            for (int x = 0; x < dw; x++) {
+                int sx = (int)((long long)x * sw / dw);
+                memcpy(&out[((size_t)y * dw + x) * 4], &src[((size_t)sy * sw + sx) * 4], 4);
+            }
+        }
+        return out;
+    }
+
+    // 풀 해상도 디코딩 -> bottom-up RGB (그레이는 RGB 로 펼침, malloc 버퍼)
+    static bool LoadJpeg(const char* filename, unsigned char*& pixels, int& w, int& h) {
+        JpegDecoder jpeg;
+        vector<unsigned char> decoded;
+        if (jpeg.open(filename) != JpegDecoder::JPEG_NO_ERROR) return false;
+        if (jpeg.decode(1, decoded, w, h) != JpegDecoder::JPEG_NO_ERROR) return false;
+
+        pixels = (unsigned char*)malloc((size_t)w * h * 3);
+        if (!pixels) return false;
+        if (jpeg.components() == 1) PixelConvert::ExpandGray(decoded.data(), pixels, (size_t)w * h, 3);
+        else memcpy(pixels, decoded.data(), decoded.size());
+        PixelConvert::FlipRows(pixels, (size_t)w * 3, h);
+        return true;
+    }
+
+    // 로더가 malloc 한 버퍼의 소유권을 가져옴
+    bool TakePixels(unsigned char*& pixels, int w, int h, GLenum fmt, int bytesPerPixel) {
+        data.reset(pixels);
+        pixels = NULL;
+        width = w;
+        height = h;
+        format = fmt;
+        stride = (size_t)w * bytesPerPixel;
+        return data != NULL;
+    }
+
+    BmpView bmp;
+    TextureCacheFile cache; // data 버퍼를 가리킴
+    bool isBMP, isCompressed;
+    int width, height;
+    GLenum format;
+    size_t stride, compressedBytes;
+    unique_ptr<unsigned char, void (*)(void*)> data;
+};
+
+GLuint LoadTexture(const char* filename, int* outW = NULL, int* outH = NULL) {
+    TextureImage image;
+    if (!image.Load(filename)) {
         cout << "텍스처 로드 실패: " << filename << endl;
         return 0;
     }
@@ -107,220 +393,3436 @@ GLuint LoadTexture(const char* filename) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-    delete[] data;
+    image.TexImage(image.Pixels());
+    if (outW) *outW = image.Width();
+    if (outH) *outH = image.Height();
     return id;
 }
 
-void InitSkybox() {
-    int w, h;
-    // 경로에 주의하세요. 실행 파일과 같은 위치면 "Sky.bmp", 아니면 "../Data/Sky.bmp" 등
-    unsigned char* data = LoadBMP("../Data/Sky.bmp", &w, &h);
+// -------------------------------------------------------
+// [텍스처 스트리밍] 백그라운드 디코딩 + PBO 업로드
+// -------------------------------------------------------
+// Request()는 GL 텍스처 이름을 즉시 만들어 플레이스홀더(회색 체커)를 채워두고 반환합니다.
+// 워커 스레드는 BMP를 매핑/검증만 (TGA/PPM 은 SIMD 디코딩) 하고, 업로드는 GL 스레드의 Pump()에서 PBO 링을 통해 진행되며
+// 완료되면 같은 텍스처 이름에 실제 이미지가 들어갑니다. (호출자는 ID를 바꿀 필요 없음)
+class TextureStreamer {
+public:
+    static const int PBO_COUNT = 3;
 
-    if (data) {
-        glGenTextures(1, &skyTextureID);
-        glBindTexture(GL_TEXTURE_2D, skyTextureID);
+    // 텍스처가 실제 이미지로 교체되었을 때 호출 (id, GPU 메모리 바이트)
+    function<void(GLuint, size_t)> onResident;
 
-        // 텍스처 파라미터 설정 (우주 배경이므로 반복되게 설정)
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    TextureStreamer() : started(false), stopping(false), pboIndex(0), usePBO(false), inFlight(0), nextSerial(0) {
+        for (int i = 0; i < PBO_COUNT; i++) pbo[i] = 0;
+    }
+
+    ~TextureStreamer() { Shutdown(); }
+
+    // GL 컨텍스트 생성 이후(glewInit 이후) 호출
+    void Start() {
+        if (started) return;
+        started = true;
+        stopping = false;
+        startTime = chrono::steady_clock::now();
+
+        usePBO = (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object) != 0;
+        if (usePBO) glGenBuffers(PBO_COUNT, pbo);
+
+        unsigned int n = thread::hardware_concurrency();
+        n = (n > 1) ? n - 1 : 1;
+        if (n > 4) n = 4;
+        for (unsigned int i = 0; i < n; i++) workers.push_back(thread(&TextureStreamer::WorkerLoop, this));
+    }
+
+    void Shutdown() {
+        if (!started) return;
+        {
+            lock_guard<mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobCond.notify_all();
+        for (auto& t : workers) if (t.joinable()) t.join();
+        workers.clear();
+
+        done.clear();
+        started = false;
+    }
+
+    // 비동기 로드 요청: 플레이스홀더가 채워진 텍스처 ID를 바로 반환
+    GLuint Request(const char* filename, GLint wrapMode = GL_CLAMP_TO_EDGE) {
+        Job job;
+        job.path = filename;
+        return Enqueue(job, wrapMode);
+    }
+
+    // 같은 크기의 면 텍스처들을 한 장의 세로 띠 아틀라스로 비동기 로드 (TextureImage::LoadAtlas)
+    GLuint RequestAtlas(const vector<string>& files) {
+        Job job;
+        for (auto& f : files) job.path += (job.path.empty() ? "" : " + ") + f;
+        job.layers = files;
+        return Enqueue(job, GL_CLAMP_TO_EDGE);
+    }
+
+    // 텍스처가 삭제될 때 호출: 아직 업로드 전이면 그 작업의 업로드를 생략 (이미 올라간 것은 아무 일 없음)
+    // 작업 번호(serial) 로 구분하므로 삭제된 이름을 GL 이 새 텍스처에 다시 줘도 새 작업은 영향 없음
+    void Cancel(GLuint id) {
+        lock_guard<mutex> lock(jobMutex);
+        pending.erase(id);
+    }
+
+    // GL 스레드에서 매 프레임 호출. 프레임당 업로드 양을 제한해서 끊김을 막음
+    // 반환값: 이번 프레임에 처리한 텍스처 수
+    int Pump(size_t byteBudget = 8 * 1024 * 1024) {
+        if (!started) return 0;
+
+        vector<Result> ready;
+        {
+            lock_guard<mutex> lock(jobMutex);
+            size_t bytes = 0;
+            while (!done.empty() && (ready.empty() || bytes < byteBudget)) {
+                bytes += done.front().image.Bytes();
+                ready.push_back(move(done.front()));
+                done.pop_front();
+            }
+        }
+
+        for (auto& r : ready) {
+            if (r.ok && TakePending(r.id, r.serial)) {
+                Upload(r.id, r.image);
+                if (onResident) onResident(r.id, r.image.GpuBytes());
+            }
+            else if (!r.ok) {
+                TakePending(r.id, r.serial);
+                cout << "텍스처 로드 실패: " << r.path << endl;
+            }
+        }
+
+        if (!ready.empty()) {
+            lock_guard<mutex> lock(jobMutex);
+            inFlight -= (int)ready.size();
+            if (inFlight == 0) {
+                float ms = chrono::duration<float, milli>(chrono::steady_clock::now() - startTime).count();
+                cout << "[TextureStreamer] all textures resident (" << ms << " ms)" << endl;
+            }
+        }
+        return (int)ready.size();
+    }
+
+    bool IsIdle() {
+        lock_guard<mutex> lock(jobMutex);
+        return inFlight == 0;
+    }
+
+private:
+    struct Job {
+        GLuint id;
+        unsigned serial;
+        string path;
+        vector<string> layers; // 비어있지 않으면 아틀라스 작업
+    };
+    struct Result {
+        GLuint id;
+        unsigned serial;
+        string path;
+        TextureImage image; // BMP 는 매핑된 파일을 그대로 들고 있음 (업로드 후 해제)
+        bool ok;
+    };
+
+    // GL 텍스처를 만들어 플레이스홀더를 채우고 작업을 큐에 넣음
+    GLuint Enqueue(Job& job, GLint wrapMode) {
+        if (!started) Start();
+
+        GLuint id;
+        glGenTextures(1, &id);
+        glBindTexture(GL_TEXTURE_2D, id);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
+
+        static const unsigned char placeholder[2 * 2 * 3] = {
+            96, 96, 96,   160, 160, 160,
+            160, 160, 160, 96, 96, 96
+        };
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 2, 2, 0, GL_RGB, GL_UNSIGNED_BYTE, placeholder);
+
+        {
+            lock_guard<mutex> lock(jobMutex);
+            job.id = id;
+            job.serial = ++nextSerial;
+            pending[id] = job.serial;
+            jobs.push_back(job);
+            inFlight++;
+        }
+        jobCond.notify_one();
+        return id;
+    }
+
+    void WorkerLoop() {
+        for (;;) {
+            Job job;
+            {
+                unique_lock<mutex> lock(jobMutex);
+                jobCond.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                job = jobs.front();
+                jobs.pop_front();
+            }
+
+            Result r;
+            r.id = job.id;
+            r.serial = job.serial;
+            r.path = job.path;
+            r.ok = job.layers.empty() ? r.image.Load(job.path.c_str()) : r.image.LoadAtlas(job.layers);
+            if (r.ok) PrefaultPixels(r.image);
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        delete[] data;
-        cout << "Skybox Texture Loaded!" << endl;
+            lock_guard<mutex> lock(jobMutex);
+            done.push_back(move(r));
+        }
     }
-    else {
-        cout << "Failed to load Skybox Texture!" << endl;
+
+    // 결과가 아직 그 이름의 현재 작업이면 true. 소비한 결과는 목록에서 뺌 (취소된 것은 이미 빠져 있음)
+    bool TakePending(GLuint id, unsigned serial) {
+        lock_guard<mutex> lock(jobMutex);
+        auto it = pending.find(id);
+        if (it == pending.end() || it->second != serial) return false;
+        pending.erase(it);
+        return true;
+    }
+
+    // GL 스레드가 업로드 중에 디스크 페이지 폴트로 멈추지 않도록 워커에서 미리 읽어둠
+    static void PrefaultPixels(const TextureImage& image) {
+        volatile unsigned char sink = 0;
+        const unsigned char* p = image.Pixels();
+        for (size_t i = 0; i < image.Bytes(); i += 4096) sink ^= p[i];
+        (void)sink;
     }
-}
+
+    void Upload(GLuint id, const TextureImage& image) {
+        size_t size = image.Bytes();
+        glBindTexture(GL_TEXTURE_2D, id);
+
+        if (!usePBO) {
+            image.TexImage(image.Pixels());
+            return;
+        }
+
+        // 링의 다음 PBO에 복사 후 오프셋 0에서 업로드 (버퍼 고아화로 GPU 대기 없음)
+        int i = pboIndex;
+        pboIndex = (pboIndex + 1) % PBO_COUNT;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[i]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+
+        // 매핑된 파일의 픽셀 영역을 그대로 복사 (BGR 스왑 없음)
+        void* dst = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+        if (dst) {
+            memcpy(dst, image.Pixels(), size);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            image.TexImage((const void*)0);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        else {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            image.TexImage(image.Pixels());
+        }
+    }
+
+    bool started, stopping;
+    vector<thread> workers;
+    mutex jobMutex;
+    condition_variable jobCond;
+    deque<Job> jobs;
+    deque<Result> done;
+    unordered_map<GLuint, unsigned> pending;     // 업로드 전인 텍스처 이름 -> 현재 작업 번호
+
+    GLuint pbo[PBO_COUNT];
+    int pboIndex;
+    bool usePBO;
+    int inFlight;
+    unsigned nextSerial;
+    chrono::steady_clock::time_point startTime;
+};
+
+TextureStreamer textureStreamer;
 
 // -------------------------------------------------------
-// [기본 오브젝트 클래스]
+// [텍스처 레지스트리] 같은 파일은 한 번만 디코딩/업로드
 // -------------------------------------------------------
-class GameObject {
+// 정규화된 경로를 키로 GL 텍스처를 공유하고 참조 카운트로 수명을 관리합니다.
+// "../Data/Cube.bmp" 와 "..\\data\\cube.bmp" 처럼 표기만 다른 경로도 같은 텍스처가 됩니다.
+class TextureRegistry {
 public:
-    vec3 position;
-    vec3 scale;
-    vec3 rotation;
-    vec3 color;
+    struct Entry {
+        GLuint id;
+        int refCount;
+        size_t bytes;
+    };
 
-    // [물리 변수]
-    vec3 velocity;
-    vec3 force;
-    float mass;
-    bool isStatic;
+    // 경로의 텍스처를 얻고 참조 카운트를 올림 (실패 시 0)
+    GLuint Acquire(const char* filename) {
+        if (!filename) return 0;
+        return AcquireKey(NormalizePath(filename), [&] { return textureStreamer.Request(filename); });
+    }
 
-    deque<std::pair<vec3, vec3>> trails;
+    // 면 텍스처 목록을 아틀라스 한 장으로 얻음 (같은 파일, 같은 순서의 목록끼리 공유)
+    GLuint AcquireAtlas(const vector<string>& files) {
+        string key = "atlas:";
+        for (auto& f : files) key += NormalizePath(f.c_str()) + "|";
+        return AcquireKey(key, [&] { return textureStreamer.RequestAtlas(files); });
+    }
 
-    GameObject(vec3 pos, vec3 sz, vec3 col)
-        : position(pos), scale(sz), rotation(0.0f, 0.0f, 0.0f), color(col),
-        velocity(0.0f), force(0.0f), mass(1.0f), isStatic(true) {
+    // 스트리머가 실제 이미지를 올렸을 때 호출 (GPU 메모리 크기 반영)
+    void OnResident(GLuint id, size_t bytes) {
+        auto k = keyById.find(id);
+        if (k == keyById.end()) return;
+        Entry& e = entries[k->second];
+        residentBytes -= e.bytes;
+        e.bytes = bytes;
+        residentBytes += e.bytes;
     }
 
-    virtual ~GameObject() {}
+    // 참조 카운트를 내리고 마지막 사용자가 놓으면 GL 텍스처 삭제
+    void Release(GLuint id) {
+        if (id == 0) return;
+        auto k = keyById.find(id);
+        if (k == keyById.end()) return;
 
-    void UpdatePhysics(float dt, float currentFloorY) {
-        if (isStatic) return;
+        auto it = entries.find(k->second);
+        if (--it->second.refCount > 0) return;
 
-        vec3 gravity(0.0f, -20.0f, 0.0f);
-        force += gravity * mass;
-        force -= velocity * 0.1f;
+        residentBytes -= it->second.bytes;
+        textureStreamer.Cancel(id);
+        glDeleteTextures(1, &id);
+        entries.erase(it);
+        keyById.erase(k);
+    }
 
-        vec3 accel = force / mass;
-        velocity += accel * dt;
-        position += velocity * dt;
+    size_t GetResidentBytes() const { return residentBytes; }
+    size_t GetTextureCount() const { return entries.size(); }
 
-        float halfHeight = scale.y / 2.0f;
-        float bottomY = position.y - halfHeight;
+    void PrintStats() const {
+        cout << "[TextureRegistry] textures: " << entries.size()
+            << ", resident: " << (residentBytes / 1024) << " KB" << endl;
+    }
 
-        if (bottomY < currentFloorY) {
-            position.y = currentFloorY + halfHeight;
-            if (velocity.y < 0) {
-                velocity.y = 0.0f;
-                velocity.x *= 0.9f;
-                velocity.z *= 0.9f;
-            }
+    // 절대 경로로 바꾼 뒤 구분자/대소문자를 통일 (Windows 파일 시스템 기준)
+    // 팩이 걸려 있으면 팩 키 그대로 (realpath 없이)
+    static string NormalizePath(const char* filename) {
+        if (AssetPack::Mounted()) return "pak:" + AssetPack::KeyFor(filename);
+        char buf[4096];
+#ifdef _WIN32
+        string path = _fullpath(buf, filename, sizeof(buf)) ? buf : filename;
+#else
+        string path = realpath(filename, buf) ? buf : filename;
+#endif
+        for (auto& c : path) {
+            if (c == '\\') c = '/';
+            else c = (char)tolower((unsigned char)c);
         }
-        force = vec3(0.0f);
+        return path;
     }
 
-    void UpdateTrails(bool isHeld) {
-        // 잡았을 때
-        if (isHeld) {
-            trails.push_front({ position, scale }); // 현재 상태 저장
-            if (trails.size() > 7) trails.pop_back(); // 최대 10개
-        }
-        else {
-            // 움직임이 멈추면 잔상이 서서히 사라짐
-            if (!trails.empty()) trails.pop_back();
+private:
+    GLuint AcquireKey(const string& key, const function<GLuint()>& request) {
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            it->second.refCount++;
+            return it->second.id;
         }
+
+        // 디코딩은 스트리머가 백그라운드에서 진행, 메모리 크기는 업로드 완료 시 반영
+        GLuint id = request();
+        if (id == 0) return 0;
+
+        Entry e;
+        e.id = id;
+        e.refCount = 1;
+        e.bytes = 0;
+        entries[key] = e;
+        keyById[id] = key;
+        return id;
     }
 
-    virtual void Draw() = 0;
-    virtual void DrawShadow(float* shadowMat) = 0;
+    unordered_map<string, Entry> entries;
+    unordered_map<GLuint, string> keyById;
+    size_t residentBytes = 0;
 };
 
+TextureRegistry textureRegistry;
+
 // -------------------------------------------------------
-// [큐브]
+// [밉 스트리밍] 큰 JPEG 텍스처를 밉 꼬리부터, 화면에 필요한 만큼만
 // -------------------------------------------------------
-class Cube : public GameObject {
+// 텍스처 하나 = 같은 그림의 해상도 변형들 (예: Jupiter2_1k/2k/4k.jpg), 밉 체인은 가장 큰 변형 크기 기준.
+// Add() 는 가장 작은 변형을 DC 계수만으로(1/8) 디코딩해 밉 꼬리(폭 TAIL_WIDTH 이하 레벨)만 바로 올립니다.
+// (시작 로딩에서는 PrepareTail 을 워커에서, Add(Tail) 만 GL 스레드에서 부를 수 있음)
+// 매 프레임 Use() 로 물체의 화면 크기를 알려주면 필요한 텍셀 폭이 될 때까지 한 레벨씩 더 세밀한 밉을
+// 디코딩 풀에 요청하고 (그 레벨보다 크거나 같은 가장 작은 변형을, 가능한 가장 큰 DCT 축소로), Update() 가 올림.
+// GL_TEXTURE_BASE_LEVEL = 가장 세밀한 상주 레벨이므로 아직 없는 레벨은 샘플링되지 않고, 레벨마다 따로
+// glTexImage2D 하므로 올리지 않은 레벨은 VRAM 을 쓰지 않습니다.
+// 상주 바이트가 예산을 넘게 되면 최근에 안 쓴 텍스처부터 (LRU) 가장 세밀한 레벨을 하나씩 버림. 꼬리는 항상 상주.
+class MipStreamer {
+private:
+    struct Entry {
+        vector<string> files;
+        vector<int> fileWidths;
+        GLuint id;
+        int width, height, channels;    // 레벨 0 (가장 큰 변형)
+        int levelCount;
+        int tailLevel;                  // 여기부터 끝까지 항상 상주
+        int baseLevel;                  // 가장 세밀한 상주 레벨
+        int wantedLevel;                // 마지막으로 쓰인 프레임에 필요했던 레벨
+        int pendingLevel;               // 디코딩 중인 레벨 (-1: 없음)
+        unsigned int lastUsed;          // LRU
+        unsigned int retryFrame;        // 예산 부족으로 거절된 뒤 다시 요청할 프레임
+        size_t bytes;
+    };
+
 public:
-    // 텍스처 ID 저장 (0:앞뒤, 1:위아래, 2:좌우)
-    GLuint texIDs[3];
-    bool hasTexture;
+    // PrepareTail 이 채우고 Add 가 올리는 꼬리 레벨들
+    struct Tail {
+        Entry entry;
+        vector<vector<unsigned char>> levels;   // tailLevel 부터
+        float ms = 0.0f;
+        bool ok = false;
+    };
 
-    Cube(vec3 pos, vec3 sz, vec3 col) : GameObject(pos, sz, col) {
-        mass = 5.0f;
-        texIDs[0] = 0; texIDs[1] = 0; texIDs[2] = 0;
-        hasTexture = false;
+    static const int TAIL_WIDTH = 128;
+
+    MipStreamer() : started(false), stopping(false), budget(48 * 1024 * 1024), residentBytes(0), pendingBytes(0), frame(0),
+        pixelScale(0.0f), uploadedLevels(0), evictedLevels(0), deniedRequests(0) {}
+
+    ~MipStreamer() { Shutdown(); }
+
+    void Start(int threadCount = 2) {
+        if (started) return;
+        started = true;
+        stopping = false;
+        for (int i = 0; i < threadCount; i++) workers.push_back(thread(&MipStreamer::WorkerLoop, this));
     }
 
-    // [추가] 텍스처 설정 함수
-    void SetTextures(const char* file1, const char* file2, const char* file3) {
-        texIDs[0] = LoadTexture(file1); // 앞/뒤
-        texIDs[1] = LoadTexture(file2); // 위/아래
-        texIDs[2] = LoadTexture(file3); // 좌/우
+    void Shutdown() {
+        if (!started) return;
+        {
+            lock_guard<mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobCond.notify_all();
+        for (auto& t : workers) if (t.joinable()) t.join();
+        workers.clear();
+        jobs.clear();
+        done.clear();
+        started = false;
+    }
 
-        // 하나라도 로드되면 텍스처 모드 활성화
-        if (texIDs[0] != 0) hasTexture = true;
+    // variants: 해상도 오름차순 JPEG 경로. 반환: 핸들 (실패 시 -1)
+    int Add(const vector<string>& variants) {
+        Tail tail;
+        PrepareTail(variants, tail);
+        return Add(tail);
     }
 
-    void Draw() override {
-        glPushMatrix();
-        glTranslatef(position.x, position.y, position.z);
+    // GL 없이 (워커 스레드에서) 할 수 있는 부분: 헤더 검사와 꼬리 레벨 디코딩/축소
+    static bool PrepareTail(const vector<string>& variants, Tail& tail) {
+        auto start = chrono::steady_clock::now();
+        Entry& e = tail.entry;
+        tail.ok = false;
+        e.files = variants;
+        e.channels = 0;
+        for (auto& f : variants) {
+            JpegDecoder jpeg;
+            if (jpeg.open(f.c_str()) != JpegDecoder::JPEG_NO_ERROR) {
+                cout << "밉 스트리밍 텍스처 로드 실패: " << f << endl;
+                return false;
+            }
+            if (e.channels != 0 && jpeg.components() != e.channels) return false;
+            e.channels = jpeg.components();
+            e.fileWidths.push_back(jpeg.width());
+            e.width = jpeg.width();
+            e.height = jpeg.height();
+        }
+        if (variants.empty()) return false;
+
+        e.levelCount = 1;
+        while ((e.width >> e.levelCount) > 0 || (e.height >> e.levelCount) > 0) e.levelCount++;
+        e.tailLevel = 0;
+        while (e.tailLevel < e.levelCount - 1 && LevelWidth(e, e.tailLevel) > TAIL_WIDTH) e.tailLevel++;
+
+        // 밉 꼬리: 가장 작은 변형의 1/8 디코딩 (역DCT 없음) 하나에서 모든 꼬리 레벨을 만듦
+        JpegDecoder jpeg;
+        vector<unsigned char> dc;
+        int dw, dh;
+        if (jpeg.open(variants[0].c_str()) != JpegDecoder::JPEG_NO_ERROR || jpeg.decode(8, dc, dw, dh) != JpegDecoder::JPEG_NO_ERROR) {
+            cout << "밉 스트리밍 텍스처 로드 실패: " << variants[0] << endl;
+            return false;
+        }
+        tail.levels.resize(e.levelCount - e.tailLevel);
+        for (int l = e.tailLevel; l < e.levelCount; l++) {
+            int w = LevelWidth(e, l), h = LevelHeight(e, l);
+            vector<unsigned char>& level = tail.levels[l - e.tailLevel];
+            level.resize((size_t)w * h * e.channels);
+            BoxResample(dc.data(), dw, dh, e.channels, level.data(), w, h);
+        }
+        tail.ms = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+        tail.ok = true;
+        return true;
+    }
 
-        // 3축 회전 적용
-        glRotatef(rotation.x, 1, 0, 0);
-        glRotatef(rotation.y, 0, 1, 0);
-        glRotatef(rotation.z, 0, 0, 1);
+    // GL 스레드: PrepareTail 결과로 텍스처를 만들고 꼬리 레벨을 올림
+    int Add(Tail& tail) {
+        if (!tail.ok) return -1;
+        auto start = chrono::steady_clock::now();
+        Entry e = tail.entry;
 
-        glScalef(scale.x, scale.y, scale.z);
+        glGenTextures(1, &e.id);
+        glBindTexture(GL_TEXTURE_2D, e.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, e.levelCount - 1);
+
+        e.bytes = 0;
+        for (int l = e.tailLevel; l < e.levelCount; l++) UploadLevel(e, l, tail.levels[l - e.tailLevel].data());
+        tail.levels.clear();
+        e.baseLevel = e.tailLevel;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, e.baseLevel);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        e.wantedLevel = e.tailLevel;
+        e.pendingLevel = -1;
+        e.lastUsed = 0;
+        e.retryFrame = 0;
+        entries.push_back(e);
+
+        float ms = tail.ms + chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+        cout << "[MipStreamer] " << e.files.back() << ": " << e.width << "x" << e.height << ", 꼬리 레벨 " << e.tailLevel
+            << "~" << (e.levelCount - 1) << " (" << (e.bytes / 1024) << " KB) " << ms << " ms" << endl;
+        return (int)entries.size() - 1;
+    }
 
-        // [분기] 텍스처가 있으면 "조명을 끄고" 그립니다.
-        if (hasTexture) {
-            // [▼▼▼ 핵심 변경: 조명 끄기 (Unlit) ▼▼▼]
-            glDisable(GL_LIGHTING);
+    GLuint GetTexture(int handle) const { return (handle >= 0) ? entries[handle].id : 0; }
 
-            glEnable(GL_TEXTURE_2D);
-            glColor3f(1.0f, 1.0f, 1.0f); // 텍스처 본연의 색 유지
+    // 프레임마다 Use() 전에: 현재 투영/뷰포트로 "월드 길이 / 거리 -> 픽셀" 계수를 구함
+    void BeginFrame() {
+        frame++;
+        float proj[16];
+        GLint viewport[4];
+        glGetFloatv(GL_PROJECTION_MATRIX, proj);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        pixelScale = proj[5] * viewport[3] * 0.5f;
+    }
 
-            // 텍스처 색상을 그대로 덮어씌움 (그림자/조명 영향 X)
-            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    // 반지름 radius 인 구가 eye 에서 보임: 화면 지름 D 픽셀, 구 둘레(텍스처 가로)가 정면에서
+    // 1 텍셀 = 1 픽셀이 되는 폭은 pi * D. 그 폭 이상인 가장 거친 레벨을 원함
+    void Use(int handle, vec3 center, float radius, vec3 eye) {
+        if (handle < 0) return;
+        Entry& e = entries[handle];
+        float dist = length(center - eye);
+        float wanted = (dist > radius) ? 3.14159265f * 2.0f * radius / dist * pixelScale : (float)e.width;
+
+        int level = e.tailLevel;
+        while (level > 0 && LevelWidth(e, level) < wanted) level--;
+        // 같은 프레임에 여러 물체가 쓰면 가장 세밀한 요구를 따름
+        e.wantedLevel = (e.lastUsed == frame) ? std::min(e.wantedLevel, level) : level;
+        e.lastUsed = frame;
+    }
 
-            float s = 0.5f;
+    // GL 스레드에서 매 프레임: 디코딩이 끝난 레벨 업로드 (프레임당 uploadBudget 바이트, 최소 하나) -> 새 요청
+    void Update(size_t uploadBudget = 8 * 1024 * 1024) {
+        if (!started) return;
+
+        vector<Result> ready;
+        {
+            lock_guard<mutex> lock(jobMutex);
+            size_t bytes = 0;
+            while (!done.empty() && (ready.empty() || bytes < uploadBudget)) {
+                bytes += done.front().pixels.size();
+                ready.push_back(move(done.front()));
+                done.pop_front();
+            }
+        }
 
-            // 1. 앞(Front) / 뒤(Back) -> texIDs[0]
-            if (texIDs[0]) glBindTexture(GL_TEXTURE_2D, texIDs[0]);
-            glBegin(GL_QUADS);
-            glNormal3f(0, 0, 1);  glTexCoord2f(0, 0); glVertex3f(-s, -s, s); glTexCoord2f(1, 0); glVertex3f(s, -s, s); glTexCoord2f(1, 1); glVertex3f(s, s, s); glTexCoord2f(0, 1); glVertex3f(-s, s, s);
-            glNormal3f(0, 0, -1); glTexCoord2f(0, 0); glVertex3f(-s, -s, -s); glTexCoord2f(1, 0); glVertex3f(-s, s, -s); glTexCoord2f(1, 1); glVertex3f(s, s, -s); glTexCoord2f(0, 1); glVertex3f(s, -s, -s);
-            glEnd();
+        for (auto& r : ready) {
+            Entry& e = entries[r.handle];
+            pendingBytes -= LevelBytes(e, r.level);
+            e.pendingLevel = -1;
+            // 디코딩하는 동안 그 사이 레벨이 버려졌으면 이어 붙일 수 없음
+            if (!r.ok || r.level != e.baseLevel - 1) continue;
+            if (!MakeRoom(r.pixels.size(), r.handle)) {
+                deniedRequests++;
+                e.retryFrame = frame + 60;
+                continue;
+            }
+            glBindTexture(GL_TEXTURE_2D, e.id);
+            UploadLevel(e, r.level, r.pixels.data());
+            e.baseLevel = r.level;
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, e.baseLevel);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            uploadedLevels++;
+        }
 
-            // 2. 위(Top) / 아래(Bottom) -> texIDs[1]
-            if (texIDs[1]) glBindTexture(GL_TEXTURE_2D, texIDs[1]);
-            glBegin(GL_QUADS);
-            glNormal3f(0, 1, 0);  glTexCoord2f(0, 0); glVertex3f(-s, s, -s); glTexCoord2f(1, 0); glVertex3f(-s, s, s); glTexCoord2f(1, 1); glVertex3f(s, s, s); glTexCoord2f(0, 1); glVertex3f(s, s, -s);
-            glNormal3f(0, -1, 0); glTexCoord2f(0, 0); glVertex3f(-s, -s, -s); glTexCoord2f(1, 0); glVertex3f(-s, -s, s); glTexCoord2f(1, 1); glVertex3f(s, -s, s); glTexCoord2f(0, 1); glVertex3f(s, -s, -s);
-            glEnd();
+        // 이번 프레임에 보인 텍스처 중 더 세밀한 레벨이 필요한 것을 요청 (한 텍스처에 하나씩, 한 레벨씩)
+        bool queued = false;
+        for (size_t i = 0; i < entries.size(); i++) {
+            Entry& e = entries[i];
+            if (e.lastUsed != frame || e.pendingLevel >= 0 || e.wantedLevel >= e.baseLevel || frame < e.retryFrame) continue;
+
+            int level = e.baseLevel - 1;
+            size_t bytes = LevelBytes(e, level);
+            if (residentBytes + pendingBytes + bytes > budget + Reclaimable((int)i)) {
+                deniedRequests++;
+                e.retryFrame = frame + 60;
+                continue;
+            }
 
-            // 3. 좌(Left) / 우(Right) -> texIDs[2]
-            if (texIDs[2]) glBindTexture(GL_TEXTURE_2D, texIDs[2]);
-            glBegin(GL_QUADS);
-            glNormal3f(-1, 0, 0); glTexCoord2f(0, 0); glVertex3f(-s, -s, -s); glTexCoord2f(1, 0); glVertex3f(-s, -s, s); glTexCoord2f(1, 1); glVertex3f(-s, s, s); glTexCoord2f(0, 1); glVertex3f(-s, s, -s);
-            glNormal3f(1, 0, 0);  glTexCoord2f(0, 0); glVertex3f(s, -s, -s); glTexCoord2f(1, 0); glVertex3f(s, -s, s); glTexCoord2f(1, 1); glVertex3f(s, s, s); glTexCoord2f(0, 1); glVertex3f(s, s, -s);
-            glEnd();
+            Job job;
+            job.handle = (int)i;
+            job.level = level;
+            job.width = LevelWidth(e, level);
+            job.height = LevelHeight(e, level);
+            job.channels = e.channels;
+            job.files = e.files;
+            job.fileWidths = e.fileWidths;
+            // 지금 상주 폭 대비 필요한 폭이 클수록 먼저
+            job.priority = (float)(e.baseLevel - e.wantedLevel);
+            e.pendingLevel = level;
+            pendingBytes += bytes;
+
+            lock_guard<mutex> lock(jobMutex);
+            jobs.push_back(job);
+            queued = true;
+        }
+        if (queued) jobCond.notify_all();
+    }
 
-            glDisable(GL_TEXTURE_2D);
+    void SetBudget(size_t bytes) { budget = bytes; }
+    size_t GetBudget() const { return budget; }
+    size_t GetResidentBytes() const { return residentBytes; }
+    int GetUploadedLevels() const { return uploadedLevels; }
+    int GetEvictedLevels() const { return evictedLevels; }
+    int GetDeniedRequests() const { return deniedRequests; }
+    int GetResidentWidth(int handle) const { return (handle >= 0) ? LevelWidth(entries[handle], entries[handle].baseLevel) : 0; }
+
+    void PrintStats() const {
+        cout << "[MipStreamer] resident: " << (residentBytes / 1024) << " / " << (budget / 1024) << " KB, uploaded: " << uploadedLevels
+            << ", evicted: " << evictedLevels << ", denied: " << deniedRequests << endl;
+        for (auto& e : entries) {
+            cout << "  " << e.files.back() << ": " << LevelWidth(e, e.baseLevel) << " px (want " << LevelWidth(e, e.wantedLevel)
+                << ", last used " << (frame - e.lastUsed) << " frames ago)" << endl;
+        }
+    }
 
-            // [복구] 다른 물체들을 위해 조명과 텍스처 모드 원상복구
-            glEnable(GL_LIGHTING);
-            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    // 넓이 평균 축소 (확대도 최근접으로 동작). 출력은 GL 용 bottom-up
+    static void BoxResample(const unsigned char* src, int sw, int sh, int channels, unsigned char* dst, int dw, int dh) {
+        for (int y = 0; y < dh; y++) {
+            int y0 = (int)((long long)y * sh / dh), y1 = std::max(y0 + 1, (int)((long long)(y + 1) * sh / dh));
+            unsigned char* out = dst + (size_t)(dh - 1 - y) * dw * channels;
+            for (int x = 0; x < dw; x++) {
+                int x0 = (int)((long long)x * sw / dw), x1 = std::max(x0 + 1, (int)((long long)(x + 1) * sw / dw));
+                unsigned int sum[3] = { 0, 0, 0 };
+                for (int sy = y0; sy < y1; sy++) {
+                    const unsigned char* p = src + ((size_t)sy * sw + x0) * channels;
+                    for (int sx = x0; sx < x1; sx++)
+                        for (int c = 0; c < channels; c++) sum[c] += *p++;
+                }
+                unsigned int n = (unsigned int)((x1 - x0) * (y1 - y0));
+                for (int c = 0; c < channels; c++) *out++ = (unsigned char)((sum[c] + n / 2) / n);
+            }
         }
-        else {
-            // 텍스처 없는 일반 큐브 (기존 방식 - 조명 받음)
-            glColor3f(color.r, color.g, color.b);
-            glutSolidCube(1.0f);
+    }
+
+    // 레벨 하나를 디코딩: 필요한 폭 이상인 가장 작은 변형, 그 폭 이상인 가장 큰 DCT 축소 (1/8 ~ 1)
+    static bool DecodeLevel(const vector<string>& files, const vector<int>& fileWidths, int width, int height, int channels, vector<unsigned char>& out) {
+        size_t file = 0;
+        while (file + 1 < files.size() && fileWidths[file] < width) file++;
+        int scale = 8;
+        while (scale > 1 && JpegDecoder::ScaledSize(fileWidths[file], scale) < width) scale /= 2;
+
+        JpegDecoder jpeg;
+        vector<unsigned char> decoded;
+        int dw, dh;
+        if (jpeg.open(files[file].c_str()) != JpegDecoder::JPEG_NO_ERROR) return false;
+        if (jpeg.components() != channels || jpeg.decode(scale, decoded, dw, dh) != JpegDecoder::JPEG_NO_ERROR) return false;
+        out.resize((size_t)width * height * channels);
+        BoxResample(decoded.data(), dw, dh, channels, out.data(), width, height);
+        return true;
+    }
+
+private:
+    struct Job {
+        int handle, level;
+        int width, height, channels;
+        vector<string> files;
+        vector<int> fileWidths;
+        float priority;
+    };
+    struct Result {
+        int handle, level;
+        vector<unsigned char> pixels;
+        bool ok;
+    };
+
+    static int LevelWidth(const Entry& e, int level) { return std::max(1, e.width >> level); }
+    static int LevelHeight(const Entry& e, int level) { return std::max(1, e.height >> level); }
+    static size_t LevelBytes(const Entry& e, int level) { return (size_t)LevelWidth(e, level) * LevelHeight(e, level) * e.channels; }
+
+    // 바인딩된 텍스처의 레벨 하나를 올림 (그레이는 GL_LUMINANCE 로 1바이트/텍셀)
+    void UploadLevel(Entry& e, int level, const unsigned char* pixels) {
+        GLenum format = (e.channels == 1) ? GL_LUMINANCE : GL_RGB;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, level, (e.channels == 1) ? GL_LUMINANCE8 : GL_RGB8, LevelWidth(e, level), LevelHeight(e, level), 0,
+                     format, GL_UNSIGNED_BYTE, pixels);
+        e.bytes += LevelBytes(e, level);
+        residentBytes += LevelBytes(e, level);
+    }
+
+    // 가장 세밀한 상주 레벨을 버림 (크기 0 으로 다시 지정하면 드라이버가 메모리를 놓음)
+    void EvictLevel(Entry& e) {
+        glBindTexture(GL_TEXTURE_2D, e.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, e.baseLevel + 1);
+        glTexImage2D(GL_TEXTURE_2D, e.baseLevel, (e.channels == 1) ? GL_LUMINANCE8 : GL_RGB8, 0, 0, 0,
+                     (e.channels == 1) ? GL_LUMINANCE : GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        e.bytes -= LevelBytes(e, e.baseLevel);
+        residentBytes -= LevelBytes(e, e.baseLevel);
+        e.baseLevel++;
+        evictedLevels++;
+    }
+
+    // 버릴 수 있는 레벨: 이번 프레임에 안 쓴 텍스처의 꼬리 위 전부 + 쓴 텍스처의 필요 이상 레벨
+    bool Evictable(const Entry& e, int except) const {
+        if (&e == &entries[except] || e.baseLevel >= e.tailLevel) return false;
+        return e.lastUsed != frame || e.baseLevel < e.wantedLevel;
+    }
+
+    size_t Reclaimable(int except) const {
+        size_t bytes = 0;
+        for (auto& e : entries) {
+            if (&e == &entries[except]) continue;
+            int keep = (e.lastUsed != frame) ? e.tailLevel : std::min(e.wantedLevel, e.tailLevel);
+            for (int l = e.baseLevel; l < keep; l++) bytes += LevelBytes(e, l);
         }
+        return bytes;
+    }
 
-        glPopMatrix();
+    // bytes 를 더 올릴 자리를 만듦: 가장 오래 안 쓴 텍스처부터 한 레벨씩
+    bool MakeRoom(size_t bytes, int except) {
+        while (residentBytes + bytes > budget) {
+            Entry* victim = NULL;
+            for (auto& e : entries) {
+                if (!Evictable(e, except)) continue;
+                if (!victim || e.lastUsed < victim->lastUsed || (e.lastUsed == victim->lastUsed && e.baseLevel < victim->baseLevel)) victim = &e;
+            }
+            if (!victim) return false;
+            EvictLevel(*victim);
+        }
+        return true;
+    }
 
-        // (잔상 효과 코드는 그대로 유지...)
-        if (!trails.empty()) {
-            // ... (기존 코드 생략) ...
-            glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            float alpha = 0.5f;
-            for (auto& t : trails) {
-                glPushMatrix();
-                glTranslatef(t.first.x, t.first.y, t.first.z);
-                glRotatef(rotation.x, 1, 0, 0); glRotatef(rotation.y, 0, 1, 0); glRotatef(rotation.z, 0, 0, 1);
-                glScalef(t.second.x, t.second.y, t.second.z);
-                glColor4f(0.8f, 0.6f, 0.4f, alpha);
-                glutSolidCube(1.0f);
-                glPopMatrix();
-                alpha -= 0.05f;
+    void WorkerLoop() {
+        for (;;) {
+            Job job;
+            {
+                unique_lock<mutex> lock(jobMutex);
+                jobCond.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                auto best = jobs.begin();
+                for (auto it = jobs.begin(); it != jobs.end(); ++it)
+                    if (it->priority > best->priority) best = it;
+                job = move(*best);
+                jobs.erase(best);
             }
-            glDisable(GL_BLEND);
+
+            Result r;
+            r.handle = job.handle;
+            r.level = job.level;
+            r.ok = DecodeLevel(job.files, job.fileWidths, job.width, job.height, job.channels, r.pixels);
+
+            lock_guard<mutex> lock(jobMutex);
+            done.push_back(move(r));
         }
     }
 
-    // 그림자 그리기 (3축 회전 적용)
-    void DrawShadow(float* shadowMat) override {
-        if (!shadowMat) return;
+    bool started, stopping;
+    vector<thread> workers;
+    mutex jobMutex;
+    condition_variable jobCond;
+    vector<Job> jobs;
+    deque<Result> done;
+
+    vector<Entry> entries;      // GL 스레드 전용
+    size_t budget, residentBytes, pendingBytes;
+    unsigned int frame;
+    float pixelScale;
+    int uploadedLevels, evictedLevels, deniedRequests;
+};
+
+MipStreamer mipStreamer;
+
+// -------------------------------------------------------
+// [정적 메쉬] PLY -> 바이너리 캐시 -> VBO
+// -------------------------------------------------------
+// 처음 실행 때 PLY 를 (병렬) 파싱하고 원본 옆 Cache/<파일명>.msh 를 남깁니다.
+// 다음 실행부터는 캐시를 매핑해서 그 메모리를 그대로 glBufferData 에 넘김 (파싱/복사 없음)
+class StaticMesh {
+public:
+    vec3 boundsMin, boundsMax;
+
+    StaticMesh() : boundsMin(0.0f), boundsMax(0.0f), vbo(0), ibo(0), indexCount(0), vertexCount(0), averageEdge(0.0f) {}
+
+    bool Load(const char* plyPath) {
+        return Prepare(plyPath) && Upload();
+    }
+
+    // GL 없이 (워커 스레드에서) 할 수 있는 부분: 캐시 매핑 또는 PLY 파싱 + 캐시 저장, 바운드, 평균 변 길이
+    bool Prepare(const char* plyPath) {
+        auto start = chrono::steady_clock::now();
+        pending = make_shared<Pending>();
+        pending->path = plyPath;
+        string cachePath = MeshCacheFile::CachePathFor(plyPath);
+
+        pending->fromCache = LoadCache(plyPath, cachePath);
+        if (!pending->fromCache) {
+            PlyMesh& mesh = pending->mesh;
+            PlyLoader::PlyLoadError err = PlyLoader::load(plyPath, mesh);
+            if (err != PlyLoader::PLY_NO_ERROR) {
+                cout << "메쉬 로드 실패: " << plyPath << " (error " << err << ")" << endl;
+                pending.reset();
+                return false;
+            }
+
+            string dir = cachePath.substr(0, cachePath.find_last_of('/'));
+#ifdef _WIN32
+            _mkdir(dir.c_str());
+#else
+            mkdir(dir.c_str(), 0755);
+#endif
+            if (!MeshCacheFile::Write(cachePath.c_str(), mesh.vertices.data(), mesh.vertexCount(), mesh.indices.data(), mesh.indices.size()))
+                cout << "메쉬 캐시 저장 실패: " << cachePath << endl;
+
+            float bmin[3], bmax[3];
+            MeshCacheFile::ComputeBounds(mesh.vertices.data(), mesh.vertexCount(), bmin, bmax);
+            boundsMin = vec3(bmin[0], bmin[1], bmin[2]);
+            boundsMax = vec3(bmax[0], bmax[1], bmax[2]);
+            pending->vertices = mesh.vertices.data();
+            pending->vertexBytes = mesh.vertices.size() * sizeof(float);
+            pending->indices = mesh.indices.data();
+            pending->indexCount = mesh.indices.size();
+            vertexCount = (int)mesh.vertexCount();
+        }
+        averageEdge = AverageEdge((const float*)pending->vertices, pending->indices, pending->indexCount);
+        pending->ms = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    // GL 스레드: Prepare 한 버퍼를 VBO/IBO 로 올리고 매핑/파싱 결과를 놓음
+    bool Upload() {
+        if (!pending) return false;
+        auto start = chrono::steady_clock::now();
+        UploadBuffers(pending->vertices, pending->vertexBytes, pending->indices, pending->indexCount);
+
+        float ms = pending->ms + chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+        cout << "[Mesh] " << pending->path << ": " << vertexCount << " verts, " << indexCount / 3 << " tris ("
+            << (pending->fromCache ? "cache" : "parsed") << ", " << ms << " ms)" << endl;
+        pending.reset();
+        return true;
+    }
+
+    // 위치/법선 인터리브 VBO 를 고정 파이프라인 배열로 그림
+    void Draw() const {
+        if (!vbo) return;
+        Bind();
+        DrawBound();
+        Unbind();
+    }
+
+    // 같은 메쉬를 여러 번 그릴 때는 Bind 1번 + DrawBound 여러 번
+    void Bind() const {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(3, GL_FLOAT, MESHCACHE_STRIDE, (const void*)0);
+        glNormalPointer(GL_FLOAT, MESHCACHE_STRIDE, (const void*)(3 * sizeof(float)));
+    }
+
+    void DrawBound() const {
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (const void*)0);
+    }
+
+    static void Unbind() {
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    bool IsLoaded() const { return vbo != 0; }
+    int GetTriangleCount() const { return indexCount / 3; }
+    int GetVertexCount() const { return vertexCount; }
+    float GetAverageEdge() const { return averageEdge; } // 메쉬 좌표계 기준 평균 삼각형 변 길이
+
+private:
+    // 캐시가 있고 원본보다 새것이면 매핑된 메모리에서 바로 업로드 (팩에 든 캐시는 검사 없이)
+    bool LoadCache(const char* plyPath, const string& cachePath) {
+        if (!AssetPack::Mounted() || !AssetPack::Mounted()->contains(cachePath.c_str())) {
+            struct stat cacheStat, sourceStat;
+            if (stat(cachePath.c_str(), &cacheStat) != 0) return false;
+            if (stat(plyPath, &sourceStat) == 0 && sourceStat.st_mtime > cacheStat.st_mtime) return false;
+        }
+
+        MeshCacheFile cache;
+        if (!pending->file.open(cachePath.c_str()) || !cache.parse(pending->file.data(), pending->file.size())) return false;
+
+        const MeshCacheHeader& h = cache.header();
+        boundsMin = vec3(h.boundsMin[0], h.boundsMin[1], h.boundsMin[2]);
+        boundsMax = vec3(h.boundsMax[0], h.boundsMax[1], h.boundsMax[2]);
+        pending->vertices = cache.vertices();
+        pending->vertexBytes = cache.vertexBytes();
+        pending->indices = (const unsigned int*)cache.indices();
+        pending->indexCount = h.indexCount;
+        vertexCount = (int)h.vertexCount;
+        return true;
+    }
+
+    void UploadBuffers(const void* vertices, size_t vertexBytes, const void* indices, size_t count) {
+        if (!vbo) glGenBuffers(1, &vbo);
+        if (!ibo) glGenBuffers(1, &ibo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertexBytes, vertices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        indexCount = (GLsizei)count;
+    }
+
+    static float AverageEdge(const float* v, const unsigned int* idx, size_t count) {
+        if (count < 3) return 0.0f;
+        double sum = 0.0;
+        for (size_t t = 0; t + 2 < count; t += 3) {
+            for (int k = 0; k < 3; k++) {
+                const float* a = v + idx[t + k] * 6;
+                const float* b = v + idx[t + (k + 1) % 3] * 6;
+                sum += sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]));
+            }
+        }
+        return (float)(sum / (count / 3 * 3));
+    }
+
+    // Prepare 와 Upload 사이에만 살아 있음 (캐시 매핑 또는 파싱한 메쉬)
+    struct Pending {
+        string path;
+        MappedFile file;
+        PlyMesh mesh;
+        const void* vertices = NULL;
+        size_t vertexBytes = 0;
+        const unsigned int* indices = NULL;
+        size_t indexCount = 0;
+        bool fromCache = false;
+        float ms = 0.0f;
+    };
+
+    GLuint vbo, ibo;
+    GLsizei indexCount;
+    int vertexCount;
+    float averageEdge;
+    shared_ptr<Pending> pending;
+};
+
+// -------------------------------------------------------
+// [메쉬 LOD] 해상도별 StaticMesh 묶음과 화면 오차 기준 레벨 선택
+// -------------------------------------------------------
+// 레벨의 화면 오차 = 평균 삼각형 변 길이가 화면에서 차지하는 픽셀 수.
+// 오차가 maxErrorPixels 이하인 가장 거친 레벨을 고르되, 경계에서 깜빡이지 않도록
+// 거칠게 갈 때는 (1 - hysteresis), 세밀하게 돌아올 때는 (1 + hysteresis) 배의 여유를 둡니다.
+class MeshLOD {
+public:
+    float maxErrorPixels = 6.0f;
+    float hysteresis = 0.2f;
+
+    // files: 가장 세밀한 레벨부터. 로드에 실패한 레벨은 건너뜀
+    bool Load(const vector<string>& files) {
+        Begin(files);
+        for (int i = 0; i < (int)files.size(); i++) PrepareLevel(i);
+        return Upload();
+    }
+
+    // 나눠서 로드: Begin -> 레벨마다 PrepareLevel (워커 스레드, 레벨끼리 병렬 가능) -> Upload (GL 스레드)
+    void Begin(const vector<string>& files) {
+        levels.assign(files.size(), StaticMesh());
+        levelFiles = files;
+        prepared.assign(files.size(), 0);
+    }
+
+    void PrepareLevel(int i) {
+        prepared[i] = levels[i].Prepare(levelFiles[i].c_str()) ? 1 : 0;
+    }
+
+    bool Upload() {
+        vector<StaticMesh> loaded;
+        for (size_t i = 0; i < levels.size(); i++)
+            if (prepared[i] && levels[i].Upload()) loaded.push_back(levels[i]);
+        levels.swap(loaded);
+        levelFiles.clear();
+        prepared.clear();
+        return !levels.empty();
+    }
+
+    int LevelCount() const { return (int)levels.size(); }
+    const StaticMesh& Level(int i) const { return levels[i]; }
+
+    // pixelsPerUnit: 인스턴스 위치에서 메쉬 좌표 1 단위가 화면에서 차지하는 픽셀 수
+    int SelectLevel(float pixelsPerUnit, int current) const {
+        int last = LevelCount() - 1;
+        if (current < 0 || current > last) current = 0;
+
+        int desired = 0;
+        for (int i = last; i > 0; i--) {
+            if (levels[i].GetAverageEdge() * pixelsPerUnit <= maxErrorPixels) { desired = i; break; }
+        }
+
+        if (desired > current) {
+            // 더 거친 레벨로: 여유 있게 기준 안쪽일 때만
+            for (int i = desired; i > current; i--)
+                if (levels[i].GetAverageEdge() * pixelsPerUnit <= maxErrorPixels * (1.0f - hysteresis)) return i;
+            return current;
+        }
+        if (desired < current) {
+            // 더 세밀한 레벨로: 현재 레벨 오차가 기준을 확실히 넘었을 때만
+            if (levels[current].GetAverageEdge() * pixelsPerUnit > maxErrorPixels * (1.0f + hysteresis)) return desired;
+            return current;
+        }
+        return current;
+    }
+
+private:
+    vector<StaticMesh> levels;
+    vector<string> levelFiles;
+    vector<char> prepared;  // 레벨별 Prepare 성공 여부 (vector<bool> 은 스레드별 쓰기가 안전하지 않음)
+};
+
+// -------------------------------------------------------
+// [LOD 인스턴스 배치] 같은 MeshLOD 를 쓰는 다수의 배치
+// -------------------------------------------------------
+// 매 프레임 인스턴스마다 투영 크기로 레벨을 고르고, 전체 삼각형 수가 triangleBudget 을 넘으면
+// 화면에서 작은 인스턴스부터 한 단계씩 더 거칠게 내립니다. 그릴 때는 레벨별로 VBO 를 한 번만 바인드.
+class MeshLODField {
+public:
+    size_t triangleBudget = 300000;
+
+    MeshLODField() : lod(NULL), trianglesDrawn(0), budgetClamped(0) {}
+
+    void SetLOD(const MeshLOD* l) { lod = l; }
+
+    // height: 월드 높이 (가장 세밀한 레벨의 바운딩 박스 기준)
+    void Add(vec3 pos, float rotY, float height, vec3 color) {
+        if (!lod || lod->LevelCount() == 0) return;
+        const StaticMesh& base = lod->Level(0);
+        float extentY = base.boundsMax.y - base.boundsMin.y;
+
+        Instance inst;
+        inst.position = pos;
+        inst.rotY = rotY;
+        inst.scale = (extentY > 0.0f) ? height / extentY : 1.0f;
+        inst.color = color;
+        inst.level = lod->LevelCount() - 1;
+        inst.pixelsPerUnit = 0.0f;
+        instances.push_back(inst);
+    }
+
+    void Update(const vec3& eye, int viewportHeight, float fovYDegrees) {
+        if (!lod || instances.empty()) return;
+        int levelCount = lod->LevelCount();
+        float focal = viewportHeight / (2.0f * tanf(radians(fovYDegrees) * 0.5f));
+
+        size_t triangles = 0;
+        for (auto& inst : instances) {
+            float dist = std::max(length(inst.position - eye), 0.1f);
+            inst.pixelsPerUnit = focal * inst.scale / dist;
+            inst.level = lod->SelectLevel(inst.pixelsPerUnit, inst.level);
+            triangles += lod->Level(inst.level).GetTriangleCount();
+        }
+
+        // 예산 초과: 화면에서 작은 것부터 한 단계씩 내림
+        budgetClamped = 0;
+        if (triangles > triangleBudget) {
+            order.resize(instances.size());
+            for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+            sort(order.begin(), order.end(), [this](int a, int b) { return instances[a].pixelsPerUnit < instances[b].pixelsPerUnit; });
+
+            for (int step = 0; step < levelCount - 1 && triangles > triangleBudget; step++) {
+                for (int i : order) {
+                    Instance& inst = instances[i];
+                    if (inst.level >= levelCount - 1) continue;
+                    triangles -= lod->Level(inst.level).GetTriangleCount() - lod->Level(inst.level + 1).GetTriangleCount();
+                    inst.level++;
+                    budgetClamped++;
+                    if (triangles <= triangleBudget) break;
+                }
+            }
+        }
+        trianglesDrawn = triangles;
+    }
+
+    void Draw() const {
+        if (!lod || instances.empty()) return;
+        const StaticMesh& base = lod->Level(0);
+        vec3 center = (base.boundsMin + base.boundsMax) * 0.5f;
+        center.y = base.boundsMin.y; // position 은 발 밑 기준
+
+        for (int l = 0; l < lod->LevelCount(); l++) {
+            const StaticMesh& mesh = lod->Level(l);
+            bool bound = false;
+            for (auto& inst : instances) {
+                if (inst.level != l) continue;
+                if (!bound) { mesh.Bind(); bound = true; }
+                glPushMatrix();
+                glTranslatef(inst.position.x, inst.position.y, inst.position.z);
+                glRotatef(inst.rotY, 0, 1, 0);
+                glScalef(inst.scale, inst.scale, inst.scale);
+                glTranslatef(-center.x, -center.y, -center.z);
+                glColor3f(inst.color.r, inst.color.g, inst.color.b);
+                mesh.DrawBound();
+                glPopMatrix();
+            }
+            if (bound) StaticMesh::Unbind();
+        }
+    }
+
+    void PrintStats() const {
+        if (!lod) return;
+        cout << "[MeshLOD] instances: " << instances.size() << ", triangles: " << trianglesDrawn
+            << " (budget " << triangleBudget << ", clamped " << budgetClamped << "), per level:";
+        for (int l = 0; l < lod->LevelCount(); l++) {
+            int n = 0;
+            for (auto& inst : instances) if (inst.level == l) n++;
+            cout << " " << n;
+        }
+        cout << endl;
+    }
+
+private:
+    struct Instance {
+        vec3 position;
+        float rotY;
+        float scale;
+        vec3 color;
+        int level;
+        float pixelsPerUnit;
+    };
+
+    const MeshLOD* lod;
+    vector<Instance> instances;
+    vector<int> order;
+    size_t trianglesDrawn;
+    int budgetClamped;
+};
+
+MeshLOD bunnyLOD;
+MeshLODField bunnyField;
+
+// -------------------------------------------------------
+// [텍스처 메쉬] ASE / 3DS -> 인덱스 버퍼 -> VBO
+// -------------------------------------------------------
+// 위치/법선/UV 인터리브 VBO 하나와 IBO 하나. 서브메쉬(오브젝트 x 재질)마다
+// 디퓨즈 텍스처를 바꿔가며 인덱스 구간만 그립니다. 텍스처는 레지스트리에서 공유.
+// Bind / DrawParts / Unbind 로 나눠 두어서 인스턴싱 셰이더도 같은 버퍼를 씀.
+class TexturedMesh {
+public:
+    vec3 boundsMin, boundsMax;
+
+    TexturedMesh() : boundsMin(0.0f), boundsMax(0.0f), vbo(0), ibo(0), vertexCount(0), triangleCount(0) {}
+
+    // textureDir: 재질의 비트맵 파일 이름 앞에 붙일 폴더 (예: "../Data/")
+    // fallbackTexture: 재질 비트맵이 없거나 폴더에 없을 때 쓸 텍스처 (NULL 이면 텍스처 없음)
+    bool Load(const char* path, const string& textureDir, const char* fallbackTexture = NULL) {
+        return Prepare(path) && Upload(textureDir, fallbackTexture);
+    }
+
+    // GL 없이 (워커 스레드에서) 할 수 있는 부분: 파싱과 바운드
+    bool Prepare(const char* path) {
+        auto start = chrono::steady_clock::now();
+        pending = make_shared<Pending>();
+        pending->path = path;
+        ModelMesh& mesh = pending->mesh;
+        string ext = TextureImage::GetExtension(path);
+        int err, ok;
+        if (ext == ".3ds") {
+            err = Max3dsLoader::load(path, mesh);
+            ok = Max3dsLoader::MAX3DS_NO_ERROR;
+        }
+        else {
+            err = AseLoader::load(path, mesh);
+            ok = AseLoader::ASE_NO_ERROR;
+        }
+        if (err != ok || mesh.indices.empty()) {
+            cout << "모델 로드 실패: " << path << " (error " << err << ")" << endl;
+            pending.reset();
+            return false;
+        }
+
+        boundsMin = boundsMax = vec3(mesh.vertices[0], mesh.vertices[1], mesh.vertices[2]);
+        for (size_t i = 0; i < mesh.vertexCount(); i++) {
+            vec3 p(mesh.vertices[i * 8], mesh.vertices[i * 8 + 1], mesh.vertices[i * 8 + 2]);
+            boundsMin = glm::min(boundsMin, p);
+            boundsMax = glm::max(boundsMax, p);
+        }
+        pending->parseMs = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    // GL 스레드: VBO/IBO 업로드와 재질 텍스처 요청
+    bool Upload(const string& textureDir, const char* fallbackTexture = NULL) {
+        if (!pending) return false;
+        const ModelMesh& mesh = pending->mesh;
+
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ibo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(float), mesh.vertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(unsigned int), mesh.indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        for (auto& sub : mesh.subMeshes) {
+            Part part;
+            part.firstIndex = sub.firstIndex;
+            part.indexCount = (GLsizei)sub.indexCount;
+            string texPath = textureDir + sub.bitmap;
+            if (sub.bitmap.empty() || !AssetExists(texPath.c_str())) texPath = fallbackTexture ? fallbackTexture : "";
+            part.texID = texPath.empty() ? 0 : textureRegistry.Acquire(texPath.c_str());
+            parts.push_back(part);
+        }
+        vertexCount = (int)mesh.vertexCount();
+        triangleCount = (int)mesh.triangleCount();
+
+        cout << "[Mesh] " << pending->path << ": " << vertexCount << " verts, " << triangleCount << " tris, "
+            << parts.size() << " parts (parsed " << pending->parseMs << " ms)" << endl;
+        pending.reset();
+        return true;
+    }
+
+    // 색은 호출자가 정함 (텍스처는 MODULATE 라서 조명/그림자색이 그대로 곱해짐)
+    void Draw() const {
+        if (!vbo) return;
+        Bind();
+        DrawParts(0);
+        Unbind();
+    }
+
+    void Bind() const {
+        const GLsizei stride = MODEL_VERTEX_FLOATS * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glVertexPointer(3, GL_FLOAT, stride, (const void*)0);
+        glNormalPointer(GL_FLOAT, stride, (const void*)(3 * sizeof(float)));
+        glTexCoordPointer(2, GL_FLOAT, stride, (const void*)(6 * sizeof(float)));
+    }
+
+    // instances > 0 이면 파트마다 glDrawElementsInstanced (인스턴스 속성은 호출자가 설정)
+    void DrawParts(GLsizei instances) const {
+        for (auto& part : parts) {
+            if (part.texID) {
+                glEnable(GL_TEXTURE_2D);
+                glBindTexture(GL_TEXTURE_2D, part.texID);
+            }
+            else glDisable(GL_TEXTURE_2D);
+            const void* offset = (const void*)(part.firstIndex * sizeof(unsigned int));
+            if (instances > 0) glDrawElementsInstanced(GL_TRIANGLES, part.indexCount, GL_UNSIGNED_INT, offset, instances);
+            else glDrawElements(GL_TRIANGLES, part.indexCount, GL_UNSIGNED_INT, offset);
+        }
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    static void Unbind() {
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    bool IsLoaded() const { return vbo != 0; }
+    int GetTriangleCount() const { return triangleCount; }
+    int GetVertexCount() const { return vertexCount; }
+
+private:
+    struct Part {
+        size_t firstIndex;
+        GLsizei indexCount;
+        GLuint texID;
+    };
+
+    // Prepare 와 Upload 사이에만 살아 있음
+    struct Pending {
+        string path;
+        ModelMesh mesh;
+        float parseMs = 0.0f;
+    };
+
+    GLuint vbo, ibo;
+    vector<Part> parts;
+    int vertexCount, triangleCount;
+    shared_ptr<Pending> pending;
+};
+
+TexturedMesh statueMesh;
+
+// -------------------------------------------------------
+// [셰이더] GLSL 프로그램 빌드
+// -------------------------------------------------------
+// attribs: 링크 전에 고정할 (위치, 이름). 고정 파이프라인 내장 속성과 겹치지 않게
+// NVIDIA 별칭 표에서 비어 있는 1, 6, 7 번을 씁니다. 실패하면 0 (로그는 콘솔).
+// feedback: 변환 피드백으로 받을 varying 이름 (순서대로 한 버퍼에 교차 배치, GL 3.0)
+GLuint CompileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        cout << "셰이더 컴파일 실패: " << log << endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint BuildProgram(const char* vertexSource, const char* fragmentSource, const vector<pair<GLuint, const char*>>& attribs,
+                    const vector<const char*>& feedback = vector<const char*>()) {
+    GLuint vs = CompileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    for (auto& a : attribs) glBindAttribLocation(program, a.first, a.second);
+    if (!feedback.empty()) glTransformFeedbackVaryings(program, (GLsizei)feedback.size(), feedback.data(), GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        cout << "셰이더 링크 실패: " << log << endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// -------------------------------------------------------
+// [우주선 편대] 3DS 우주선 한 척을 인스턴싱으로 여러 번
+// -------------------------------------------------------
+// 배마다 궤도(반지름, 높이, 각속도, 위상)와 색만 정적 인스턴스 버퍼에 한 번 올리고,
+// 위치/방향은 정점 셰이더가 시간 uniform 으로 계산합니다. (프레임당 CPU 비용 없음)
+// GL 3.3 (glVertexAttribDivisor + glDrawElementsInstanced) 이 없으면 같은 식을
+// CPU 에서 계산해 배마다 glDrawElements 로 그림.
+const char* SHIP_VERTEX_SHADER =
+    "#version 120\n"
+    "uniform float time;\n"
+    "uniform vec3 center;\n"
+    "uniform float scale;\n"
+    "attribute vec4 orbit;   // 반지름, 높이, 각속도(rad/s), 위상\n"
+    "attribute vec4 tint;\n"
+    "varying vec2 uv;\n"
+    "varying vec3 color;\n"
+    "void main() {\n"
+    "    float a = orbit.w + orbit.z * time;\n"
+    "    float dir = sign(orbit.z);\n"
+    "    vec3 pos = center + vec3(cos(a) * orbit.x, orbit.y + sin(a * 3.0 + orbit.w) * 1.5, sin(a) * orbit.x);\n"
+    "    float s = -sin(a) * dir, c = cos(a) * dir;   // 기수(+Z)를 진행 방향으로\n"
+    "    vec3 p = gl_Vertex.xyz * scale;\n"
+    "    vec3 wp = pos + vec3(c * p.x + s * p.z, p.y, -s * p.x + c * p.z);\n"
+    "    vec3 wn = vec3(c * gl_Normal.x + s * gl_Normal.z, gl_Normal.y, -s * gl_Normal.x + c * gl_Normal.z);\n"
+    "    vec4 eyePos = gl_ModelViewMatrix * vec4(wp, 1.0);\n"
+    "    vec3 n = normalize(gl_NormalMatrix * wn);\n"
+    "    vec4 lp = gl_LightSource[0].position;\n"
+    "    vec3 l = normalize(lp.xyz - eyePos.xyz * lp.w);\n"
+    "    color = tint.rgb * (0.35 + 0.65 * max(dot(n, l), 0.0));\n"
+    "    uv = gl_MultiTexCoord0.xy;\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePos;\n"
+    "}\n";
+
+const char* SHIP_FRAGMENT_SHADER =
+    "#version 120\n"
+    "uniform sampler2D diffuse;\n"
+    "varying vec2 uv;\n"
+    "varying vec3 color;\n"
+    "void main() {\n"
+    "    gl_FragColor = texture2D(diffuse, uv) * vec4(color, 1.0);\n"
+    "}\n";
+
+class ShipFleet {
+public:
+    vec3 center = vec3(0.0f, 0.0f, -20.0f);   // 두 방 가운데 위
+
+    ShipFleet() : mesh(NULL), scale(1.0f), instanceVBO(0), program(0) {}
+
+    // length: 월드 기준 배 길이. 편대는 같은 궤도를 간격을 두고 도는 배 묶음
+    void Init(const TexturedMesh* m, int fleets, int shipsPerFleet, float length) {
+        mesh = m;
+        vec3 extent = m->boundsMax - m->boundsMin;
+        scale = (extent.z > 0.0f) ? length / extent.z : 1.0f;
+
+        // rand() 순서를 건드리지 않도록 자체 해시로 궤도를 정함
+        ships.clear();
+        for (int f = 0; f < fleets; f++) {
+            float radius = 35.0f + 35.0f * Hash01(f * 4 + 0);
+            float height = 22.0f + 22.0f * Hash01(f * 4 + 1);
+            float speed = (0.08f + 0.12f * Hash01(f * 4 + 2)) * ((f & 1) ? -1.0f : 1.0f);
+            float phase = 6.2831853f * Hash01(f * 4 + 3);
+            vec3 tint = vec3(0.75f + 0.25f * Hash01(f * 7 + 11), 0.75f + 0.25f * Hash01(f * 7 + 12), 0.75f + 0.25f * Hash01(f * 7 + 13));
+            for (int i = 0; i < shipsPerFleet; i++) {
+                // 편대 안에서는 위상을 배 길이의 두 배만큼씩 뒤로, 좌우로 번갈아 벌림
+                Ship sh;
+                sh.radius = radius + ((i & 1) ? 1.0f : -1.0f) * 1.2f * ((i + 1) / 2);
+                sh.height = height + 0.4f * ((i + 1) / 2);
+                sh.speed = speed;
+                sh.phase = phase - (speed > 0.0f ? 1.0f : -1.0f) * (2.0f * length * ((i + 1) / 2)) / radius;
+                sh.tint = tint;
+                ships.push_back(sh);
+            }
+        }
+
+        if (GLEW_VERSION_3_3) {
+            vector<pair<GLuint, const char*>> attribs;
+            attribs.push_back(make_pair((GLuint)ATTRIB_ORBIT, "orbit"));
+            attribs.push_back(make_pair((GLuint)ATTRIB_TINT, "tint"));
+            program = BuildProgram(SHIP_VERTEX_SHADER, SHIP_FRAGMENT_SHADER, attribs);
+        }
+        if (program) {
+            vector<float> data;
+            data.reserve(ships.size() * 8);
+            for (auto& sh : ships) {
+                float v[8] = { sh.radius, sh.height, sh.speed, sh.phase, sh.tint.r, sh.tint.g, sh.tint.b, 1.0f };
+                data.insert(data.end(), v, v + 8);
+            }
+            glGenBuffers(1, &instanceVBO);
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        cout << "[Fleet] " << ships.size() << " ships (" << (program ? "instanced" : "fallback") << ")" << endl;
+    }
+
+    void Draw(float time) const {
+        if (!mesh || !mesh->IsLoaded() || ships.empty()) return;
+
+        if (program) {
+            glUseProgram(program);
+            glUniform1f(glGetUniformLocation(program, "time"), time);
+            glUniform3f(glGetUniformLocation(program, "center"), center.x, center.y, center.z);
+            glUniform1f(glGetUniformLocation(program, "scale"), scale);
+            glUniform1i(glGetUniformLocation(program, "diffuse"), 0);
+
+            mesh->Bind();
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            glEnableVertexAttribArray(ATTRIB_ORBIT);
+            glEnableVertexAttribArray(ATTRIB_TINT);
+            glVertexAttribPointer(ATTRIB_ORBIT, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (const void*)0);
+            glVertexAttribPointer(ATTRIB_TINT, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (const void*)(4 * sizeof(float)));
+            glVertexAttribDivisor(ATTRIB_ORBIT, 1);
+            glVertexAttribDivisor(ATTRIB_TINT, 1);
+
+            mesh->DrawParts((GLsizei)ships.size());
+
+            glVertexAttribDivisor(ATTRIB_ORBIT, 0);
+            glVertexAttribDivisor(ATTRIB_TINT, 0);
+            glDisableVertexAttribArray(ATTRIB_ORBIT);
+            glDisableVertexAttribArray(ATTRIB_TINT);
+            TexturedMesh::Unbind();
+            glUseProgram(0);
+            return;
+        }
+
+        // 셰이더와 같은 식을 CPU 에서
+        mesh->Bind();
+        for (auto& sh : ships) {
+            float a = sh.phase + sh.speed * time;
+            float dir = (sh.speed < 0.0f) ? -1.0f : 1.0f;
+            float yaw = degrees(atan2(-sin(a) * dir, cos(a) * dir));
+            glPushMatrix();
+            glTranslatef(center.x + cos(a) * sh.radius, center.y + sh.height + sin(a * 3.0f + sh.phase) * 1.5f, center.z + sin(a) * sh.radius);
+            glRotatef(yaw, 0, 1, 0);
+            glScalef(scale, scale, scale);
+            glColor3f(sh.tint.r, sh.tint.g, sh.tint.b);
+            mesh->DrawParts(0);
+            glPopMatrix();
+        }
+        TexturedMesh::Unbind();
+    }
+
+    int GetShipCount() const { return (int)ships.size(); }
+
+private:
+    enum { ATTRIB_ORBIT = 6, ATTRIB_TINT = 7 };
+
+    struct Ship {
+        float radius, height, speed, phase;
+        vec3 tint;
+    };
+
+    static float Hash01(unsigned int n) {
+        n = (n ^ 61u) ^ (n >> 16);
+        n *= 9u;
+        n ^= n >> 4;
+        n *= 0x27d4eb2du;
+        n ^= n >> 15;
+        return (n & 0xFFFFFF) / 16777216.0f;
+    }
+
+    const TexturedMesh* mesh;
+    vector<Ship> ships;
+    float scale;
+    GLuint instanceVBO, program;
+};
+
+TexturedMesh shipMesh;
+ShipFleet shipFleet;
+
+// -------------------------------------------------------
+// [모프 무리] Sphere/Torus/Tube 점 집합을 섞는 점 구름 인스턴스 여러 개
+// -------------------------------------------------------
+// 매 프레임 인스턴스마다 가중치를 정해 AVX2/FMA 커널로 섞고, 결과를 VBO 에 바로 씁니다.
+// VBO 는 한 프레임 분량 3칸짜리 링이고, GL 4.4 (ARB_buffer_storage) 면 영구 매핑해서
+// 펜스로 GPU 가 다 쓴 칸만 다시 채움. 아니면 CPU 배열에 섞은 뒤 glBufferSubData.
+// 한 칸 안의 배치는 SoA: [x (인스턴스 x P)] [y ...] [z ...] 라서 셰이더가 평면마다
+// float 속성 하나씩 읽고, 패딩 정점을 빼려고 인스턴스 구간을 glMultiDrawArrays 한 번에 그림.
+const char* MORPH_VERTEX_SHADER =
+    "#version 120\n"
+    "attribute float px;\n"
+    "attribute float py;\n"
+    "attribute float pz;\n"
+    "uniform float baseY;\n"
+    "varying vec3 color;\n"
+    "void main() {\n"
+    "    color = mix(vec3(0.2, 0.4, 1.0), vec3(0.6, 1.0, 1.0), clamp((py - baseY) * 0.25, 0.0, 1.0));\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(px, py, pz, 1.0);\n"
+    "}\n";
+
+const char* MORPH_FRAGMENT_SHADER =
+    "#version 120\n"
+    "varying vec3 color;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(color, 1.0);\n"
+    "}\n";
+
+class MorphSwarm {
+public:
+    float morphSpeed = 0.25f;   // 초당 모양 전환 횟수
+
+    MorphSwarm() : targets(NULL), instanceCount(0), scale(1.0f), frameFloats(0), vbo(0), program(0), mapped(NULL), section(0), blendMs(0.0f) {
+        for (int i = 0; i < SECTIONS; i++) fences[i] = 0;
+    }
+
+    // gridW x gridH 인스턴스를 origin 부터 spacing 간격으로
+    void Init(const MorphTargets* t, int gridW, int gridH, float spacing, vec3 origin, float size) {
+        targets = t;
+        instances.clear();
+        for (int z = 0; z < gridH; z++) {
+            for (int x = 0; x < gridW; x++) {
+                Instance inst;
+                inst.position = origin + vec3(x * spacing, 0.0f, z * spacing);
+                inst.phase = (float)((x * 7 + z * 13) % 29) / 29.0f * t->targetCount();
+                instances.push_back(inst);
+            }
+        }
+        instanceCount = (int)instances.size();
+        scale = size / 5.0f;    // 점 집합은 대략 지름 5
+
+        size_t padded = targets->paddedCount();
+        frameFloats = padded * 3 * instanceCount;
+        for (int i = 0; i < instanceCount; i++) {
+            firsts.push_back((GLint)(i * padded));
+            counts.push_back((GLsizei)targets->vertexCount());
+        }
+
+        vector<pair<GLuint, const char*>> attribs;
+        attribs.push_back(make_pair((GLuint)ATTRIB_X, "px"));
+        attribs.push_back(make_pair((GLuint)ATTRIB_Y, "py"));
+        attribs.push_back(make_pair((GLuint)ATTRIB_Z, "pz"));
+        if (GLEW_VERSION_2_0) program = BuildProgram(MORPH_VERTEX_SHADER, MORPH_FRAGMENT_SHADER, attribs);
+        if (!program) return;
+
+        size_t bytes = frameFloats * sizeof(float) * SECTIONS;
+        glGenBuffers(1, &vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_ARRAY_BUFFER, bytes, NULL, flags);
+            mapped = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags);
+        }
+        if (!mapped) {
+            glBufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+            staging.resize(frameFloats);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        cout << "[Morph] " << instanceCount << " instances x " << targets->vertexCount() << " points, "
+            << targets->targetCount() << " targets (" << (mapped ? "persistent map" : "glBufferSubData") << ", "
+            << (CpuFeatures::get().avx2 && CpuFeatures::get().fma ? "AVX2/FMA" : "scalar") << ")" << endl;
+    }
+
+    void Draw(float time) {
+        if (!program || instanceCount == 0) return;
+
+        // 이번 칸을 GPU 가 아직 읽고 있으면 기다림 (3칸이라 보통은 바로 통과)
+        if (fences[section]) {
+            glClientWaitSync(fences[section], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            glDeleteSync(fences[section]);
+            fences[section] = 0;
+        }
+
+        auto start = chrono::steady_clock::now();
+        float* dst = mapped ? mapped + frameFloats * section : staging.data();
+        Blend(time, dst);
+        blendMs = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+
+        size_t sectionBytes = frameFloats * sizeof(float);
+        size_t base = sectionBytes * section;
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        if (!mapped) glBufferSubData(GL_ARRAY_BUFFER, base, sectionBytes, dst);
+
+        size_t planeBytes = sectionBytes / 3;
+        glUseProgram(program);
+        glUniform1f(glGetUniformLocation(program, "baseY"), instances[0].position.y - 2.5f * scale);
+        glEnableVertexAttribArray(ATTRIB_X);
+        glEnableVertexAttribArray(ATTRIB_Y);
+        glEnableVertexAttribArray(ATTRIB_Z);
+        glVertexAttribPointer(ATTRIB_X, 1, GL_FLOAT, GL_FALSE, 0, (const void*)base);
+        glVertexAttribPointer(ATTRIB_Y, 1, GL_FLOAT, GL_FALSE, 0, (const void*)(base + planeBytes));
+        glVertexAttribPointer(ATTRIB_Z, 1, GL_FLOAT, GL_FALSE, 0, (const void*)(base + planeBytes * 2));
+        glPointSize(2.0f);
+        glMultiDrawArrays(GL_POINTS, firsts.data(), counts.data(), instanceCount);
+        glPointSize(1.0f);
+        glDisableVertexAttribArray(ATTRIB_X);
+        glDisableVertexAttribArray(ATTRIB_Y);
+        glDisableVertexAttribArray(ATTRIB_Z);
+        glUseProgram(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        if (mapped) fences[section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        section = (section + 1) % SECTIONS;
+    }
+
+    int GetInstanceCount() const { return instanceCount; }
+    float GetBlendMs() const { return blendMs; }   // 마지막 프레임의 CPU 섞기 시간
+
+private:
+    enum { SECTIONS = 3, ATTRIB_X = 0, ATTRIB_Y = 6, ATTRIB_Z = 7 };
+
+    struct Instance {
+        vec3 position;
+        float phase;    // 타깃 번호 단위 시작 위치
+    };
+
+    // 인스턴스마다 인접한 두 타깃 사이를 smoothstep 으로 오감. 크기는 offset 대신
+    // 가중치 합으로 반영 (w * scale), 위치는 bias 로
+    void Blend(float time, float* dst) const {
+        int n = targets->targetCount();
+        size_t padded = targets->paddedCount();
+        size_t plane = padded * instanceCount;
+        float weights[MorphBlend::MAX_TARGETS];
+
+        for (int i = 0; i < instanceCount; i++) {
+            const Instance& inst = instances[i];
+            float pos = fmodf(inst.phase + time * morphSpeed, (float)n);
+            int from = (int)pos;
+            float f = pos - from;
+            f = f * f * (3.0f - 2.0f * f);
+            for (int t = 0; t < n; t++) weights[t] = 0.0f;
+            weights[from % n] += (1.0f - f) * scale;
+            weights[(from + 1) % n] += f * scale;
+
+            float offset[3] = { inst.position.x, inst.position.y, inst.position.z };
+            float* out = dst + i * padded;
+            targets->blend(weights, offset, out, out + plane, out + plane * 2);
+        }
+    }
+
+    const MorphTargets* targets;
+    vector<Instance> instances;
+    int instanceCount;
+    float scale;
+    size_t frameFloats;
+    vector<GLint> firsts;
+    vector<GLsizei> counts;
+
+    GLuint vbo, program;
+    float* mapped;
+    vector<float> staging;
+    GLsync fences[SECTIONS];
+    int section;
+    float blendMs;
+};
+
+MorphTargets morphTargets;
+MorphSwarm morphSwarm;
+
+// -------------------------------------------------------
+// [시야 절두체] 현재 GL 투영 x 모델뷰 행렬에서 평면 6개 추출
+// -------------------------------------------------------
+// 평면은 (a, b, c, d) 로 a*x + b*y + c*z + d >= 0 이 안쪽. 정규화는 하지 않음 (부호만 봄)
+struct Frustum {
+    float planes[6][4];
+
+    void FromCurrentMatrices() {
+        float proj[16], view[16], m[16];
+        glGetFloatv(GL_PROJECTION_MATRIX, proj);
+        glGetFloatv(GL_MODELVIEW_MATRIX, view);
+        for (int c = 0; c < 4; c++)
+            for (int r = 0; r < 4; r++)
+                m[c * 4 + r] = proj[r] * view[c * 4] + proj[4 + r] * view[c * 4 + 1] + proj[8 + r] * view[c * 4 + 2] + proj[12 + r] * view[c * 4 + 3];
+
+        // 왼/오른, 아래/위, 가까운/먼 = 4번째 행 +- 1/2/3번째 행
+        for (int i = 0; i < 6; i++) {
+            int row = i / 2;
+            float sign = (i & 1) ? -1.0f : 1.0f;
+            for (int k = 0; k < 4; k++) planes[i][k] = m[k * 4 + 3] + sign * m[k * 4 + row];
+        }
+    }
+
+    // 상자가 어느 한 평면의 완전히 바깥이면 false (가장 안쪽 꼭짓점으로 검사)
+    bool IntersectsBox(vec3 boxMin, vec3 boxMax) const {
+        for (int i = 0; i < 6; i++) {
+            const float* p = planes[i];
+            float x = (p[0] >= 0.0f) ? boxMax.x : boxMin.x;
+            float y = (p[1] >= 0.0f) ? boxMax.y : boxMin.y;
+            float z = (p[2] >= 0.0f) ? boxMax.z : boxMin.z;
+            if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) return false;
+        }
+        return true;
+    }
+};
+
+// -------------------------------------------------------
+// [지형] Terrain.raw 쿼드트리 CDLOD
+// -------------------------------------------------------
+// 높이장 전체를 GL_R32F 텍스처로 올리고, 모든 노드가 N x N 격자 VBO 하나를 공유합니다.
+// 노드 선택: 레벨 L 노드는 눈에서 ranges[L] 안에 있을 때만 그릴 수 있고, ranges[L-1]
+// 안으로 들어오면 자식으로 내려감. 자식이 범위 밖인 사분면은 부모 격자의 그 사분면만 그림.
+// 절두체 밖 노드는 자식까지 통째로 버림 (노드 AABB 는 레벨별 최소/최대 높이 표).
+// 정점 셰이더는 ranges[L] 끝 부분에서 홀수 격자점을 짝수 쪽으로 당겨(모프) 부모 격자와
+// 이어지게 하므로 레벨 경계에 틈이나 튐이 없음. 높이는 CPU 질의(HeightField)와 같은 바이리니어.
+const char* TERRAIN_VERTEX_SHADER =
+    "#version 120\n"
+    "uniform sampler2D heightMap;\n"
+    "uniform vec4 node;         // 월드 x, z, 한 변 길이, 격자 칸 수\n"
+    "uniform vec2 morphRange;   // 이 레벨의 모프 시작/끝 거리\n"
+    "uniform vec3 eye;\n"
+    "uniform vec4 terrain;      // 원점 x, z, 한 변 길이, 1 / 샘플 수\n"
+    "varying vec3 color;\n"
+    "float HeightAt(vec2 xz) {\n"
+    "    vec2 uv = (xz - terrain.xy) / terrain.z + 0.5 * terrain.w;\n"
+    "    return texture2DLod(heightMap, uv, 0.0).r;\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 g = gl_Vertex.xy;\n"
+    "    float cell = node.z / node.w;\n"
+    "    vec2 xz = node.xy + g * cell;\n"
+    "    float d = distance(eye, vec3(xz.x, HeightAt(xz), xz.y));\n"
+    "    float k = clamp((d - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);\n"
+    "    g -= fract(g * 0.5) * 2.0 * k;\n"
+    "    xz = node.xy + g * cell;\n"
+    "    float h = HeightAt(xz);\n"
+    "    float e = terrain.z * terrain.w;\n"
+    "    vec3 wn = normalize(vec3(HeightAt(xz - vec2(e, 0.0)) - HeightAt(xz + vec2(e, 0.0)), 2.0 * e,\n"
+    "                             HeightAt(xz - vec2(0.0, e)) - HeightAt(xz + vec2(0.0, e))));\n"
+    "    vec3 ground = mix(vec3(0.42, 0.36, 0.26), vec3(0.28, 0.45, 0.22), clamp((h + 10.0) * 0.15, 0.0, 1.0));\n"
+    "    vec3 albedo = mix(vec3(0.45, 0.43, 0.40), ground, smoothstep(0.7, 0.9, wn.y));\n"
+    "    vec4 eyePos = gl_ModelViewMatrix * vec4(xz.x, h, xz.y, 1.0);\n"
+    "    vec3 n = normalize(gl_NormalMatrix * wn);\n"
+    "    vec4 lp = gl_LightSource[0].position;\n"
+    "    vec3 l = normalize(lp.xyz - eyePos.xyz * lp.w);\n"
+    "    color = albedo * (0.35 + 0.65 * max(dot(n, l), 0.0));\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePos;\n"
+    "}\n";
+
+const char* TERRAIN_FRAGMENT_SHADER =
+    "#version 120\n"
+    "varying vec3 color;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(color, 1.0);\n"
+    "}\n";
+
+class TerrainCDLOD {
+public:
+    TerrainCDLOD() : field(NULL), levels(0), grid(0), cellSize(1.0f), heightTex(0), gridVBO(0), gridIBO(0), program(0), drawnNodes(0), culledNodes(0) {}
+
+    // levelCount: LOD 레벨 수. 가장 세밀한 레벨이 샘플 하나당 격자 한 칸이 되도록 격자 크기를 정함
+    // finestRange: 레벨 0 을 그리는 거리, 위 레벨로 갈수록 두 배
+    bool Init(const HeightField* f, int levelCount, float finestRange) {
+        field = f;
+        levels = levelCount;
+        grid = f->size() >> (levels - 1);
+        cellSize = f->worldSize() / f->size();
+        if (grid < 2 || grid > 128 || (grid << (levels - 1)) != f->size()) {
+            cout << "[Terrain] 높이맵 크기가 " << levels << " 레벨로 나누어지지 않습니다" << endl;
+            return false;
+        }
+        if (!GLEW_VERSION_3_0) {
+            cout << "[Terrain] GL 3.0 (float 텍스처 + 정점 텍스처) 이 없어 지형을 그리지 않습니다" << endl;
+            return false;
+        }
+
+        vector<pair<GLuint, const char*>> attribs;
+        program = BuildProgram(TERRAIN_VERTEX_SHADER, TERRAIN_FRAGMENT_SHADER, attribs);
+        if (!program) return false;
+
+        BuildMinMax();
+        ranges.resize(levels);
+        for (int l = 0; l < levels; l++) ranges[l] = finestRange * (float)(1 << l);
+
+        glGenTextures(1, &heightTex);
+        glBindTexture(GL_TEXTURE_2D, heightTex);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, f->size(), f->size(), 0, GL_RED, GL_FLOAT, f->data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        BuildGrid();
+        cout << "[Terrain] " << f->size() << "x" << f->size() << ", " << levels << " LOD levels, "
+            << grid << "x" << grid << " grid per node" << endl;
+        return true;
+    }
+
+    void Draw(const vec3& eye) {
+        drawnNodes = culledNodes = 0;
+        if (!program) return;
+
+        Frustum frustum;
+        frustum.FromCurrentMatrices();
+        selection.clear();
+        if (!Select(levels - 1, 0, 0, frustum, eye)) selection.push_back(Selected{ levels - 1, 0, 0, 15 });
+
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "heightMap"), 0);
+        glUniform3f(glGetUniformLocation(program, "eye"), eye.x, eye.y, eye.z);
+        glUniform4f(glGetUniformLocation(program, "terrain"), field->originX(), field->originZ(), field->worldSize(), 1.0f / field->size());
+        GLint nodeLoc = glGetUniformLocation(program, "node");
+        GLint morphLoc = glGetUniformLocation(program, "morphRange");
+
+        glBindTexture(GL_TEXTURE_2D, heightTex);
+        glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gridIBO);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 0, (const void*)0);
+
+        GLsizei quarter = (GLsizei)(grid * grid / 4 * 6);
+        for (auto& s : selection) {
+            int samples = grid << s.level;
+            float size = samples * cellSize;
+            // 모프는 ranges 의 마지막 30% 구간에서 (레벨 0 도 같은 비율)
+            float end = ranges[s.level];
+            float start = end - (end - (s.level ? ranges[s.level - 1] : 0.0f)) * 0.3f;
+            glUniform4f(nodeLoc, field->originX() + s.x * size, field->originZ() + s.z * size, size, (float)grid);
+            glUniform2f(morphLoc, start, end);
+            if (s.quadrants == 15) {
+                glDrawElements(GL_TRIANGLES, quarter * 4, GL_UNSIGNED_SHORT, (const void*)0);
+                continue;
+            }
+            for (int q = 0; q < 4; q++)
+                if (s.quadrants & (1 << q))
+                    glDrawElements(GL_TRIANGLES, quarter, GL_UNSIGNED_SHORT, (const void*)(q * quarter * sizeof(GLushort)));
+        }
+        drawnNodes = (int)selection.size();
+
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glUseProgram(0);
+    }
+
+    int GetDrawnNodes() const { return drawnNodes; }     // 마지막 프레임에 그린 노드 수
+    int GetCulledNodes() const { return culledNodes; }   // 절두체 밖이라 버린 노드 수
+
+private:
+    struct Selected {
+        int level, x, z;
+        int quadrants;   // 그릴 사분면 비트 (1: -x-z, 2: +x-z, 4: -x+z, 8: +x+z)
+    };
+
+    // 레벨 L 노드 (x, z) 의 최소/최대 높이. 레벨 0 은 블록 스캔, 위로는 자식 4개를 합침
+    void BuildMinMax() {
+        minMax.assign(levels, vector<vec2>());
+        int n = field->size() / grid;
+        minMax[0].resize(n * n);
+        for (int z = 0; z < n; z++)
+            for (int x = 0; x < n; x++)
+                field->blockMinMax(x * grid, z * grid, grid, minMax[0][z * n + x].x, minMax[0][z * n + x].y);
+        for (int l = 1; l < levels; l++) {
+            int child = n;
+            n /= 2;
+            minMax[l].resize(n * n);
+            for (int z = 0; z < n; z++) {
+                for (int x = 0; x < n; x++) {
+                    const vec2* c = &minMax[l - 1][(z * 2) * child + x * 2];
+                    vec2& m = minMax[l][z * n + x];
+                    m.x = std::min(std::min(c[0].x, c[1].x), std::min(c[child].x, c[child + 1].x));
+                    m.y = std::max(std::max(c[0].y, c[1].y), std::max(c[child].y, c[child + 1].y));
+                }
+            }
+        }
+    }
+
+    // (grid+1)^2 정점의 격자 좌표, 인덱스는 사분면별로 연속 (부분 노드를 범위 하나로 그리려고)
+    void BuildGrid() {
+        vector<float> verts;
+        verts.reserve((grid + 1) * (grid + 1) * 2);
+        for (int z = 0; z <= grid; z++)
+            for (int x = 0; x <= grid; x++) { verts.push_back((float)x); verts.push_back((float)z); }
+
+        vector<GLushort> indices;
+        indices.reserve(grid * grid * 6);
+        int half = grid / 2;
+        for (int q = 0; q < 4; q++) {
+            int x0 = (q & 1) * half, z0 = (q >> 1) * half;
+            for (int z = z0; z < z0 + half; z++) {
+                for (int x = x0; x < x0 + half; x++) {
+                    GLushort a = (GLushort)(z * (grid + 1) + x), b = a + 1;
+                    GLushort c = (GLushort)(a + grid + 1), d = c + 1;
+                    GLushort tri[6] = { a, c, b, b, c, d };
+                    indices.insert(indices.end(), tri, tri + 6);
+                }
+            }
+        }
+
+        glGenBuffers(1, &gridVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
+        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glGenBuffers(1, &gridIBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gridIBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    void NodeBox(int level, int x, int z, vec3& boxMin, vec3& boxMax) const {
+        float size = (grid << level) * cellSize;
+        const vec2& h = minMax[level][z * (field->size() / (grid << level)) + x];
+        boxMin = vec3(field->originX() + x * size, h.x, field->originZ() + z * size);
+        boxMax = vec3(boxMin.x + size, h.y, boxMin.z + size);
+    }
+
+    static bool InRange(const vec3& boxMin, const vec3& boxMax, const vec3& eye, float range) {
+        vec3 d = max(max(boxMin - eye, eye - boxMax), vec3(0.0f));
+        return dot(d, d) <= range * range;
+    }
+
+    // false 면 이 노드가 이 레벨의 범위 밖 -> 부모가 그 영역을 자기 격자로 그림
+    bool Select(int level, int x, int z, const Frustum& frustum, const vec3& eye) {
+        vec3 boxMin, boxMax;
+        NodeBox(level, x, z, boxMin, boxMax);
+        if (!InRange(boxMin, boxMax, eye, ranges[level])) return false;
+        if (!frustum.IntersectsBox(boxMin, boxMax)) {
+            culledNodes++;
+            return true;
+        }
+        if (level == 0 || !InRange(boxMin, boxMax, eye, ranges[level - 1])) {
+            selection.push_back(Selected{ level, x, z, 15 });
+            return true;
+        }
+
+        int parentQuadrants = 0;
+        for (int q = 0; q < 4; q++)
+            if (!Select(level - 1, x * 2 + (q & 1), z * 2 + (q >> 1), frustum, eye)) parentQuadrants |= 1 << q;
+        if (parentQuadrants) selection.push_back(Selected{ level, x, z, parentQuadrants });
+        return true;
+    }
+
+    const HeightField* field;
+    int levels, grid;
+    float cellSize;
+    vector<float> ranges;
+    vector<vector<vec2>> minMax;
+    vector<Selected> selection;
+
+    GLuint heightTex, gridVBO, gridIBO, program;
+    int drawnNodes, culledNodes;
+};
+
+HeightField terrainField;
+TerrainCDLOD terrain;
+
+// -------------------------------------------------------
+// [물] Water.ini 격자의 물결 시뮬레이션을 반투명 면으로
+// -------------------------------------------------------
+// 격자 좌표(열, 행)는 정적 VBO 로 한 번, 높이/법선 평면(SoA)은 스트리밍 VBO 에
+// 시뮬레이션이 바뀌었다고 알려준 행 구간만 glBufferSubData 로 올립니다.
+// 정점 속성 위치는 편대/모프와 같이 비어 있는 1, 6, 7 번.
+const char* WATER_VERTEX_SHADER =
+    "#version 120\n"
+    "attribute float height;\n"
+    "attribute float nx;\n"
+    "attribute float nz;\n"
+    "uniform vec3 origin;\n"
+    "uniform vec3 cell;         // x 칸, z 칸, 높이 배율\n"
+    "varying vec2 uv;\n"
+    "varying vec3 normal;\n"
+    "varying vec3 eyePos;\n"
+    "void main() {\n"
+    "    vec3 wp = origin + vec3(gl_Vertex.x * cell.x, height * cell.z, gl_Vertex.y * cell.y);\n"
+    "    vec3 wn = vec3(nx * cell.z / (2.0 * cell.x), 1.0, nz * cell.z / (2.0 * cell.y));\n"
+    "    normal = gl_NormalMatrix * wn;\n"
+    "    vec4 e = gl_ModelViewMatrix * vec4(wp, 1.0);\n"
+    "    eyePos = e.xyz;\n"
+    "    uv = gl_Vertex.xy * 0.0625;\n"
+    "    gl_Position = gl_ProjectionMatrix * e;\n"
+    "}\n";
+
+const char* WATER_FRAGMENT_SHADER =
+    "#version 120\n"
+    "uniform sampler2D diffuse;\n"
+    "uniform float alpha;\n"
+    "varying vec2 uv;\n"
+    "varying vec3 normal;\n"
+    "varying vec3 eyePos;\n"
+    "void main() {\n"
+    "    vec3 n = normalize(normal);\n"
+    "    vec4 lp = gl_LightSource[0].position;\n"
+    "    vec3 l = normalize(lp.xyz - eyePos * lp.w);\n"
+    "    vec3 v = normalize(-eyePos);\n"
+    "    float spec = pow(max(dot(reflect(-l, n), v), 0.0), 32.0);\n"
+    "    vec3 base = texture2D(diffuse, uv + n.xz * 0.05).rgb * vec3(0.55, 0.75, 1.0);\n"
+    "    gl_FragColor = vec4(base * (0.35 + 0.65 * max(dot(n, l), 0.0)) + vec3(spec), alpha);\n"
+    "}\n";
+
+class WaterSurface {
+public:
+    float heightScale = 0.3f;   // 시뮬레이션 높이 1 당 월드 높이
+
+    WaterSurface() : sim(NULL), origin(0.0f), cellX(1.0f), cellZ(1.0f), alpha(1.0f), dropRadius(2.0f), dropPower(1.0f),
+        dropChance(0.0f), seed(12345u), gridVBO(0), streamVBO(0), ibo(0), indexCount(0), program(0), texture(0), stepMs(0.0f) {}
+
+    // origin: 격자 (0, 0) 의 월드 위치, size: x/z 한 변 길이
+    void Init(WaterSim* s, const WaterConfig& cfg, vec3 worldOrigin, float size) {
+        sim = s;
+        origin = worldOrigin;
+        cellX = size / (s->gridX() - 1);
+        cellZ = size / (s->gridZ() - 1);
+        alpha = (cfg.blend == 0) ? 0.35f : (cfg.blend == 1 ? 0.7f : 1.0f);
+        dropRadius = (float)cfg.radius;
+        dropPower = cfg.power;
+        dropChance = cfg.frequency * 3.0f * 0.016f;   // FREQUENCY 1 = 초당 3방울 (16ms 타이머 기준)
+
+        vector<pair<GLuint, const char*>> attribs;
+        attribs.push_back(make_pair((GLuint)ATTRIB_HEIGHT, "height"));
+        attribs.push_back(make_pair((GLuint)ATTRIB_NX, "nx"));
+        attribs.push_back(make_pair((GLuint)ATTRIB_NZ, "nz"));
+        if (GLEW_VERSION_2_0) program = BuildProgram(WATER_VERTEX_SHADER, WATER_FRAGMENT_SHADER, attribs);
+        if (!program) {
+            cout << "[Water] 셰이더가 없어 물을 그리지 않습니다" << endl;
+            return;
+        }
+
+        // 정점 번호 = 행 * stride + 열 (패딩 열은 인덱스가 가리키지 않음)
+        int gx = s->gridX(), gz = s->gridZ();
+        size_t stride = s->stride();
+        vector<float> grid(stride * gz * 2, 0.0f);
+        for (int r = 0; r < gz; r++)
+            for (int c = 0; c < gx; c++) {
+                grid[(r * stride + c) * 2] = (float)c;
+                grid[(r * stride + c) * 2 + 1] = (float)r;
+            }
+        vector<GLuint> indices;
+        indices.reserve((size_t)(gx - 1) * (gz - 1) * 6);
+        for (int r = 0; r < gz - 1; r++)
+            for (int c = 0; c < gx - 1; c++) {
+                GLuint a = (GLuint)(r * stride + c), b = a + 1, d = (GLuint)(a + stride), e = d + 1;
+                GLuint tri[6] = { a, d, b, b, d, e };
+                indices.insert(indices.end(), tri, tri + 6);
+            }
+        indexCount = (GLsizei)indices.size();
+
+        glGenBuffers(1, &gridVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
+        glBufferData(GL_ARRAY_BUFFER, grid.size() * sizeof(float), grid.data(), GL_STATIC_DRAW);
+        glGenBuffers(1, &streamVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, streamVBO);
+        glBufferData(GL_ARRAY_BUFFER, stride * gz * 3 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glGenBuffers(1, &ibo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        texture = textureStreamer.Request("../Data/WaterD.bmp", GL_REPEAT);
+        cout << "[Water] " << gx << "x" << gz << " grid, " << s->threadCount() << " band thread(s), "
+            << (CpuFeatures::get().avx2 ? "AVX" : "SSE2/scalar") << endl;
+    }
+
+    // 타이머에서 한 번: 무작위 물방울 (rand() 순서를 건드리지 않게 자체 LCG) + 한 단계
+    void Update() {
+        if (!sim || !program) return;
+        if (NextRandom() < dropChance)
+            sim->Drop(1.0f + NextRandom() * (sim->gridX() - 3), 1.0f + NextRandom() * (sim->gridZ() - 3), dropRadius, dropPower);
+        auto start = chrono::steady_clock::now();
+        sim->Step();
+        stepMs = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    void Draw() {
+        if (!sim || !program) return;
+
+        // 바뀐 행만 평면마다 올림
+        size_t stride = sim->stride();
+        size_t planeBytes = stride * sim->gridZ() * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, streamVBO);
+        if (sim->dirtyEnd() > sim->dirtyBegin()) {
+            size_t offset = sim->dirtyBegin() * stride, count = (sim->dirtyEnd() - sim->dirtyBegin()) * stride;
+            const float* planes[3] = { sim->heights(), sim->normalX(), sim->normalZ() };
+            for (int k = 0; k < 3; k++)
+                glBufferSubData(GL_ARRAY_BUFFER, planeBytes * k + offset * sizeof(float), count * sizeof(float), planes[k] + offset);
+            sim->clearDirty();
+        }
+
+        glUseProgram(program);
+        glUniform3f(glGetUniformLocation(program, "origin"), origin.x, origin.y, origin.z);
+        glUniform3f(glGetUniformLocation(program, "cell"), cellX, cellZ, heightScale);
+        glUniform1f(glGetUniformLocation(program, "alpha"), alpha);
+        glUniform1i(glGetUniformLocation(program, "diffuse"), 0);
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        glEnableVertexAttribArray(ATTRIB_HEIGHT);
+        glEnableVertexAttribArray(ATTRIB_NX);
+        glEnableVertexAttribArray(ATTRIB_NZ);
+        glVertexAttribPointer(ATTRIB_HEIGHT, 1, GL_FLOAT, GL_FALSE, 0, (const void*)0);
+        glVertexAttribPointer(ATTRIB_NX, 1, GL_FLOAT, GL_FALSE, 0, (const void*)planeBytes);
+        glVertexAttribPointer(ATTRIB_NZ, 1, GL_FLOAT, GL_FALSE, 0, (const void*)(planeBytes * 2));
+        glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 0, (const void*)0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+        if (alpha < 1.0f) {
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDepthMask(GL_FALSE);
+        }
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (const void*)0);
+        if (alpha < 1.0f) {
+            glDepthMask(GL_TRUE);
+            glDisable(GL_BLEND);
+        }
+
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glDisableVertexAttribArray(ATTRIB_HEIGHT);
+        glDisableVertexAttribArray(ATTRIB_NX);
+        glDisableVertexAttribArray(ATTRIB_NZ);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glUseProgram(0);
+    }
+
+    float GetStepMs() const { return stepMs; }   // 마지막 시뮬레이션 단계 시간
+
+private:
+    enum { ATTRIB_HEIGHT = 1, ATTRIB_NX = 6, ATTRIB_NZ = 7 };
+
+    float NextRandom() {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / 16777216.0f;
+    }
+
+    WaterSim* sim;
+    vec3 origin;
+    float cellX, cellZ;
+    float alpha;
+    float dropRadius, dropPower, dropChance;
+    unsigned int seed;
+    GLuint gridVBO, streamVBO, ibo;
+    GLsizei indexCount;
+    GLuint program, texture;
+    float stepMs;
+};
+
+WaterConfig waterConfig;
+WaterSim waterSim;
+WaterSurface water;
+
+// -------------------------------------------------------
+// [행성] 하늘에 떠 있는 행성들 (텍스처는 MipStreamer)
+// -------------------------------------------------------
+// 절두체 안에 있는 행성만 그리고, 그린 행성의 화면 크기를 스트리머에 알려서 밉을 요청하게 합니다.
+// 자체 발광처럼 보이도록 조명 없이 텍스처 색 그대로 그림 (조명 0 번이 행성보다 아래에 있음).
+class PlanetSystem {
+public:
+    PlanetSystem() : streamer(NULL), quadric(NULL), visibleCount(0) {}
+
+    ~PlanetSystem() { if (quadric) gluDeleteQuadric(quadric); }
+
+    void Init(MipStreamer* s) { streamer = s; }
+
+    // texture: MipStreamer 핸들, spin: 초당 자전 각도, tilt: 자전축 기울기 (도)
+    void Add(int texture, vec3 center, float radius, float spin, float tilt) {
+        if (texture < 0) return;
+        Planet p;
+        p.texture = texture;
+        p.center = center;
+        p.radius = radius;
+        p.spin = spin;
+        p.tilt = tilt;
+        planets.push_back(p);
+    }
+
+    void Draw(vec3 eye, float time) {
+        visibleCount = 0;
+        if (!streamer || planets.empty()) return;
+        if (!quadric) {
+            quadric = gluNewQuadric();
+            gluQuadricTexture(quadric, GL_TRUE);
+            gluQuadricNormals(quadric, GLU_SMOOTH);
+        }
+
+        Frustum frustum;
+        frustum.FromCurrentMatrices();
+        streamer->BeginFrame();
+
+        glDisable(GL_LIGHTING);
+        glEnable(GL_TEXTURE_2D);
+        glColor3f(1.0f, 1.0f, 1.0f);
+        for (auto& p : planets) {
+            vec3 r(p.radius);
+            if (!frustum.IntersectsBox(p.center - r, p.center + r)) continue;
+            streamer->Use(p.texture, p.center, p.radius, eye);
+            visibleCount++;
+
+            // gluSphere 는 극이 z 축이므로 y 축으로 세움 (t = 1 이 북극 = 이미지 맨 위)
+            glBindTexture(GL_TEXTURE_2D, streamer->GetTexture(p.texture));
+            glPushMatrix();
+            glTranslatef(p.center.x, p.center.y, p.center.z);
+            glRotatef(p.tilt, 0.0f, 0.0f, 1.0f);
+            glRotatef(p.spin * time, 0.0f, 1.0f, 0.0f);
+            glRotatef(-90.0f, 1.0f, 0.0f, 0.0f);
+            gluSphere(quadric, p.radius, 48, 24);
+            glPopMatrix();
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_TEXTURE_2D);
+        glEnable(GL_LIGHTING);
+    }
+
+    int GetVisibleCount() const { return visibleCount; }
+
+private:
+    struct Planet {
+        int texture;
+        vec3 center;
+        float radius, spin, tilt;
+    };
+
+    MipStreamer* streamer;
+    GLUquadric* quadric;
+    vector<Planet> planets;
+    int visibleCount;
+};
+
+PlanetSystem planets;
+
+void InitSkybox() {
+    // 경로에 주의하세요. 실행 파일과 같은 위치면 "Sky.bmp", 아니면 "../Data/Sky.bmp" 등
+    // 우주 배경이므로 반복되게 설정, 로드 완료 전까지는 플레이스홀더로 그려짐
+    skyTextureID = textureStreamer.Request("../Data/Sky.bmp", GL_REPEAT);
+}
+
+
+// -------------------------------------------------------
+// [폭발 파편] 삼각형 하나를 인스턴싱으로
+// -------------------------------------------------------
+// 파편 하나 = 인스턴스 버퍼의 16 float (생성 위치 + 생성 틱, 속도, 회전 속도, 크기, 색).
+// 파편은 등속 이동/등속 회전이라 경과 틱 하나로 위치와 x->y->z 회전을 정점 셰이더가 계산하므로
+// 폭발할 때 바뀐 구간만 한 번 올리면 되고, 매 틱/매 프레임 CPU 비용은 파편 수와 무관합니다.
+// GL 3.3 이 없으면 같은 식을 CPU 에서 계산해 파편마다 행렬 스택으로 그림 (예전 방식).
+const char* DEBRIS_VERTEX_SHADER =
+    "#version 120\n"
+    "uniform float clock;\n"
+    "attribute vec4 origin;  // 생성 위치, 생성 틱\n"
+    "attribute vec4 speed;   // 틱당 이동 / 0.1, 색 r\n"
+    "attribute vec4 spin;    // 틱당 회전(도) / 10, 색 g\n"
+    "attribute vec4 size;    // 크기, 색 b\n"
+    "varying vec3 color;\n"
+    "void main() {\n"
+    "    float age = clock - origin.w;\n"
+    "    vec3 a = radians(spin.xyz * 10.0 * age);\n"
+    "    vec3 c = cos(a), s = sin(a);\n"
+    "    // glRotatef(x) * glRotatef(y) * glRotatef(z) 와 같은 순서\n"
+    "    mat3 rx = mat3(1.0, 0.0, 0.0,  0.0, c.x, s.x,  0.0, -s.x, c.x);\n"
+    "    mat3 ry = mat3(c.y, 0.0, -s.y,  0.0, 1.0, 0.0,  s.y, 0.0, c.y);\n"
+    "    mat3 rz = mat3(c.z, s.z, 0.0,  -s.z, c.z, 0.0,  0.0, 0.0, 1.0);\n"
+    "    mat3 r = rx * ry * rz;\n"
+    "    vec3 wp = origin.xyz + speed.xyz * 0.1 * age + r * (gl_Vertex.xyz * size.xyz);\n"
+    "    vec3 wn = r * vec3(0.0, 0.0, sign(size.z));   // 삼각형 법선 (0, 0, 1) 을 크기의 역으로 변환 후 정규화\n"
+    "    vec4 eyePos = gl_ModelViewMatrix * vec4(wp, 1.0);\n"
+    "    vec3 n = normalize(gl_NormalMatrix * wn);\n"
+    "    vec4 lp = gl_LightSource[0].position;\n"
+    "    vec3 l = normalize(lp.xyz - eyePos.xyz * lp.w);\n"
+    "    color = vec3(speed.w, spin.w, size.w) * (0.35 + 0.65 * abs(dot(n, l)));\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePos;\n"
+    "}\n";
+
+const char* DEBRIS_FRAGMENT_SHADER =
+    "#version 120\n"
+    "varying vec3 color;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(color, 1.0);\n"
+    "}\n";
+
+class DebrisField {
+public:
+    DebrisField() : pieces(NULL), count(0), clock(0), vbo(0), instanceVBO(0), program(0), dirtyBegin(0), dirtyEnd(0) {}
+
+    // data: count 개 파편 배열 (newExplosion 이 채움, 이 클래스는 읽기만)
+    void Init(const debrisData* data, int n) {
+        pieces = data;
+        count = n;
+
+        static const float triangle[9] = { 0.0f, 0.5f, 0.0f,  -0.25f, 0.0f, 0.0f,  0.25f, 0.0f, 0.0f };
+        glGenBuffers(1, &vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(triangle), triangle, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        if (GLEW_VERSION_3_3) {
+            vector<pair<GLuint, const char*>> attribs;
+            attribs.push_back(make_pair((GLuint)ATTRIB_ORIGIN, "origin"));
+            attribs.push_back(make_pair((GLuint)ATTRIB_SPEED, "speed"));
+            attribs.push_back(make_pair((GLuint)ATTRIB_SPIN, "spin"));
+            attribs.push_back(make_pair((GLuint)ATTRIB_SIZE, "size"));
+            program = BuildProgram(DEBRIS_VERTEX_SHADER, DEBRIS_FRAGMENT_SHADER, attribs);
+        }
+        if (program) {
+            glGenBuffers(1, &instanceVBO);
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            glBufferData(GL_ARRAY_BUFFER, (size_t)count * INSTANCE_FLOATS * sizeof(float), NULL, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            staging.resize((size_t)count * INSTANCE_FLOATS);
+        }
+        cout << "[Debris] " << count << " pieces (" << (program ? "instanced" : "fallback") << ")" << endl;
+    }
+
+    // newExplosion 이 [first, first + n) 을 새로 채웠음 (다음 Draw 에서 그 구간만 올림)
+    void Spawned(int first, int n) {
+        if (dirtyBegin == dirtyEnd) { dirtyBegin = first; dirtyEnd = first + n; }
+        else { dirtyBegin = std::min(dirtyBegin, first); dirtyEnd = std::max(dirtyEnd, first + n); }
+    }
+
+    // 폭발이 진행 중인 타이머 틱마다 한 번 (예전 파편 이동 루프 대신)
+    void Tick() { clock++; }
+    float Clock() const { return (float)clock; }
+
+    void Draw() {
+        if (!pieces || count == 0) return;
+
+        if (program) {
+            Upload();
+            glUseProgram(program);
+            glUniform1f(glGetUniformLocation(program, "clock"), (float)clock);
+
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            glEnableClientState(GL_VERTEX_ARRAY);
+            glVertexPointer(3, GL_FLOAT, 0, (const void*)0);
+
+            const GLsizei stride = INSTANCE_FLOATS * sizeof(float);
+            const GLuint locations[4] = { ATTRIB_ORIGIN, ATTRIB_SPEED, ATTRIB_SPIN, ATTRIB_SIZE };
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            for (int i = 0; i < 4; i++) {
+                glEnableVertexAttribArray(locations[i]);
+                glVertexAttribPointer(locations[i], 4, GL_FLOAT, GL_FALSE, stride, (const void*)(i * 4 * sizeof(float)));
+                glVertexAttribDivisor(locations[i], 1);
+            }
+
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 3, count);
+
+            for (int i = 0; i < 4; i++) {
+                glVertexAttribDivisor(locations[i], 0);
+                glDisableVertexAttribArray(locations[i]);
+            }
+            glDisableClientState(GL_VERTEX_ARRAY);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glUseProgram(0);
+            return;
+        }
+
+        // 셰이더와 같은 식을 CPU 에서
+        for (int i = 0; i < count; i++) {
+            const debrisData& d = pieces[i];
+            float age = clock - d.spawnTick;
+            glColor3fv(d.color);
+            glPushMatrix();
+            glTranslatef(d.position[0] + d.speed[0] * 0.1f * age, d.position[1] + d.speed[1] * 0.1f * age, d.position[2] + d.speed[2] * 0.1f * age);
+            glRotatef(d.orientationSpeed[0] * 10.0f * age, 1, 0, 0);
+            glRotatef(d.orientationSpeed[1] * 10.0f * age, 0, 1, 0);
+            glRotatef(d.orientationSpeed[2] * 10.0f * age, 0, 0, 1);
+            glScalef(d.scale[0], d.scale[1], d.scale[2]);
+            glBegin(GL_TRIANGLES);
+            glNormal3f(0.0, 0.0, 1.0);
+            glVertex3f(0.0, 0.5, 0.0); glVertex3f(-0.25, 0.0, 0.0); glVertex3f(0.25, 0.0, 0.0);
+            glEnd();
+            glPopMatrix();
+        }
+    }
+
+    int GetCount() const { return count; }
+
+private:
+    // 속성이 4개 필요해서 빈 1, 6, 7 번에 더해 5 번 (gl_FogCoord 자리, 이 셰이더는 안개 좌표를 안 씀) 도 씀
+    enum { INSTANCE_FLOATS = 16, ATTRIB_ORIGIN = 1, ATTRIB_SPEED = 6, ATTRIB_SPIN = 7, ATTRIB_SIZE = 5 };
+
+    // 바뀐 구간만 인스턴스 배치로 바꿔서 올림
+    void Upload() {
+        if (dirtyBegin == dirtyEnd) return;
+        for (int i = dirtyBegin; i < dirtyEnd; i++) {
+            const debrisData& d = pieces[i];
+            float v[INSTANCE_FLOATS] = {
+                d.position[0], d.position[1], d.position[2], d.spawnTick,
+                d.speed[0], d.speed[1], d.speed[2], d.color[0],
+                d.orientationSpeed[0], d.orientationSpeed[1], d.orientationSpeed[2], d.color[1],
+                d.scale[0], d.scale[1], d.scale[2], d.color[2]
+            };
+            memcpy(&staging[(size_t)i * INSTANCE_FLOATS], v, sizeof(v));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, (size_t)dirtyBegin * INSTANCE_FLOATS * sizeof(float),
+                        (size_t)(dirtyEnd - dirtyBegin) * INSTANCE_FLOATS * sizeof(float), &staging[(size_t)dirtyBegin * INSTANCE_FLOATS]);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        dirtyBegin = dirtyEnd = 0;
+    }
+
+    const debrisData* pieces;
+    int count;
+    int clock;
+    GLuint vbo, instanceVBO, program;
+    vector<float> staging;
+    int dirtyBegin, dirtyEnd;
+};
+
+DebrisField debrisField;
+
+// -------------------------------------------------------
+// [폭발 파티클] 스트리밍 VBO + 텍스처 포인트 스프라이트 (+ 변환 피드백 시뮬레이션)
+// -------------------------------------------------------
+// 매 프레임 particles[] 배열을 통째로 (memcpy 한 번 크기) 고아화한 VBO 에 올리고, 위치/색은 배열의
+// 구조체 간격(stride) 그대로 가리켜서 그림. 점은 Particle64.bmp 스프라이트로, 거리 감쇠된 크기로
+// 더하기 합성 (타서 검게 식은 불꽃은 자연히 안 보임). 포인트 스프라이트가 없으면 같은 VBO 로 점만.
+//
+// GL 3.0 이 있으면 UpdateParticles 의 이동/식힘도 정점 셰이더가 변환 피드백으로 두 버퍼를 번갈아
+// 가며 계산 (래스터화 없이). 이때 particles[] 는 newExplosion 이 새로 채운 구간을 올릴 때만 읽고,
+// 그 뒤 값은 GPU 에만 있음. 출력 varying 순서가 particleData 배치와 같아서 그리기는 그 버퍼 그대로.
+const char* PARTICLE_SIM_VERTEX_SHADER =
+    "#version 120\n"
+    "attribute vec3 position;\n"
+    "attribute vec3 speed;\n"
+    "attribute vec3 color;\n"
+    "varying vec3 outPosition;\n"
+    "varying vec3 outSpeed;\n"
+    "varying vec3 outColor;\n"
+    "void main() {\n"
+    "    // UpdateParticles 의 CPU 루프와 같은 식 (틱당 속도의 0.2 배, 빨강/초록/파랑 순으로 느리게 식음)\n"
+    "    outPosition = position + speed * 0.2;\n"
+    "    outSpeed = speed;\n"
+    "    outColor = max(color - vec3(1.0 / 500.0, 1.0 / 100.0, 1.0 / 50.0), 0.0);\n"
+    "    gl_Position = vec4(outPosition, 1.0);\n"
+    "}\n";
+
+const char* PARTICLE_SIM_FRAGMENT_SHADER =
+    "#version 120\n"
+    "void main() { gl_FragColor = vec4(0.0); }\n";
+
+// 틱 한 번의 CPU 이동/식힘 (변환 피드백이 없을 때, 위 셰이더와 같은 식)
+void MoveParticles(particleData* p, int n) {
+    for (int i = 0; i < n; i++) {
+        p[i].position[0] += p[i].speed[0] * 0.2f;
+        p[i].position[1] += p[i].speed[1] * 0.2f;
+        p[i].position[2] += p[i].speed[2] * 0.2f;
+        p[i].color[0] -= 1.0f / 500.0f; if (p[i].color[0] < 0) p[i].color[0] = 0;
+        p[i].color[1] -= 1.0f / 100.0f; if (p[i].color[1] < 0) p[i].color[1] = 0;
+        p[i].color[2] -= 1.0f / 50.0f; if (p[i].color[2] < 0) p[i].color[2] = 0;
+    }
+}
+
+class ParticleStream {
+public:
+    float pointSize = 3.0f;     // 감쇠 전 크기 (거리 10 에서 이 크기의 10 배, 100 에서 그대로)
+    float maxSize = 48.0f;
+
+    ParticleStream() : particles(NULL), count(0), spritePath(NULL), vbo(0), texture(0), sprites(false), simProgram(0), current(0) {
+        buffers[0] = buffers[1] = 0;
+    }
+
+    ~ParticleStream() { textureRegistry.Release(texture); }
+
+    // simulate: GL 3.0 이 있으면 이동도 GPU 에서 (false 면 항상 CPU 루프 + 스트리밍)
+    void Init(const particleData* data, int n, const char* spritePath, bool simulate = true) {
+        particles = data;
+        count = n;
+        this->spritePath = spritePath;
+        glGenBuffers(1, &vbo);
+        sprites = (GLEW_VERSION_2_0 || GLEW_ARB_point_sprite) != 0;
+        if (sprites) texture = textureRegistry.Acquire(spritePath);
+
+        if (simulate && GLEW_VERSION_3_0) {
+            vector<pair<GLuint, const char*>> attribs;
+            attribs.push_back(make_pair((GLuint)ATTRIB_POSITION, "position"));
+            attribs.push_back(make_pair((GLuint)ATTRIB_SPEED, "speed"));
+            attribs.push_back(make_pair((GLuint)ATTRIB_COLOR, "color"));
+            vector<const char*> outputs = { "outPosition", "outSpeed", "outColor" };
+            simProgram = BuildProgram(PARTICLE_SIM_VERTEX_SHADER, PARTICLE_SIM_FRAGMENT_SHADER, attribs, outputs);
+        }
+        if (simProgram) {
+            glGenBuffers(2, buffers);
+            for (int i = 0; i < 2; i++) {
+                glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+                glBufferData(GL_ARRAY_BUFFER, (size_t)count * sizeof(particleData), particles, GL_DYNAMIC_COPY);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        cout << "[Particles] " << count << " points (" << (sprites ? "point sprites" : "points") << ", "
+            << (simProgram ? "transform feedback" : "CPU") << " simulation)" << endl;
+    }
+
+    bool Simulating() const { return simProgram != 0; }
+
+    // 'p': 지금 파티클을 n 개로 복제해 frames 틱 동안 (이동, 올리기 + 그리기) 시간을 잼. 둘 다 glFinish 까지.
+    // 같은 설정 (스프라이트 / 시뮬레이션 방식) 으로, 그리기는 지금 행렬과 뒷버퍼에 (다음 화면에서 덮임)
+    void Benchmark(int n, int frames) {
+        if (!particles || count == 0 || n <= 0 || frames <= 0) return;
+        vector<particleData> copies(n);
+        for (int i = 0; i < n; i++) copies[i] = particles[i % count];
+
+        ParticleStream stream;
+        stream.pointSize = pointSize;
+        stream.maxSize = maxSize;
+        stream.Init(copies.data(), n, spritePath, Simulating());
+        glFinish();
+
+        float updateMs = 0.0f, drawMs = 0.0f;
+        for (int f = 0; f < frames; f++) {
+            auto start = chrono::steady_clock::now();
+            if (stream.Simulating()) stream.Step();
+            else MoveParticles(copies.data(), n);
+            glFinish();
+            auto drawn = chrono::steady_clock::now();
+            stream.Draw();
+            glFinish();
+            updateMs += chrono::duration<float, milli>(drawn - start).count();
+            drawMs += chrono::duration<float, milli>(chrono::steady_clock::now() - drawn).count();
+        }
+        cout << "[Particles] " << n << " points x " << frames << " ticks: update " << updateMs / frames << " ms ("
+            << (stream.Simulating() ? "transform feedback" : "CPU") << "), upload + draw " << drawMs / frames << " ms per frame" << endl;
+        stream.Release();
+    }
+
+    // GL 객체 해제 (전역 인스턴스는 프로그램 끝까지 씀, Benchmark 의 임시 스트림용)
+    void Release() {
+        glDeleteBuffers(1, &vbo);
+        if (simProgram) {
+            glDeleteBuffers(2, buffers);
+            glDeleteProgram(simProgram);
+        }
+        vbo = simProgram = buffers[0] = buffers[1] = 0;
+        particles = NULL;
+        count = 0;
+    }
+
+    // newExplosion 이 [first, first + n) 을 새로 채웠음. GPU 시뮬레이션 중이면 그 구간만 바로 올림
+    // (나머지 particles[] 값은 오래된 것이라 구간을 합쳐서 나중에 올리면 안 됨)
+    void Spawned(int first, int n) {
+        if (!simProgram || n <= 0) return;
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+        glBufferSubData(GL_ARRAY_BUFFER, (size_t)first * sizeof(particleData), (size_t)n * sizeof(particleData), &particles[first]);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // 타이머 틱 한 번 (UpdateParticles 의 CPU 루프 대신): buffers[current] -> 다른 버퍼
+    void Step() {
+        if (!simProgram) return;
+        glUseProgram(simProgram);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+        const GLuint locations[3] = { ATTRIB_POSITION, ATTRIB_SPEED, ATTRIB_COLOR };
+        for (int i = 0; i < 3; i++) {
+            glEnableVertexAttribArray(locations[i]);
+            glVertexAttribPointer(locations[i], 3, GL_FLOAT, GL_FALSE, sizeof(particleData), (const void*)(i * 3 * sizeof(float)));
+        }
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers[1 - current]);
+
+        glEnable(GL_RASTERIZER_DISCARD);
+        glBeginTransformFeedback(GL_POINTS);
+        glDrawArrays(GL_POINTS, 0, count);
+        glEndTransformFeedback();
+        glDisable(GL_RASTERIZER_DISCARD);
+
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+        for (int i = 0; i < 3; i++) glDisableVertexAttribArray(locations[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glUseProgram(0);
+        current = 1 - current;
+    }
+
+    void Draw() {
+        if (!particles || count == 0) return;
+
+        if (simProgram) glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+        else {
+            // 고아화: 이전 프레임 버퍼를 GPU 가 아직 읽고 있어도 기다리지 않음
+            size_t bytes = (size_t)count * sizeof(particleData);
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            glBufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, particles);
+        }
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(particleData), (const void*)offsetof(particleData, position));
+        glColorPointer(3, GL_FLOAT, sizeof(particleData), (const void*)offsetof(particleData, color));
+
+        if (sprites) {
+            // 크기 = pointSize / (0.01 * 거리)
+            const float attenuation[3] = { 0.0f, 0.0f, 0.0001f };
+            glPointParameterfv(GL_POINT_DISTANCE_ATTENUATION, attenuation);
+            glPointParameterf(GL_POINT_SIZE_MIN, 1.0f);
+            glPointParameterf(GL_POINT_SIZE_MAX, maxSize);
+            glPointSize(pointSize);
+            glEnable(GL_POINT_SPRITE);
+            glTexEnvi(GL_POINT_SPRITE, GL_COORD_REPLACE, GL_TRUE);
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE);
+            glDepthMask(GL_FALSE);
+        }
+        else glPointSize(pointSize);
+
+        glDrawArrays(GL_POINTS, 0, count);
+
+        if (sprites) {
+            glDepthMask(GL_TRUE);
+            glDisable(GL_BLEND);
+            glDisable(GL_TEXTURE_2D);
+            glTexEnvi(GL_POINT_SPRITE, GL_COORD_REPLACE, GL_FALSE);
+            glDisable(GL_POINT_SPRITE);
+            const float none[3] = { 1.0f, 0.0f, 0.0f };
+            glPointParameterfv(GL_POINT_DISTANCE_ATTENUATION, none);
+        }
+        glPointSize(1.0f);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+private:
+    // 0 번은 정점 위치 자리 (호환 프로필은 0 번 배열이 켜져 있어야 정점을 보냄), 나머지는 빈 6, 7 번
+    enum { ATTRIB_POSITION = 0, ATTRIB_SPEED = 6, ATTRIB_COLOR = 7 };
+
+    const particleData* particles;
+    int count;
+    const char* spritePath;
+    GLuint vbo, texture;
+    bool sprites;
+    GLuint simProgram, buffers[2];
+    int current;
+};
+
+ParticleStream particleStream;
+
+// -------------------------------------------------------
+// [단위 큐브] 모든 Cube 가 같이 쓰는 정점/인덱스 버퍼
+// -------------------------------------------------------
+// 한 변 1, 중심 원점. 면마다 법선과 UV 가 달라서 면당 정점 4개 -> 24 정점 (위치/법선/UV 인터리브), 36 인덱스.
+// UV 의 v 는 Cube 면 아틀라스에 미리 맞춰 둠 (앞뒤: 레이어 0, 위아래: 1, 좌우: 2).
+// Bind 한 번 뒤 DrawBound() 는 glDrawElements 한 번이라 잔상/그림자처럼 여러 번 그릴 때도 버퍼는 그대로.
+class UnitCubeMesh {
+public:
+    static const int ATLAS_LAYERS = 3;
+
+    UnitCubeMesh() : vbo(0), ibo(0) {}
+
+    // GL 컨텍스트 생성 후 한 번
+    void Init() {
+        if (vbo) return;
+        struct Face { float n[3]; float v[4][3]; int layer; };
+        const float s = 0.5f;
+        const Face faces[6] = {
+            { { 0, 0, 1 },  { { -s, -s, s }, { s, -s, s }, { s, s, s }, { -s, s, s } }, 0 },        // 앞
+            { { 0, 0, -1 }, { { -s, -s, -s }, { -s, s, -s }, { s, s, -s }, { s, -s, -s } }, 0 },    // 뒤
+            { { 0, 1, 0 },  { { -s, s, -s }, { -s, s, s }, { s, s, s }, { s, s, -s } }, 1 },        // 위
+            { { 0, -1, 0 }, { { -s, -s, -s }, { -s, -s, s }, { s, -s, s }, { s, -s, -s } }, 1 },    // 아래
+            { { -1, 0, 0 }, { { -s, -s, -s }, { -s, -s, s }, { -s, s, s }, { -s, s, -s } }, 2 },    // 좌
+            { { 1, 0, 0 },  { { s, -s, -s }, { s, -s, s }, { s, s, s }, { s, s, -s } }, 2 },        // 우
+        };
+        const float uv[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+        vector<float> vertices;
+        vector<unsigned short> indices;
+        for (int f = 0; f < 6; f++) {
+            for (int k = 0; k < 4; k++) {
+                const float* p = faces[f].v[k];
+                float v[8] = { p[0], p[1], p[2], faces[f].n[0], faces[f].n[1], faces[f].n[2],
+                               uv[k][0], AtlasLayerV(faces[f].layer, ATLAS_LAYERS, uv[k][1]) };
+                vertices.insert(vertices.end(), v, v + 8);
+            }
+            unsigned short b = (unsigned short)(f * 4);
+            unsigned short quad[6] = { b, (unsigned short)(b + 1), (unsigned short)(b + 2), b, (unsigned short)(b + 2), (unsigned short)(b + 3) };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ibo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned short), indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    // textured: UV 배열도 켬 (텍스처 바인드/환경은 호출자)
+    void Bind(bool textured) const {
+        const GLsizei stride = 8 * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(3, GL_FLOAT, stride, (const void*)0);
+        glNormalPointer(GL_FLOAT, stride, (const void*)(3 * sizeof(float)));
+        if (textured) {
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(2, GL_FLOAT, stride, (const void*)(6 * sizeof(float)));
+        }
+    }
+
+    void DrawBound() const {
+        glDrawElements(GL_TRIANGLES, INDEX_COUNT, GL_UNSIGNED_SHORT, (const void*)0);
+    }
+
+    static void Unbind() {
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void Draw(bool textured = false) const {
+        if (!vbo) return;
+        Bind(textured);
+        DrawBound();
+        Unbind();
+    }
+
+    bool IsReady() const { return vbo != 0; }
+
+private:
+    static const GLsizei INDEX_COUNT = 36;
+
+    GLuint vbo, ibo;
+};
+
+UnitCubeMesh unitCube;
+
+// -------------------------------------------------------
+// [구 메쉬] 반지름 0.5 UV 구를 LOD 단계별로 미리 만들어 둔 정적 버퍼
+// -------------------------------------------------------
+// glutSolidSphere 는 부를 때마다 삼각함수로 정점을 다시 계산해 즉시 모드로 보냄 (32x32 = 정점 약 2천 개).
+// 여기서는 (경도 x 위도) 32x32, 20x16, 12x10, 8x6 네 단계를 VBO/IBO 하나에 모아 두고, 화면에 보이는
+// 반지름(픽셀) 로 단계를 골라 glDrawElements 한 번으로 그림. 0 단계가 예전 본체와 같은 분할.
+// 위치 = 법선 * 0.5 이므로 정점은 위치/법선만. Bind 한 번 뒤 DrawBound() 로 잔상처럼 여러 개.
+class SphereMeshCache {
+public:
+    static const int LEVELS = 4;
+
+    SphereMeshCache() : vbo(0), ibo(0), pixelScale(500.0f) {
+        for (int i = 0; i < LEVELS; i++) first[i] = count[i] = 0;
+    }
+
+    // GL 컨텍스트 생성 후 한 번
+    void Init() {
+        if (vbo) return;
+        const int slices[LEVELS] = { 32, 20, 12, 8 }, stacks[LEVELS] = { 32, 16, 10, 6 };
+        vector<float> vertices;
+        vector<unsigned short> indices;
+        for (int level = 0; level < LEVELS; level++) {
+            unsigned short base = (unsigned short)(vertices.size() / 6);
+            for (int i = 0; i <= stacks[level]; i++) {
+                float phi = 3.14159265f * i / stacks[level];
+                for (int j = 0; j < slices[level]; j++) {
+                    float theta = 2.0f * 3.14159265f * j / slices[level];
+                    float n[3] = { sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta) };
+                    float v[6] = { n[0] * 0.5f, n[1] * 0.5f, n[2] * 0.5f, n[0], n[1], n[2] };
+                    vertices.insert(vertices.end(), v, v + 6);
+                }
+            }
+
+            // 바깥에서 반시계. 극에 닿는 줄은 삼각형 하나씩 (겹친 극 정점으로 퇴화하는 쪽은 뺌)
+            first[level] = (GLsizei)indices.size();
+            for (int i = 0; i < stacks[level]; i++) {
+                for (int j = 0; j < slices[level]; j++) {
+                    int k = (j + 1) % slices[level];
+                    unsigned short a = (unsigned short)(base + i * slices[level] + j), d = (unsigned short)(base + i * slices[level] + k);
+                    unsigned short b = (unsigned short)(a + slices[level]), c = (unsigned short)(d + slices[level]);
+                    if (i > 0) { indices.push_back(a); indices.push_back(d); indices.push_back(b); }
+                    if (i < stacks[level] - 1) { indices.push_back(d); indices.push_back(c); indices.push_back(b); }
+                }
+            }
+            count[level] = (GLsizei)indices.size() - first[level];
+        }
+
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ibo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned short), indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    // 프레임마다 LevelFor() 전에: 지금 투영/뷰포트로 "월드 길이 / 거리 -> 픽셀" 계수
+    void BeginFrame() {
+        float proj[16];
+        GLint viewport[4];
+        glGetFloatv(GL_PROJECTION_MATRIX, proj);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        pixelScale = proj[5] * viewport[3] * 0.5f;
+    }
+
+    // 화면 반지름이 단계별 최소 픽셀보다 작으면 한 단계씩 거칠게
+    int LevelFor(vec3 center, float radius, vec3 eye) const {
+        static const float minPixels[LEVELS - 1] = { 40.0f, 16.0f, 6.0f };
+        float dist = length(center - eye);
+        if (dist <= radius) return 0;
+        float pixels = radius / dist * pixelScale;
+        int level = 0;
+        while (level < LEVELS - 1 && pixels < minPixels[level]) level++;
+        return level;
+    }
+
+    void Bind() const {
+        const GLsizei stride = 6 * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(3, GL_FLOAT, stride, (const void*)0);
+        glNormalPointer(GL_FLOAT, stride, (const void*)(3 * sizeof(float)));
+    }
+
+    void DrawBound(int level) const {
+        glDrawElements(GL_TRIANGLES, count[level], GL_UNSIGNED_SHORT, (const void*)(first[level] * sizeof(unsigned short)));
+    }
+
+    static void Unbind() {
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void Draw(int level) const {
+        if (!vbo) return;
+        Bind();
+        DrawBound(level);
+        Unbind();
+    }
+
+    bool IsReady() const { return vbo != 0; }
+
+private:
+    GLuint vbo, ibo;
+    GLsizei first[LEVELS], count[LEVELS];     // 단계별 인덱스 구간
+    float pixelScale;
+};
+
+SphereMeshCache sphereMesh;
+
+// -------------------------------------------------------
+// [렌더 큐] 상태 키 정렬 + 고정 파이프라인 상태 캐시
+// -------------------------------------------------------
+// 그리는 쪽은 상태를 직접 켜고 끄지 않고 "어떤 상태로 그릴지"(RenderState) 와 그리기 함수만 넣음.
+// 키 = 패스 | 조명 | 텍스처 | 재질 | 깊이 로 정렬해서 같은 상태끼리 모으고, 실행할 때는 마지막으로
+// 설정한 값과 다를 때만 GL 을 부름. 반투명 패스만은 상태보다 깊이(먼 것부터) 가 먼저.
+// 셰이더/텍스처를 스스로 다루는 시스템(지형, 물, 파티클 등) 은 custom 항목: 텍스처 환경까지 정확히
+// 맞춘 상태에서 부르고, 켠 것은 스스로 되돌린다는 기존 규칙을 믿되 바인드/블렌드 함수는 모른다고 봄.
+// 프레임마다 예전 방식(항목마다 켰다가 되돌리기) 이었다면 불렀을 상태 호출 수와 실제 호출 수를 셈.
+enum RenderPass { PASS_SKY, PASS_OPAQUE, PASS_SHADOW, PASS_TRANSPARENT, PASS_OVERLAY };
+enum BlendMode { BLEND_NONE, BLEND_ALPHA, BLEND_ADD };
+enum MaterialId { MATERIAL_DEFAULT, MATERIAL_GLOW_RED, MATERIAL_GLOW_GREEN, MATERIAL_COUNT };
+
+// 기본값 = 프레임 사이 / custom 항목이 기대하는 GL 상태
+struct RenderState {
+    bool lighting = true;
+    bool depthTest = true;
+    bool depthWrite = true;
+    int blend = BLEND_NONE;
+    GLuint texture = 0;         // 0 이면 GL_TEXTURE_2D 끔
+    GLint envMode = GL_MODULATE;
+    int material = MATERIAL_DEFAULT;
+};
+
+class RenderStateCache {
+public:
+    RenderStateCache() : calls(0) { Reset(); }
+
+    // 프레임 시작: GL 이 기본 상태라고 가정 (어떤 텍스처/블렌드 함수가 걸려 있는지는 모름)
+    void Reset() {
+        current = RenderState();
+        textureOn = false;
+        Forget();
+    }
+
+    // custom 항목 뒤: 바인드와 블렌드 함수는 바뀌었을 수 있음
+    void Forget() {
+        bound = UNKNOWN;
+        blendFunc = -1;
+    }
+
+    // full: 텍스처가 없어도 환경 모드까지 맞춤 (custom 항목용)
+    void Apply(const RenderState& s, bool full) {
+        Toggle(GL_LIGHTING, current.lighting, s.lighting);
+        Toggle(GL_DEPTH_TEST, current.depthTest, s.depthTest);
+        if (current.depthWrite != s.depthWrite) {
+            glDepthMask(s.depthWrite ? GL_TRUE : GL_FALSE);
+            current.depthWrite = s.depthWrite;
+            calls++;
+        }
+
+        bool blendOn = s.blend != BLEND_NONE;
+        bool wasOn = current.blend != BLEND_NONE;
+        Toggle(GL_BLEND, wasOn, blendOn);
+        current.blend = s.blend;
+        if (blendOn && blendFunc != s.blend) {
+            if (s.blend == BLEND_ADD) glBlendFunc(GL_ONE, GL_ONE);
+            else glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            blendFunc = s.blend;
+            calls++;
+        }
+
+        Toggle(GL_TEXTURE_2D, textureOn, s.texture != 0);
+        if (s.texture != 0 && bound != s.texture) {
+            glBindTexture(GL_TEXTURE_2D, s.texture);
+            bound = s.texture;
+            calls++;
+        }
+        if ((s.texture != 0 || full) && current.envMode != s.envMode) {
+            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, s.envMode);
+            current.envMode = s.envMode;
+            calls++;
+        }
+
+        if (current.material != s.material) {
+            static const float emission[MATERIAL_COUNT][4] = { { 0, 0, 0, 1 }, { 0.8f, 0, 0, 1 }, { 0, 0.8f, 0, 1 } };
+            glMaterialfv(GL_FRONT, GL_EMISSION, emission[s.material]);
+            current.material = s.material;
+            calls++;
+        }
+    }
+
+    int Calls() const { return calls; }
+    void ResetCalls() { calls = 0; }
+
+private:
+    static const GLuint UNKNOWN = 0xffffffffu;
+
+    void Toggle(GLenum cap, bool& on, bool want) {
+        if (on == want) return;
+        if (want) glEnable(cap); else glDisable(cap);
+        on = want;
+        calls++;
+    }
+
+    RenderState current;
+    bool textureOn;
+    GLuint bound;
+    int blendFunc;
+    int calls;
+};
+
+class RenderQueue {
+public:
+    struct Stats {
+        int items;
+        int naiveCalls;     // 항목마다 필요한 상태를 켰다가 되돌렸다면
+        int stateCalls;     // 정렬 + 캐시로 실제 부른 수
+    };
+
+    RenderQueue() : last{ 0, 0, 0 } {}
+
+    void Begin() { items.clear(); }
+
+    // depth: 카메라까지 거리 (불투명은 가까운 것부터, 반투명은 먼 것부터)
+    void Add(RenderPass pass, const RenderState& state, float depth, function<void()> draw) {
+        Push(pass, state, depth, false, draw);
+    }
+
+    void AddCustom(RenderPass pass, const RenderState& state, float depth, function<void()> draw) {
+        Push(pass, state, depth, true, draw);
+    }
+
+    // 정렬해서 그린 뒤 GL 을 기본 상태로 되돌림
+    void Execute() {
+        stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.key < b.key; });
+
+        cache.Reset();
+        cache.ResetCalls();
+        int naive = 0;
+        for (auto& item : items) {
+            naive += NaiveCalls(item.state);
+            cache.Apply(item.state, item.custom);
+            item.draw();
+            if (item.custom) cache.Forget();
+        }
+        cache.Apply(RenderState(), true);
+
+        last.items = (int)items.size();
+        last.naiveCalls = naive;
+        last.stateCalls = cache.Calls();
+    }
+
+    const Stats& LastFrame() const { return last; }
+
+    void PrintStats() const {
+        cout << "[RenderQueue] " << last.items << " items, state calls " << last.stateCalls
+            << " (set/restore per item: " << last.naiveCalls << ")" << endl;
+    }
+
+private:
+    struct Item {
+        uint64_t key;
+        RenderState state;
+        bool custom;
+        function<void()> draw;
+    };
+
+    void Push(RenderPass pass, const RenderState& state, float depth, bool custom, function<void()>& draw) {
+        Item item;
+        item.key = MakeKey(pass, state, depth);
+        item.state = state;
+        item.custom = custom;
+        item.draw = std::move(draw);
+        items.push_back(std::move(item));
+    }
+
+    // 패스 4 | 조명 1 | 텍스처 19 | 재질 8 | 깊이 32 비트 (양수 float 는 비트 순서가 곧 크기 순서)
+    static uint64_t MakeKey(RenderPass pass, const RenderState& s, float depth) {
+        uint32_t bits;
+        if (depth < 0.0f) depth = 0.0f;
+        memcpy(&bits, &depth, sizeof(bits));
+        uint64_t key = (uint64_t)pass << 60;
+        if (pass == PASS_TRANSPARENT) return key | (uint32_t)~bits;
+        return key | ((uint64_t)(s.lighting ? 1 : 0) << 59) | ((uint64_t)(s.texture & 0x7ffff) << 40)
+            | ((uint64_t)(s.material & 0xff) << 32) | bits;
+    }
+
+    // 예전 코드처럼 기본값과 다른 상태를 켜고 (텍스처는 켜기 + 바인드) 그린 뒤 되돌리는 호출 수
+    static int NaiveCalls(const RenderState& s) {
+        const RenderState d;
+        int n = 0;
+        if (s.lighting != d.lighting) n += 2;
+        if (s.depthTest != d.depthTest) n += 2;
+        if (s.depthWrite != d.depthWrite) n += 2;
+        if (s.blend != BLEND_NONE) n += 3;
+        if (s.texture != 0) n += 3;
+        if (s.texture != 0 && s.envMode != d.envMode) n += 2;
+        if (s.material != d.material) n += 2;
+        return n;
+    }
+
+    vector<Item> items;
+    RenderStateCache cache;
+    Stats last;
+};
+
+RenderQueue renderQueue;
+
+// -------------------------------------------------------
+// [절두체 컬링] 오브젝트 경계를 모아 한 번에 검사
+// -------------------------------------------------------
+// 오브젝트(GameObject, 버튼, 퍼즐 조각) 는 처음 그릴 때 CullSet 칸을 받고, 움직인 프레임에만 경계를 다시 씀.
+// DrawScene 은 경계 갱신 -> Run() (전체 칸을 SIMD 로 한 번에) -> Test() 가 참인 것만 렌더 큐에 넣음.
+// 방은 셀, 문 구멍은 포털 (PortalCells): 절두체를 통과한 칸도 걸친 셀들이 포털로 보이지 않으면 뺌.
+// 셀은 칸보다 먼저 (InitObjects 에서) 등록해야 칸이 어느 셀에 걸치는지 기록됨.
+class SceneCuller {
+public:
+    struct Stats {
+        int slots;          // 검사한 칸 (등록된 전체)
+        int candidates;     // 이번 프레임에 그리려던 것
+        int culled;         // 그 중 절두체 밖이거나 안 보이는 셀
+        int boundsUpdates;  // 경계를 다시 쓴 칸
+        int portalCulled;   // 절두체 안이지만 포털로 가려진 칸
+        int cellsVisible;
+        float us;           // Run() 시간
+    };
+
+    SceneCuller() : path(CullSet::bestPath()), frame{ 0, 0, 0, 0, 0, 0, 0.0f }, last{ 0, 0, 0, 0, 0, 0, 0.0f } {}
+
+    // 프레임 시작 (지난 프레임 통계를 보관)
+    void Begin() {
+        last = frame;
+        frame = Stats{ 0, 0, 0, 0, 0, 0, 0.0f };
+    }
+
+    int Add() {
+        visible.push_back(1);
+        slotCells.push_back(vector<int>());
+        slotSpheres.push_back(vec4(0.0f, 0.0f, 0.0f, 0.0f));
+        return set.add();
+    }
+
+    // 셀 = 방 AABB, 포털 = 두 셀 사이 볼록 구멍 (꼭짓점 둘레 순서)
+    int AddCell(const vec3& boxMin, const vec3& boxMax) {
+        const float mn[3] = { boxMin.x, boxMin.y, boxMin.z };
+        const float mx[3] = { boxMax.x, boxMax.y, boxMax.z };
+        return cells.addCell(mn, mx);
+    }
+
+    int AddPortal(int cellA, int cellB, const vector<vec3>& corners) {
+        vector<float> xyz;
+        for (const vec3& v : corners) { xyz.push_back(v.x); xyz.push_back(v.y); xyz.push_back(v.z); }
+        return cells.addPortal(cellA, cellB, xyz.data(), (int)corners.size());
+    }
+
+    void SetPortalOpen(int portal, bool open) { if (portal >= 0) cells.setOpen(portal, open); }
+    bool CellVisible(int cell) const { return cell < 0 || cells.cellVisible(cell); }
+
+    void Set(int slot, const vec3& center, float radius, const vec3& boxMin, const vec3& boxMax) {
+        const float c[3] = { center.x, center.y, center.z };
+        const float mn[3] = { boxMin.x, boxMin.y, boxMin.z };
+        const float mx[3] = { boxMax.x, boxMax.y, boxMax.z };
+        set.set(slot, c, radius, mn, mx);
+        cells.overlappingCells(mn, mx, slotCells[slot]);
+        slotSpheres[slot] = vec4(center, radius);
+        frame.boundsUpdates++;
+    }
+
+    // eye: 셀 흐름을 시작할 눈 위치 (어느 셀에도 없으면 포털 검사 없이 절두체만)
+    void Run(const Frustum& frustum, const vec3& eye) {
+        auto start = chrono::steady_clock::now();
+        set.cull(frustum.planes, visible.data(), path);
+
+        const float e[3] = { eye.x, eye.y, eye.z };
+        frame.cellsVisible = cells.update(e, frustum.planes, 6);
+        if (cells.eyeCell() >= 0) {
+            for (size_t i = 0; i < visible.size(); i++) {
+                if (!visible[i]) continue;
+                const vec4& s = slotSpheres[i];
+                const float c[3] = { s.x, s.y, s.z };
+                if (!cells.sphereVisible(slotCells[i], c, s.w)) {
+                    visible[i] = 0;
+                    frame.portalCulled++;
+                }
+            }
+        }
+        frame.us = chrono::duration<float, micro>(chrono::steady_clock::now() - start).count();
+        frame.slots = (int)set.size();
+    }
+
+    // 칸이 없으면 (경계 미등록) 항상 보임
+    bool Test(int slot) {
+        frame.candidates++;
+        bool v = slot < 0 || visible[slot] != 0;
+        if (!v) frame.culled++;
+        return v;
+    }
+
+    const Stats& LastFrame() const { return last; }
+
+    void PrintStats() const {
+        cout << "[Culling] " << CullSet::pathName(path) << ": " << last.slots << " bounds in " << last.us << " us, "
+            << last.culled << " / " << last.candidates << " draws culled, " << last.boundsUpdates << " bounds updated" << endl;
+        const PortalCells::Stats& s = cells.stats();
+        cout << "[Portals] eye cell " << cells.eyeCell() << ", " << last.cellsVisible << " / " << cells.cellCount() << " cells visible, "
+            << s.portalsPassed << " / " << s.portalsTested << " portals passed, " << last.portalCulled << " bounds culled by portals" << endl;
+    }
+
+private:
+    CullSet set;
+    CullSet::Path path;
+    vector<unsigned char> visible;
+    PortalCells cells;
+    vector<vector<int>> slotCells;  // 칸 AABB 가 걸친 셀 (비었으면 셀 밖: 절두체만)
+    vector<vec4> slotSpheres;       // 포털 절두체 검사용 경계 구 (xyz 중심, w 반지름)
+    Stats frame, last;
+};
+
+SceneCuller sceneCuller;
+int room1Cell = -1, room2Cell = -1, doorPortal = -1;
+
+// -------------------------------------------------------
+// [기본 오브젝트 클래스]
+// -------------------------------------------------------
+class GameObject {
+public:
+    vec3 position;
+    vec3 scale;
+    vec3 rotation;
+    vec3 color;
+
+    // [물리 변수]
+    vec3 velocity;
+    vec3 force;
+    float mass;
+    bool isStatic;
+
+    deque<std::pair<vec3, vec3>> trails;
+
+    // [컬링] sceneCuller 칸. 크기 scale 인 상자를 rotation 으로 돌린 월드 경계 구 + AABB (잔상 포함)
+    int cullSlot;
+
+    GameObject(vec3 pos, vec3 sz, vec3 col)
+        : position(pos), scale(sz), rotation(0.0f, 0.0f, 0.0f), color(col),
+        velocity(0.0f), force(0.0f), mass(1.0f), isStatic(true), cullSlot(-1),
+        boundsPos(0.0f), boundsScale(0.0f), boundsRot(0.0f), boundsTrails(false) {
+    }
+
+    virtual ~GameObject() {}
+
+    void UpdatePhysics(float dt, float currentFloorY) {
+        if (isStatic) return;
+
+        vec3 gravity(0.0f, -20.0f, 0.0f);
+        force += gravity * mass;
+        force -= velocity * 0.1f;
+
+        vec3 accel = force / mass;
+        velocity += accel * dt;
+        position += velocity * dt;
+
+        float halfHeight = scale.y / 2.0f;
+        float bottomY = position.y - halfHeight;
+
+        if (bottomY < currentFloorY) {
+            position.y = currentFloorY + halfHeight;
+            if (velocity.y < 0) {
+                velocity.y = 0.0f;
+                velocity.x *= 0.9f;
+                velocity.z *= 0.9f;
+            }
+        }
+        force = vec3(0.0f);
+    }
+
+    void UpdateTrails(bool isHeld) {
+        // 잡았을 때
+        if (isHeld) {
+            trails.push_front({ position, scale }); // 현재 상태 저장
+            if (trails.size() > 7) trails.pop_back(); // 최대 10개
+        }
+        else {
+            // 움직임이 멈추면 잔상이 서서히 사라짐
+            if (!trails.empty()) trails.pop_back();
+        }
+    }
+
+    // 위치/크기/회전이 그대로이고 잔상도 없으면 아무것도 안 함
+    void UpdateBounds() {
+        bool moved = position != boundsPos || scale != boundsScale || rotation != boundsRot;
+        if (cullSlot >= 0 && !moved && trails.empty() && !boundsTrails) return;
+        if (cullSlot < 0) cullSlot = sceneCuller.Add();
+        boundsPos = position;
+        boundsScale = scale;
+        boundsRot = rotation;
+        boundsTrails = !trails.empty();
+
+        vec3 extent = RotatedExtent(scale * 0.5f);
+        if (trails.empty()) {
+            sceneCuller.Set(cullSlot, position, length(scale * 0.5f), position - extent, position + extent);
+            return;
+        }
+        vec3 boxMin = position - extent, boxMax = position + extent;
+        for (auto& t : trails) {
+            vec3 e = RotatedExtent(t.second * 0.5f);
+            boxMin = min(boxMin, t.first - e);
+            boxMax = max(boxMax, t.first + e);
+        }
+        vec3 center = (boxMin + boxMax) * 0.5f;
+        sceneCuller.Set(cullSlot, center, length(boxMax - center), boxMin, boxMax);
+    }
+
+    virtual void Draw() = 0;
+
+    // 그림자 도형: shadowMat 을 곱한 뒤 본체와 같은 변환으로 (색/조명은 호출자)
+    virtual void DrawShadowGeometry(float* shadowMat) {}
+
+    // DrawShadowGeometry 가 지금 그리는 도형의 세밀도 (바뀌면 그림자 맵 캐시도 다시 그려야 함)
+    virtual int ShadowLod() const { return 0; }
+
+    // 렌더 큐에 넣기. 기본은 Draw() 를 custom 항목으로 (상태를 스스로 다룸)
+    virtual void Submit(RenderQueue& queue, const vec3& eye) {
+        queue.AddCustom(PASS_OPAQUE, RenderState(), distance(eye, position), [this] { Draw(); });
+    }
+
+    // 바닥과 겹침 방지(Z-Fighting) 를 위해 아주 살짝 띄움 (Y축 +0.01)
+    void SubmitShadow(RenderQueue& queue, float* shadowMat) {
+        RenderState state;
+        state.lighting = false;
+        queue.Add(PASS_SHADOW, state, 0.0f, [this, shadowMat] {
+            glPushMatrix();
+            glTranslatef(0.0f, 0.01f, 0.0f);
+            glColor3f(0.0f, 0.0f, 0.0f);
+            DrawShadowGeometry(shadowMat);
+            glPopMatrix();
+        });
+    }
+
+private:
+    // 반 크기 half 인 상자를 glRotatef(x) -> (y) -> (z) 순서로 돌렸을 때의 월드 축 반 크기
+    vec3 RotatedExtent(vec3 half) const {
+        vec3 ax = RotateXYZ(vec3(half.x, 0.0f, 0.0f));
+        vec3 ay = RotateXYZ(vec3(0.0f, half.y, 0.0f));
+        vec3 az = RotateXYZ(vec3(0.0f, 0.0f, half.z));
+        return abs(ax) + abs(ay) + abs(az);
+    }
+
+    vec3 RotateXYZ(vec3 v) const {
+        float rx = radians(rotation.x), ry = radians(rotation.y), rz = radians(rotation.z);
+        v = vec3(v.x * cos(rz) - v.y * sin(rz), v.x * sin(rz) + v.y * cos(rz), v.z);
+        v = vec3(v.x * cos(ry) + v.z * sin(ry), v.y, -v.x * sin(ry) + v.z * cos(ry));
+        return vec3(v.x, v.y * cos(rx) - v.z * sin(rx), v.y * sin(rx) + v.z * cos(rx));
+    }
+
+    vec3 boundsPos, boundsScale, boundsRot;
+    bool boundsTrails;
+};
+
+// -------------------------------------------------------
+// [큐브]
+// -------------------------------------------------------
+class Cube : public GameObject {
+public:
+    // 면 텍스처 3장을 묶은 아틀라스 (레이어 0:앞뒤, 1:위아래, 2:좌우)
+    static const int FACE_LAYERS = UnitCubeMesh::ATLAS_LAYERS;
+    GLuint atlasID;
+    bool hasTexture;
+
+    Cube(vec3 pos, vec3 sz, vec3 col) : GameObject(pos, sz, col) {
+        mass = 5.0f;
+        atlasID = 0;
+        hasTexture = false;
+    }
+
+    ~Cube() {
+        ReleaseTextures();
+    }
+
+    // [추가] 텍스처 설정 함수 (같은 파일은 레지스트리에서 공유)
+    // 세 장은 아틀라스 한 장으로 묶여서 면마다 바인드를 바꾸지 않고 한 번에 그림
+    void SetTextures(const char* file1, const char* file2, const char* file3) {
+        ReleaseTextures();
+        vector<string> faces;
+        faces.push_back(file1); // 앞/뒤
+        faces.push_back(file2); // 위/아래
+        faces.push_back(file3); // 좌/우
+        atlasID = textureRegistry.AcquireAtlas(faces);
+
+        if (atlasID != 0) hasTexture = true;
+    }
+
+    void ReleaseTextures() {
+        textureRegistry.Release(atlasID);
+        atlasID = 0;
+        hasTexture = false;
+    }
+
+    // 도형만 (조명/아틀라스/블렌드 상태는 Submit 이 렌더 큐에 맡김)
+    void Draw() override {
+        DrawBody();
+        if (!trails.empty()) DrawTrails();
+    }
+
+    // 상태는 큐가 맞춤: 텍스처 큐브는 조명 없이 아틀라스를 REPLACE 로, 아니면 조명 받는 단색
+    void Submit(RenderQueue& queue, const vec3& eye) override {
+        RenderState state;
+        if (hasTexture) {
+            state.lighting = false;
+            state.texture = atlasID;
+            state.envMode = GL_REPLACE;
+        }
+        float depth = distance(eye, position);
+        queue.Add(PASS_OPAQUE, state, depth, [this] { DrawBody(); });
+
+        if (!trails.empty()) {
+            RenderState trail;
+            trail.blend = BLEND_ALPHA;
+            queue.Add(PASS_TRANSPARENT, trail, depth, [this] { DrawTrails(); });
+        }
+    }
+
+    // 그림자 그리기 (3축 회전 적용)
+    void DrawShadowGeometry(float* shadowMat) override {
+        glPushMatrix();
+        glMultMatrixf(shadowMat);
+        glTranslatef(position.x, position.y, position.z);
+        glRotatef(rotation.x, 1, 0, 0);
+        glRotatef(rotation.y, 0, 1, 0);
+        glRotatef(rotation.z, 0, 0, 1);
+        glScalef(scale.x, scale.y, scale.z);
+        unitCube.Draw();
+        glPopMatrix();
+    }
+
+private:
+    // 면마다 UV 의 v 가 아틀라스 레이어를 고름 -> 바인드 1번, 그리기 1번 (텍스처 상태는 호출자)
+    void DrawBody() {
         glPushMatrix();
-        glMultMatrixf(shadowMat);
         glTranslatef(position.x, position.y, position.z);
+
+        // 3축 회전 적용
         glRotatef(rotation.x, 1, 0, 0);
         glRotatef(rotation.y, 0, 1, 0);
         glRotatef(rotation.z, 0, 0, 1);
+
         glScalef(scale.x, scale.y, scale.z);
-        glDisable(GL_LIGHTING);
-        glColor3f(0.0f, 0.0f, 0.0f);
-        glutSolidCube(1.0f);
-        glEnable(GL_LIGHTING);
+
+        if (hasTexture) {
+            glColor3f(1.0f, 1.0f, 1.0f); // 텍스처 본연의 색 유지
+            unitCube.Draw(true);
+        }
+        else {
+            // 텍스처 없는 일반 큐브 (조명 받음)
+            glColor3f(color.r, color.g, color.b);
+            unitCube.Draw();
+        }
+
         glPopMatrix();
     }
+
+    // 잔상: 버퍼는 한 번만 바인드하고 잔상마다 그리기 1번 (블렌드는 호출자)
+    void DrawTrails() {
+        float alpha = 0.5f;
+        unitCube.Bind(false);
+        for (auto& t : trails) {
+            glPushMatrix();
+            glTranslatef(t.first.x, t.first.y, t.first.z);
+            glRotatef(rotation.x, 1, 0, 0); glRotatef(rotation.y, 0, 1, 0); glRotatef(rotation.z, 0, 0, 1);
+            glScalef(t.second.x, t.second.y, t.second.z);
+            glColor4f(0.8f, 0.6f, 0.4f, alpha);
+            unitCube.DrawBound();
+            glPopMatrix();
+            alpha -= 0.05f;
+        }
+        UnitCubeMesh::Unbind();
+    }
 };
 
 // -------------------------------------------------------
@@ -332,47 +3834,114 @@ public:
         mass = 2.0f;
     }
 
+    // 도형만 (잔상 블렌드는 Submit 이 렌더 큐에 맡김)
     void Draw() override {
+        DrawBody();
+        if (!trails.empty()) DrawTrails();
+    }
+
+    // 본체 LOD 는 여기서 정해서 그림자(받는 쪽 깊이 비교 포함) 까지 같은 단계로
+    void Submit(RenderQueue& queue, const vec3& eye) override {
+        lodEye = eye;
+        lodLevel = sphereMesh.LevelFor(position, std::max(scale.x, std::max(scale.y, scale.z)) * 0.5f, eye);
+        float depth = distance(eye, position);
+        queue.Add(PASS_OPAQUE, RenderState(), depth, [this] { DrawBody(); });
+        if (!trails.empty()) {
+            RenderState trail;
+            trail.blend = BLEND_ALPHA;
+            queue.Add(PASS_TRANSPARENT, trail, depth, [this] { DrawTrails(); });
+        }
+    }
+
+    void DrawShadowGeometry(float* shadowMat) override {
         glPushMatrix();
+        glMultMatrixf(shadowMat);
         glTranslatef(position.x, position.y, position.z);
         glScalef(scale.x, scale.y, scale.z);
-        glColor3f(color.r, color.g, color.b);
-        glutSolidSphere(0.5f, 32, 32);
+        sphereMesh.Draw(lodLevel);
         glPopMatrix();
+    }
 
-        if (!trails.empty()) {
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    int ShadowLod() const override { return lodLevel; }
 
-            float alpha = 0.5f;
-            for (auto& t : trails) {
-                glPushMatrix();
-                glTranslatef(t.first.x, t.first.y, t.first.z);
-                glScalef(t.second.x, t.second.y, t.second.z);
-                glColor4f(0.5f, 0.8f, 1.0f, alpha);
-                glutSolidSphere(0.5f, 16, 16);
-                glPopMatrix();
-                alpha -= 0.05f;
-            }
-            glDisable(GL_BLEND);
+private:
+    int lodLevel = 0;
+    vec3 lodEye = vec3(0.0f);
+
+    void DrawBody() {
+        glPushMatrix();
+        glTranslatef(position.x, position.y, position.z);
+        glScalef(scale.x, scale.y, scale.z);
+        glColor3f(color.r, color.g, color.b);
+        sphereMesh.Draw(lodLevel);
+        glPopMatrix();
+    }
+
+    // 버퍼는 한 번만 묶고 잔상마다 자기 화면 크기의 단계로
+    void DrawTrails() {
+        float alpha = 0.5f;
+        sphereMesh.Bind();
+        for (auto& t : trails) {
+            glPushMatrix();
+            glTranslatef(t.first.x, t.first.y, t.first.z);
+            glScalef(t.second.x, t.second.y, t.second.z);
+            glColor4f(0.5f, 0.8f, 1.0f, alpha);
+            sphereMesh.DrawBound(sphereMesh.LevelFor(t.first, std::max(t.second.x, std::max(t.second.y, t.second.z)) * 0.5f, lodEye));
+            glPopMatrix();
+            alpha -= 0.05f;
         }
+        SphereMeshCache::Unbind();
+    }
+};
+
+// -------------------------------------------------------
+// [메쉬 오브젝트] StaticMesh 를 바운딩 박스 중심/높이 기준으로 배치
+// -------------------------------------------------------
+// MeshT: boundsMin/boundsMax, Draw(), IsLoaded() 를 가진 메쉬 (StaticMesh, TexturedMesh)
+template <class MeshT>
+class MeshObjectOf : public GameObject {
+public:
+    const MeshT* mesh;
+
+    // height: 월드 높이, 나머지 축은 메쉬 비율대로 (scale 이 곧 AABB 크기)
+    MeshObjectOf(const MeshT* m, vec3 pos, float height, vec3 col) : GameObject(pos, vec3(height), col), mesh(m) {
+        vec3 extent = m->boundsMax - m->boundsMin;
+        if (extent.y > 0.0f) scale = extent * (height / extent.y);
     }
 
-    void DrawShadow(float* shadowMat) override {
-        if (!shadowMat) return;
+    void Draw() override {
+        if (!mesh->IsLoaded()) return;
+        glPushMatrix();
+        ApplyTransform();
+        glColor3f(color.r, color.g, color.b);
+        mesh->Draw();
+        glPopMatrix();
+    }
 
+    void DrawShadowGeometry(float* shadowMat) override {
+        if (!mesh->IsLoaded()) return;
         glPushMatrix();
         glMultMatrixf(shadowMat);
-        glTranslatef(position.x, position.y, position.z);
-        glScalef(scale.x, scale.y, scale.z);
-        glDisable(GL_LIGHTING);
-        glColor3f(0.0f, 0.0f, 0.0f);
-        glutSolidSphere(0.5f, 32, 32);
-        glEnable(GL_LIGHTING);
+        ApplyTransform();
+        mesh->Draw();
         glPopMatrix();
     }
+
+private:
+    void ApplyTransform() const {
+        vec3 extent = mesh->boundsMax - mesh->boundsMin;
+        vec3 center = (mesh->boundsMin + mesh->boundsMax) * 0.5f;
+        float s = (extent.y > 0.0f) ? scale.y / extent.y : 1.0f;
+        glTranslatef(position.x, position.y, position.z);
+        glRotatef(rotation.y, 0, 1, 0);
+        glScalef(s, s, s);
+        glTranslatef(-center.x, -center.y, -center.z);
+    }
 };
 
+typedef MeshObjectOf<StaticMesh> MeshObject;
+typedef MeshObjectOf<TexturedMesh> TexturedMeshObject;
+
 // -------------------------------------------------------
 // [구멍 뚫린 벽] 
 // -------------------------------------------------------
@@ -425,9 +3994,296 @@ public:
         }
     }
 
-    void DrawShadow(float* shadowMat) {}
+    void Submit(RenderQueue& queue, const vec3& eye) override {
+        for (Cube* c : collisionCubes) c->Submit(queue, eye);
+    }
+
+    void DrawShadowGeometry(float* shadowMat) override {
+        for (Cube* c : collisionCubes) c->DrawShadowGeometry(shadowMat);
+    }
+};
+
+// -------------------------------------------------------
+// [그림자 맵] 조명에서 본 깊이 텍스처 + PCF
+// -------------------------------------------------------
+// 점광원(받는 영역보다 위) 에서 아래를 보는 원근 투영을 받는 영역 AABB 에 맞추고, 그림자를 드리우는
+// 물체를 깊이 텍스처에 그립니다. 정적 물체 층은 따로 두고 (집합이나 위치가 바뀔 때만 다시), 동적 물체가
+// 움직인 프레임에만 정적 층을 복사(blit) 한 위에 동적 물체를 다시 그림. 아무것도 안 움직이면 그대로 재사용.
+// 받는 쪽은 불투명 패스 뒤에 같은 도형을 한 번 더 (깊이 LEQUAL, 쓰기 없음) 그리고, 셰이더가 3x3 PCF
+// (탭마다 하드웨어 2x2 비교 필터) 로 가려진 정도를 구해 곱하기 블렌드로 어둡게 합니다.
+// GL 3.0 (FBO + blit) 이 없으면 Ready() 가 false: 호출자는 평면 투영 그림자를 씀.
+const char* SHADOW_VERTEX_SHADER =
+    "#version 120\n"
+    "uniform mat4 shadowMatrix;     // 눈 좌표 -> 그림자 맵 (바이어스 * 조명 투영 * 조명 뷰 * 카메라 뷰 역행렬)\n"
+    "varying vec4 shadowCoord;\n"
+    "void main() {\n"
+    "    shadowCoord = shadowMatrix * (gl_ModelViewMatrix * gl_Vertex);\n"
+    "    gl_Position = ftransform();\n"
+    "}\n";
+
+const char* SHADOW_FRAGMENT_SHADER =
+    "#version 120\n"
+    "uniform sampler2DShadow shadowMap;\n"
+    "uniform float texel;\n"
+    "uniform float darkness;\n"
+    "varying vec4 shadowCoord;\n"
+    "void main() {\n"
+    "    float lit = 0.0;\n"
+    "    for (int y = -1; y <= 1; y++)\n"
+    "        for (int x = -1; x <= 1; x++)\n"
+    "            lit += shadow2DProj(shadowMap, shadowCoord + vec4(vec2(x, y) * texel * shadowCoord.w, 0.0, 0.0)).r;\n"
+    "    lit = (shadowCoord.w > 0.0) ? lit / 9.0 : 1.0;\n"
+    "    gl_FragColor = vec4(vec3(1.0 - darkness * (1.0 - lit)), 1.0);\n"
+    "}\n";
+
+class ShadowMapper {
+public:
+    struct Stats {
+        int staticRenders;      // 정적 층을 다시 그린 횟수
+        int dynamicRenders;     // 정적 층 복사 + 동적 물체를 그린 횟수
+        int reusedFrames;       // 그대로 재사용한 프레임
+    };
+
+    float darkness = 0.6f;      // 완전히 가려진 곳의 어두워지는 비율
+
+    ShadowMapper() : size(0), program(0), shadowMatrixLoc(-1), texelLoc(-1), darknessLoc(-1), staticDirty(true), dynamicDirty(true),
+        stats{ 0, 0, 0 } {
+        fbo[0] = fbo[1] = depth[0] = depth[1] = 0;
+        for (int i = 0; i < 16; i++) lightView[i] = lightProj[i] = identity[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        lightKey[0] = lightKey[1] = lightKey[2] = vec3(0.0f);
+    }
+
+    // depth[0]: 정적 층, depth[1]: 정적 + 동적 (받는 쪽이 읽음)
+    void Init(int mapSize = 2048) {
+        if (!GLEW_VERSION_3_0) {
+            cout << "[Shadow] GL 3.0 이 없어 평면 투영 그림자를 씁니다" << endl;
+            return;
+        }
+        program = BuildProgram(SHADOW_VERTEX_SHADER, SHADOW_FRAGMENT_SHADER, vector<pair<GLuint, const char*>>());
+        if (!program) return;
+        shadowMatrixLoc = glGetUniformLocation(program, "shadowMatrix");
+        texelLoc = glGetUniformLocation(program, "texel");
+        darknessLoc = glGetUniformLocation(program, "darkness");
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "shadowMap"), 1);
+        glUseProgram(0);
+
+        size = mapSize;
+        const GLfloat border[4] = { 1.0f, 1.0f, 1.0f, 1.0f };   // 맵 밖은 빛을 받음
+        glGenTextures(2, depth);
+        glGenFramebuffers(2, fbo);
+        bool complete = true;
+        for (int i = 0; i < 2; i++) {
+            glBindTexture(GL_TEXTURE_2D, depth[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, size, size, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+            glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth[i], 0);
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+            complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        if (!complete) {
+            cout << "[Shadow] 깊이 FBO 를 만들 수 없어 평면 투영 그림자를 씁니다" << endl;
+            Release();
+            return;
+        }
+        cout << "[Shadow] " << size << "x" << size << " 깊이 맵, 3x3 PCF" << endl;
+    }
+
+    bool Ready() const { return fbo[1] != 0; }
+
+    // lightPos: 점광원, boxMin/boxMax: 그림자를 받는 영역 (조명보다 아래). 바뀌었을 때만 행렬을 다시 맞춤
+    void SetLight(const float* lightPos, vec3 boxMin, vec3 boxMax) {
+        vec3 light(lightPos[0], lightPos[1], lightPos[2]);
+        if (light == lightKey[0] && boxMin == lightKey[1] && boxMax == lightKey[2]) return;
+        lightKey[0] = light; lightKey[1] = boxMin; lightKey[2] = boxMax;
+        staticDirty = true;
+
+        // 아래(-y) 를 보고 위쪽이 -z 인 카메라: (x, -z, y) - 조명
+        for (int i = 0; i < 16; i++) lightView[i] = 0.0f;
+        lightView[0] = 1.0f; lightView[9] = -1.0f; lightView[6] = 1.0f; lightView[15] = 1.0f;
+        lightView[12] = -light.x; lightView[13] = light.z; lightView[14] = -light.y;
+
+        // 상자 꼭짓점 8개가 들어가는 비대칭 절두체 (가까운 면 1, 먼 면은 가장 낮은 바닥 너머)
+        const float zNear = 1.0f, zFar = light.y - boxMin.y + 1.0f;
+        float l = 1e30f, r = -1e30f, b = 1e30f, t = -1e30f;
+        for (int i = 0; i < 8; i++) {
+            vec3 c((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z);
+            float d = std::max(light.y - c.y, zNear);
+            float x = (c.x - light.x) / d, y = -(c.z - light.z) / d;
+            l = std::min(l, x); r = std::max(r, x);
+            b = std::min(b, y); t = std::max(t, y);
+        }
+        l *= zNear; r *= zNear; b *= zNear; t *= zNear;
+        for (int i = 0; i < 16; i++) lightProj[i] = 0.0f;
+        lightProj[0] = 2.0f * zNear / (r - l);
+        lightProj[5] = 2.0f * zNear / (t - b);
+        lightProj[8] = (r + l) / (r - l);
+        lightProj[9] = (t + b) / (t - b);
+        lightProj[10] = -(zFar + zNear) / (zFar - zNear);
+        lightProj[11] = -1.0f;
+        lightProj[14] = -2.0f * zFar * zNear / (zFar - zNear);
+    }
+
+    // 그림자를 드리우는 물체 (isStatic 으로 층을 나눔). 층별로 집합/변환이 바뀐 경우에만 다시 그림
+    void Update(const vector<GameObject*>& casters) {
+        if (!Ready()) return;
+        vector<Caster> statics, dynamics;
+        for (GameObject* obj : casters) {
+            Caster c = { obj, obj->position, obj->rotation, obj->scale, obj->ShadowLod() };
+            (obj->isStatic ? statics : dynamics).push_back(c);
+        }
+        if (!Same(statics, lastStatic)) staticDirty = true;
+        if (!Same(dynamics, lastDynamic)) dynamicDirty = true;
+        if (!staticDirty && !dynamicDirty) {
+            stats.reusedFrames++;
+            return;
+        }
+
+        GLint viewport[4], target = 0;
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target);
+        glViewport(0, 0, size, size);
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadMatrixf(lightProj);
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadMatrixf(lightView);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDisable(GL_LIGHTING);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+
+        if (staticDirty) {
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo[0]);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            for (auto& c : statics) c.obj->DrawShadowGeometry(identity);
+            lastStatic = statics;
+            stats.staticRenders++;
+        }
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[0]);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo[1]);
+        glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo[1]);
+        for (auto& c : dynamics) c.obj->DrawShadowGeometry(identity);
+        lastDynamic = dynamics;
+        stats.dynamicRenders++;
+        staticDirty = dynamicDirty = false;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, target);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glEnable(GL_LIGHTING);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glPopMatrix();
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+
+    // 받는 물체를 그림자 패스에 (지금 모델뷰 = 카메라 뷰여야 함: 강체 변환이라 전치로 역행렬)
+    void SubmitReceivers(RenderQueue& queue, const vector<GameObject*>& receivers) {
+        if (!Ready() || receivers.empty()) return;
+        float view[16], invView[16], lightViewProj[16], world[16];
+        glGetFloatv(GL_MODELVIEW_MATRIX, view);
+        for (int c = 0; c < 3; c++)
+            for (int r = 0; r < 3; r++) invView[c * 4 + r] = view[r * 4 + c];
+        for (int r = 0; r < 3; r++) invView[12 + r] = -(view[r * 4] * view[12] + view[r * 4 + 1] * view[13] + view[r * 4 + 2] * view[14]);
+        invView[3] = invView[7] = invView[11] = 0.0f;
+        invView[15] = 1.0f;
+
+        // [-1, 1] -> [0, 1]
+        float bias[16] = { 0.5f, 0, 0, 0, 0, 0.5f, 0, 0, 0, 0, 0.5f, 0, 0.5f, 0.5f, 0.5f, 1.0f };
+        Multiply(lightProj, lightView, lightViewProj);
+        Multiply(lightViewProj, invView, world);
+        Multiply(bias, world, shadowMatrix);
+
+        RenderState state;
+        state.lighting = false;
+        state.depthWrite = false;
+        vector<GameObject*> list = receivers;
+        queue.AddCustom(PASS_SHADOW, state, 0.0f, [this, list] {
+            glUseProgram(program);
+            glUniformMatrix4fv(shadowMatrixLoc, 1, GL_FALSE, shadowMatrix);
+            glUniform1f(texelLoc, 1.0f / size);
+            glUniform1f(darknessLoc, darkness);
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, depth[1]);
+            glActiveTexture(GL_TEXTURE0);
+            glDepthFunc(GL_LEQUAL);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ZERO, GL_SRC_COLOR);     // 화면 색 *= 셰이더 출력
+
+            for (GameObject* obj : list) obj->DrawShadowGeometry(identity);
+
+            glDisable(GL_BLEND);
+            glDepthFunc(GL_LESS);
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glActiveTexture(GL_TEXTURE0);
+            glUseProgram(0);
+        });
+    }
+
+    void PrintStats() const {
+        cout << "[Shadow] " << (Ready() ? "depth map" : "planar") << ": static layer rendered " << stats.staticRenders
+            << "x, dynamic " << stats.dynamicRenders << "x, reused " << stats.reusedFrames << " frames" << endl;
+    }
+
+private:
+    struct Caster {
+        GameObject* obj;
+        vec3 position, rotation, scale;
+        int lod;
+    };
+
+    static bool Same(const vector<Caster>& a, const vector<Caster>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++)
+            if (a[i].obj != b[i].obj || a[i].position != b[i].position || a[i].rotation != b[i].rotation || a[i].scale != b[i].scale ||
+                a[i].lod != b[i].lod) return false;
+        return true;
+    }
+
+    // out = a * b (열 우선)
+    static void Multiply(const float* a, const float* b, float* out) {
+        for (int c = 0; c < 4; c++)
+            for (int r = 0; r < 4; r++)
+                out[c * 4 + r] = a[r] * b[c * 4] + a[4 + r] * b[c * 4 + 1] + a[8 + r] * b[c * 4 + 2] + a[12 + r] * b[c * 4 + 3];
+    }
+
+    void Release() {
+        if (fbo[0]) glDeleteFramebuffers(2, fbo);
+        if (depth[0]) glDeleteTextures(2, depth);
+        fbo[0] = fbo[1] = depth[0] = depth[1] = 0;
+    }
+
+    int size;
+    GLuint fbo[2], depth[2];
+    GLuint program;
+    GLint shadowMatrixLoc, texelLoc, darknessLoc;
+    float lightView[16], lightProj[16], shadowMatrix[16];
+    float identity[16];             // DrawShadowGeometry 에 넘기는 단위 행렬 (평면 투영 없이 도형만)
+    vec3 lightKey[3];
+    vector<Caster> lastStatic, lastDynamic;
+    bool staticDirty, dynamicDirty;
+    Stats stats;
 };
 
+ShadowMapper shadowMapper;
+
 // -------------------------------------------------------
 // [버튼]
 // -------------------------------------------------------
@@ -437,7 +4293,17 @@ public:
     bool isPressed;
     GameObject* targetObj;
 
-    Button(vec3 pos, GameObject* target) : position(pos), targetObj(target), isPressed(false) {}
+    int cullSlot;
+
+    Button(vec3 pos, GameObject* target) : position(pos), targetObj(target), isPressed(false), cullSlot(-1) {}
+
+    // 버튼은 움직이지 않으므로 처음 한 번만
+    void UpdateBounds() {
+        if (cullSlot >= 0) return;
+        cullSlot = sceneCuller.Add();
+        vec3 center = position + vec3(0.0f, 0.1f, 0.0f), half(1.0f, 0.1f, 1.0f);
+        sceneCuller.Set(cullSlot, center, length(half), center - half, center + half);
+    }
 
     void Update() {
         if (!targetObj) { isPressed = false; return; }
@@ -450,21 +4316,19 @@ public:
         else isPressed = false;
     }
 
-    void Draw() {
-        glPushMatrix();
-        glTranslatef(position.x, position.y + 0.1f, position.z);
-        glScalef(2.0f, 0.2f, 2.0f);
-        if (isPressed) {
-            glColor3f(0.0f, 1.0f, 0.0f);
-            float em[] = { 0, 0.8f, 0, 1 }; glMaterialfv(GL_FRONT, GL_EMISSION, em);
-        }
-        else {
-            glColor3f(1.0f, 0.0f, 0.0f);
-            float em[] = { 0.8f, 0, 0, 1 }; glMaterialfv(GL_FRONT, GL_EMISSION, em);
-        }
-        glutSolidCube(1.0f);
-        float noEm[] = { 0, 0, 0, 1 }; glMaterialfv(GL_FRONT, GL_EMISSION, noEm);
-        glPopMatrix();
+    // 눌리면 초록, 아니면 빨강으로 스스로 빛남 (발광 재질은 큐가 설정/복구)
+    void Submit(RenderQueue& queue, const vec3& eye) {
+        RenderState state;
+        state.material = isPressed ? MATERIAL_GLOW_GREEN : MATERIAL_GLOW_RED;
+        queue.Add(PASS_OPAQUE, state, distance(eye, position), [this] {
+            glPushMatrix();
+            glTranslatef(position.x, position.y + 0.1f, position.z);
+            glScalef(2.0f, 0.2f, 2.0f);
+            if (isPressed) glColor3f(0.0f, 1.0f, 0.0f);
+            else glColor3f(1.0f, 0.0f, 0.0f);
+            glutSolidCube(1.0f);
+            glPopMatrix();
+        });
     }
 };
 
@@ -477,6 +4341,7 @@ public:
         vec3 pos;
         vec3 scale;
         vec3 rot;
+        int cullSlot;
     };
     vector<Piece> pieces;
 
@@ -489,43 +4354,42 @@ public:
         projectorPos = vec3(12.0f, 6.0f, -32.0f);
         lookAtTarget = vec3(-6.0f, 4.0f, -50.0f);
         texID = 0;
+        seed = 1;
     }
 
     void AddPiece(vec3 position, float size) {
         Piece p;
         p.pos = position;
         p.scale = vec3(size, size, size);
-        p.rot = vec3(rand() % 360, rand() % 360, rand() % 360); // 회전은 랜덤이 자연스러움
+        p.rot = vec3(Rand() % 360, Rand() % 360, Rand() % 360); // 회전은 랜덤이 자연스러움
+        p.cullSlot = -1;
         pieces.push_back(p);
     }
 
     void Init(const char* texturePath) {
+        RequestTexture(texturePath);
+        GeneratePieces();
+    }
+
+    // 텍스처는 백그라운드 로드 (그동안 조각들은 플레이스홀더로 그려짐). GL 스레드에서
+    void RequestTexture(const char* texturePath) {
+        texID = textureStreamer.Request(texturePath);
+    }
+
+    // 조각 배치 (GL 없음, 워커 스레드에서 가능)
+    void GeneratePieces() {
         float spreadX = 10.0f; float spreadY = 10.0f; float spreadZ = 9.0f;
         float centerY = 5.0f; float centerZ = -45.0f;
         float minSize = 1.0f; float maxSize = 2.0f;
 
-
-        int w, h;
-        unsigned char* data = LoadBMP(texturePath, &w, &h);
-        if (data) {
-            glGenTextures(1, &texID);
-            glBindTexture(GL_TEXTURE_2D, texID);
-            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-            delete[] data;
-        }
-
+        seed = 1;
         pieces.clear();
         for (int i = 0; i < 70; i++) {
             Piece p;
-            float r1 = (rand() % 1000) / 1000.0f;
-            float r2 = (rand() % 1000) / 1000.0f;
-            float r3 = (rand() % 1000) / 1000.0f;
-            float r4 = (rand() % 1000) / 1000.0f;
+            float r1 = (Rand() % 1000) / 1000.0f;
+            float r2 = (Rand() % 1000) / 1000.0f;
+            float r3 = (Rand() % 1000) / 1000.0f;
+            float r4 = (Rand() % 1000) / 1000.0f;
 
             float rx = (r1 * spreadX) - (spreadX / 2.0f);
             float ry = (r2 * spreadY) - (spreadY / 2.0f) + centerY;
@@ -534,7 +4398,8 @@ public:
             p.pos = vec3(rx, ry, rz);
             float scale = minSize + (r4 * (maxSize - minSize));
             p.scale = vec3(scale, scale, scale);
-            p.rot = vec3(rand() % 360, rand() % 360, rand() % 360);
+            p.rot = vec3(Rand() % 360, Rand() % 360, Rand() % 360);
+            p.cullSlot = -1;
             pieces.push_back(p);
         }
         AddPiece(vec3(-2.9436f, 5.79062f, -41.6549f), 1.5f);
@@ -562,14 +4427,34 @@ public:
         return vec2(u, v);
     }
 
-    void Draw() {
+    // 조각은 움직이지 않으므로 처음 한 번만 (회전과 무관한 외접 구 + 그 구를 감싸는 AABB)
+    void UpdateBounds() {
+        for (auto& p : pieces) {
+            if (p.cullSlot >= 0) continue;
+            p.cullSlot = sceneCuller.Add();
+            float r = p.scale.x * 0.5f * sqrt(3.0f);
+            sceneCuller.Set(p.cullSlot, p.pos, r, p.pos - vec3(r), p.pos + vec3(r));
+        }
+    }
+
+    // 조명 없이 프로젝터 텍스처를 REPLACE 로 (상태는 큐가). 절두체 안 조각만
+    void Submit(RenderQueue& queue, const vec3& eye) {
         if (texID == 0) return;
-        glDisable(GL_LIGHTING);
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, texID);
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+        drawList.clear();
+        for (int i = 0; i < (int)pieces.size(); i++)
+            if (sceneCuller.Test(pieces[i].cullSlot)) drawList.push_back(i);
+        if (drawList.empty()) return;
+
+        RenderState state;
+        state.lighting = false;
+        state.texture = texID;
+        state.envMode = GL_REPLACE;
+        queue.Add(PASS_OPAQUE, state, distance(eye, lookAtTarget), [this] { DrawPieces(); });
+    }
 
-        for (const auto& p : pieces) {
+    void DrawPieces() {
+        for (int index : drawList) {
+            const Piece& p = pieces[index];
             glPushMatrix();
             glTranslatef(p.pos.x, p.pos.y, p.pos.z);
             glRotatef(p.rot.x, 1, 0, 0); glRotatef(p.rot.y, 0, 1, 0); glRotatef(p.rot.z, 0, 0, 1);
@@ -598,14 +4483,22 @@ public:
             glEnd();
             glPopMatrix();
         }
-        glDisable(GL_TEXTURE_2D);
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-        glEnable(GL_LIGHTING);
     }
 
     bool CheckSolved(vec3 playerPos) {
         return (distance(playerPos, projectorPos) < 2.0f);
     }
+
+private:
+    // 전에는 srand 전의 rand() (시드 1) 를 썼으므로, 같은 배치가 나오도록 MSVC rand() 와 같은 LCG 를 시드 1 부터.
+    // 전역 rand() 상태를 건드리지 않으니 다른 스레드에서 만들어도 됨
+    int Rand() {
+        seed = seed * 214013u + 2531011u;
+        return (int)((seed >> 16) & 0x7fff);
+    }
+
+    unsigned int seed;
+    vector<int> drawList;   // 이번 프레임에 보이는 조각
 };
 
 // -------------------------------------------------------
@@ -692,6 +4585,8 @@ Cube* room2Top;
 WallWithHole* room2RightHole;
 Button* btnRoom2;
 Cube* rotatedBox;
+MeshObject* bunny;
+TexturedMeshObject* statue;
 
 GameObject* heldObject = nullptr;
 float grabDistance = 0.0f;
@@ -760,6 +4655,10 @@ bool CheckOverlapXZ(vec3 posA, vec3 scaleA, vec3 posB, vec3 scaleB) {
 float GetFloorHeightAt(vec3 pos, vec3 scale) {
     float height = 0.0f; // 기본 바닥 높이
 
+    // 두 방 바깥은 지형 높이 (바이리니어, 질의 비용 일정)
+    bool insideRooms = pos.x > -21.0f && pos.x < 21.0f && pos.z > -61.0f && pos.z < 21.0f;
+    if (!insideRooms && terrainField.isLoaded()) height = terrainField.Sample(pos.x, pos.z);
+
     // 1. 기존 발판 체크 (Room 1 바닥)
     if (pos.x < -19.0f && pos.x > -22.0f && pos.z > -2.0f && pos.z < 2.0f) height = 5.5f;
     else if (pos.x > 19.0f && pos.x < 22.0f && pos.z > -2.0f && pos.z < 2.0f) height = 5.5f;
@@ -837,7 +4736,7 @@ void newExplosion(vec3 pos, int startIdx, int pCount, int dStartIdx, int dCount)
         debris[i].position[1] = pos.y;
         debris[i].position[2] = pos.z;
 
-        debris[i].orientation[0] = 0.0; debris[i].orientation[1] = 0.0; debris[i].orientation[2] = 0.0;
+        debris[i].spawnTick = debrisField.Clock();
 
         // [수정] 파편 색상을 어두운 회색/검정으로 (타버린 잔해 느낌)
         debris[i].color[0] = 0.3f; debris[i].color[1] = 0.3f; debris[i].color[2] = 0.3f;
@@ -849,81 +4748,191 @@ void newExplosion(vec3 pos, int startIdx, int pCount, int dStartIdx, int dCount)
         newSpeed(debris[i].speed);
         newSpeed(debris[i].orientationSpeed);
     }
+    particleStream.Spawned(startIdx, pCount);
+    debrisField.Spawned(dStartIdx, dCount);
     fuel = 500; // 폭발 지속 시간 리셋
 }
 
 void UpdateParticles() {
     if (fuel > 0) {
-        for (int i = 0; i < NUM_PARTICLES; i++) {
-            particles[i].position[0] += particles[i].speed[0] * 0.2f;
-            particles[i].position[1] += particles[i].speed[1] * 0.2f;
-            particles[i].position[2] += particles[i].speed[2] * 0.2f;
-            particles[i].color[0] -= 1.0f / 500.0f; if (particles[i].color[0] < 0) particles[i].color[0] = 0;
-            particles[i].color[1] -= 1.0f / 100.0f; if (particles[i].color[1] < 0) particles[i].color[1] = 0;
-            particles[i].color[2] -= 1.0f / 50.0f; if (particles[i].color[2] < 0) particles[i].color[2] = 0;
-        }
-        for (int i = 0; i < NUM_DEBRIS; i++) {
-            debris[i].position[0] += debris[i].speed[0] * 0.1f;
-            debris[i].position[1] += debris[i].speed[1] * 0.1f;
-            debris[i].position[2] += debris[i].speed[2] * 0.1f;
-            debris[i].orientation[0] += debris[i].orientationSpeed[0] * 10.0f;
-            debris[i].orientation[1] += debris[i].orientationSpeed[1] * 10.0f;
-            debris[i].orientation[2] += debris[i].orientationSpeed[2] * 10.0f;
-        }
+        if (particleStream.Simulating()) particleStream.Step(); // 변환 피드백 (particles[] 는 안 건드림)
+        else MoveParticles(particles, NUM_PARTICLES);
+        debrisField.Tick(); // 파편은 경과 틱으로 위치/회전을 계산 (파편 수와 무관)
         fuel--; // [중요] fuel이 0이 되면 멈추지만, 연쇄 폭발 시 fuel을 다시 500으로 설정하므로 문제 없음
     }
 }
 
-void InitObjects() {
-    InitSkybox();
-    myCube = new Cube(vec3(5, 5, 5), vec3(2, 2, 2), vec3(0.8f, 0.6f, 0.4f));
-    myCube->isStatic = false;
-    mySphere = new Sphere(vec3(-5, 5, 5), vec3(2, 2, 2), vec3(0.2f, 0.6f, 1.0f));
-    mySphere->isStatic = false;
-    floorObj = new Cube(vec3(0, -0.5, 0), vec3(40, 1, 40), vec3(0.8f, 0.8f, 0.8f));
-
-    // [Room 1] 벽 생성
-    leftWall = new WallWithHole(vec3(-20, 7.5, 0), vec3(40, 15, 2), vec3(4, 4, 4), vec3(0.7f, 0.7f, 0.7f), 90.0f);
-    rightWall = new WallWithHole(vec3(20, 7.5, 0), vec3(40, 15, 2), vec3(4, 4, 4), vec3(0.7f, 0.7f, 0.7f), -90.0f);
+// 시작 로딩 = 작업 그래프. 파싱/디코딩/생성은 워커 풀에서 병렬로, GL 업로드(텍스처 요청 포함)는
+// 이 스레드에서 원래 코드와 같은 순서로. 끝나면 작업별 시간을 출력합니다.
+chrono::steady_clock::time_point programStart;
+bool firstFrameLogged = false;
 
-    backWall = new Cube(vec3(0, 7.5, 20), vec3(40, 15, 2), vec3(0.7f, 0.7f, 0.7f));
-    ceilingObj = new Cube(vec3(0, 15.5, 0), vec3(40, 1, 40), vec3(0.8f, 0.8f, 0.8f));
-
-    frontWallLeft = new Cube(vec3(-12, 7.5, -20), vec3(16, 15, 2), vec3(0.7f, 0.7f, 0.7f));
-    frontWallRight = new Cube(vec3(12, 7.5, -20), vec3(16, 15, 2), vec3(0.7f, 0.7f, 0.7f));
-    frontDoorTop = new Cube(vec3(0, 12.5, -20), vec3(8, 5, 2), vec3(0.7f, 0.7f, 0.7f));
-
-    exitDoor = new Cube(vec3(0, 5, -20), vec3(8, 10, 1), vec3(0.3f, 0.0f, 0.0f));
-
-    btnLeft = new Button(vec3(-20.0f, 5.5f, 0.0f), mySphere);
-    btnRight = new Button(vec3(20.0f, 5.5f, 0.0f), myCube);
-
-    // [Room 2] 객체 초기화
-    room2Floor = new Cube(vec3(0, -0.5, -40), vec3(40, 1, 40), vec3(0.8f, 0.8f, 0.8f));
-    room2Back = new Cube(vec3(0, 7.5, -60), vec3(40, 15, 2), vec3(0.7f, 0.7f, 0.7f));
-
-    // 왼쪽 벽은 기존처럼 일반 Cube로 유지 (원하시면 WallWithHole로 변경 가능)
-    room2Left = new Cube(vec3(-20, 7.5, -40), vec3(2, 15, 40), vec3(0.7f, 0.7f, 0.7f));
-
-    // [수정] Room 2 오른쪽 벽을 Room 1 오른쪽 벽(rightWall)과 동일한 스펙으로 생성
-    // 위치(Z)는 -40, 회전각 -90도, 크기 및 구멍 크기는 위쪽 rightWall과 동일
-    room2RightHole = new WallWithHole(vec3(20, 7.5, -40), vec3(40, 15, 2), vec3(4, 4, 4), vec3(0.7f, 0.7f, 0.7f), -90.0f);
-
-    room2Top = new Cube(vec3(0.0f, 15.5f, -40.0f), vec3(40.0f, 1.0f, 40.0f), vec3(0.6f, 0.6f, 0.6f));
-
-   
-    
-
-    // 아나모픽 퍼즐용 박스
-    rotatedBox = new Cube(vec3(1.8f, 5.2f, -42.0f), vec3(4.6f, 4.6f, 4.6f), vec3(1.0f, 1.0f, 1.0f));
-    rotatedBox->rotation = vec3(95.0f, 67.0f, 18.0f);
-    rotatedBox->isStatic = true;
-    rotatedBox->SetTextures("Data/redcube.bmp", "Data/bluecube.bmp", "Data/yellowcube.bmp");
-    
-    // Room 2 버튼
-    btnRoom2 = new Button(vec3(20.0f, 5.5f, -40.0f), rotatedBox);
-
-    myPuzzle.Init(textureFilePath);
+void InitObjects() {
+    TaskGraph graph;
+
+    graph.add("objects", [] {
+        unitCube.Init();
+        sphereMesh.Init();
+        debrisField.Init(debris, NUM_DEBRIS);
+        particleStream.Init(particles, NUM_PARTICLES, "../Data/Particle64.bmp");
+        shadowMapper.Init();
+        InitSkybox();
+        myCube = new Cube(vec3(5, 5, 5), vec3(2, 2, 2), vec3(0.8f, 0.6f, 0.4f));
+        myCube->isStatic = false;
+        mySphere = new Sphere(vec3(-5, 5, 5), vec3(2, 2, 2), vec3(0.2f, 0.6f, 1.0f));
+        mySphere->isStatic = false;
+        floorObj = new Cube(vec3(0, -0.5, 0), vec3(40, 1, 40), vec3(0.8f, 0.8f, 0.8f));
+
+        // [Room 1] 벽 생성
+        leftWall = new WallWithHole(vec3(-20, 7.5, 0), vec3(40, 15, 2), vec3(4, 4, 4), vec3(0.7f, 0.7f, 0.7f), 90.0f);
+        rightWall = new WallWithHole(vec3(20, 7.5, 0), vec3(40, 15, 2), vec3(4, 4, 4), vec3(0.7f, 0.7f, 0.7f), -90.0f);
+
+        backWall = new Cube(vec3(0, 7.5, 20), vec3(40, 15, 2), vec3(0.7f, 0.7f, 0.7f));
+        ceilingObj = new Cube(vec3(0, 15.5, 0), vec3(40, 1, 40), vec3(0.8f, 0.8f, 0.8f));
+
+        frontWallLeft = new Cube(vec3(-12, 7.5, -20), vec3(16, 15, 2), vec3(0.7f, 0.7f, 0.7f));
+        frontWallRight = new Cube(vec3(12, 7.5, -20), vec3(16, 15, 2), vec3(0.7f, 0.7f, 0.7f));
+        frontDoorTop = new Cube(vec3(0, 12.5, -20), vec3(8, 5, 2), vec3(0.7f, 0.7f, 0.7f));
+
+        exitDoor = new Cube(vec3(0, 5, -20), vec3(8, 10, 1), vec3(0.3f, 0.0f, 0.0f));
+
+        btnLeft = new Button(vec3(-20.0f, 5.5f, 0.0f), mySphere);
+        btnRight = new Button(vec3(20.0f, 5.5f, 0.0f), myCube);
+
+        // [Room 2] 객체 초기화
+        room2Floor = new Cube(vec3(0, -0.5, -40), vec3(40, 1, 40), vec3(0.8f, 0.8f, 0.8f));
+        room2Back = new Cube(vec3(0, 7.5, -60), vec3(40, 15, 2), vec3(0.7f, 0.7f, 0.7f));
+
+        // 왼쪽 벽은 기존처럼 일반 Cube로 유지 (원하시면 WallWithHole로 변경 가능)
+        room2Left = new Cube(vec3(-20, 7.5, -40), vec3(2, 15, 40), vec3(0.7f, 0.7f, 0.7f));
+
+        // [수정] Room 2 오른쪽 벽을 Room 1 오른쪽 벽(rightWall)과 동일한 스펙으로 생성
+        // 위치(Z)는 -40, 회전각 -90도, 크기 및 구멍 크기는 위쪽 rightWall과 동일
+        room2RightHole = new WallWithHole(vec3(20, 7.5, -40), vec3(40, 15, 2), vec3(4, 4, 4), vec3(0.7f, 0.7f, 0.7f), -90.0f);
+
+        room2Top = new Cube(vec3(0.0f, 15.5f, -40.0f), vec3(40.0f, 1.0f, 40.0f), vec3(0.6f, 0.6f, 0.6f));
+
+        // 아나모픽 퍼즐용 박스
+        rotatedBox = new Cube(vec3(1.8f, 5.2f, -42.0f), vec3(4.6f, 4.6f, 4.6f), vec3(1.0f, 1.0f, 1.0f));
+        rotatedBox->rotation = vec3(95.0f, 67.0f, 18.0f);
+        rotatedBox->isStatic = true;
+        rotatedBox->SetTextures("Data/redcube.bmp", "Data/bluecube.bmp", "Data/yellowcube.bmp");
+
+        // Room 2 버튼
+        btnRoom2 = new Button(vec3(20.0f, 5.5f, -40.0f), rotatedBox);
+
+        // [포털] 두 방은 z = -20 문 구멍 (x -4~4, y 0~10) 으로만 이어짐. 옆벽 구멍은 바깥으로 나가므로 포털 아님
+        room1Cell = sceneCuller.AddCell(vec3(-21.0f, -1.0f, -20.0f), vec3(21.0f, 16.0f, 21.0f));
+        room2Cell = sceneCuller.AddCell(vec3(-21.0f, -1.0f, -61.0f), vec3(21.0f, 16.0f, -20.0f));
+        doorPortal = sceneCuller.AddPortal(room1Cell, room2Cell,
+            { vec3(-4.0f, 0.0f, -20.0f), vec3(4.0f, 0.0f, -20.0f), vec3(4.0f, 10.0f, -20.0f), vec3(-4.0f, 10.0f, -20.0f) });
+    }, TaskGraph::MAIN_THREAD);
+
+    graph.add("puzzle texture", [] { myPuzzle.RequestTexture(textureFilePath); }, TaskGraph::MAIN_THREAD);
+    graph.add("puzzle pieces", [] { myPuzzle.GeneratePieces(); });
+
+    // 버니 LOD (PLY 는 첫 실행에만 파싱, 이후 바이너리 캐시). 레벨마다 따로 준비
+    vector<string> bunnyFiles;
+    bunnyFiles.push_back("../Data/bunny/bun_zipper.ply");
+    bunnyFiles.push_back("../Data/bunny/bun_zipper_res2.ply");
+    bunnyFiles.push_back("../Data/bunny/bun_zipper_res3.ply");
+    bunnyFiles.push_back("../Data/bunny/bun_zipper_res4.ply");
+    bunnyLOD.Begin(bunnyFiles);
+    int bunnyLevels[4];
+    for (int i = 0; i < 4; i++) bunnyLevels[i] = graph.add("bunny level", [i] { bunnyLOD.PrepareLevel(i); });
+    graph.add("bunny upload", [] {
+        if (!bunnyLOD.Upload()) return;
+        // Room 1 장식용 버니는 가장 세밀한 레벨
+        bunny = new MeshObject(&bunnyLOD.Level(0), vec3(-14.0f, 2.0f, 14.0f), 4.0f, vec3(0.85f, 0.75f, 0.6f));
+        bunny->rotation.y = 135.0f;
+
+        // Room 2 양쪽 바닥에 버니 무리 (퍼즐이 있는 가운데는 비워둠)
+        bunnyField.SetLOD(&bunnyLOD);
+        int n = 0;
+        for (float z = -58.0f; z <= -22.0f; z += 1.5f) {
+            for (float x = 9.0f; x <= 18.0f; x += 1.5f, n++) {
+                float tint = 0.1f * ((n * 7) % 5) / 4.0f;
+                bunnyField.Add(vec3(-x, 0.0f, z), (float)((n * 37) % 360), 1.0f, vec3(0.8f + tint, 0.7f, 0.55f + tint));
+                bunnyField.Add(vec3(x, 0.0f, z), (float)((n * 53) % 360), 1.0f, vec3(0.75f, 0.7f + tint, 0.6f));
+            }
+        }
+    }, TaskGraph::MAIN_THREAD, { bunnyLevels[0], bunnyLevels[1], bunnyLevels[2], bunnyLevels[3] });
+
+    // Room 1 반대편 구석의 대리석 석상 (ASE, 텍스처는 *BITMAP 이름으로 Data 폴더에서)
+    bool statueParsed = false;
+    int statueParse = graph.add("statue parse", [&] { statueParsed = statueMesh.Prepare("../Data/statue.ASE"); });
+    graph.add("statue upload", [&] {
+        if (!statueParsed || !statueMesh.Upload("../Data/")) return;
+        statue = new TexturedMeshObject(&statueMesh, vec3(14.0f, 2.5f, 14.0f), 5.0f, vec3(1.0f, 1.0f, 1.0f));
+        statue->rotation.y = -135.0f;
+    }, TaskGraph::MAIN_THREAD, { statueParse });
+
+    // 하늘을 도는 우주선 편대 (3DS 재질의 POLYSHIP.JPG 는 없으므로 BMP 텍스처로 대체)
+    bool shipParsed = false;
+    int shipParse = graph.add("ship parse", [&] { shipParsed = shipMesh.Prepare("../Data/spaceship.3DS"); });
+    graph.add("ship upload", [&] {
+        if (shipParsed && shipMesh.Upload("../Data/", "../Data/spaceshiptexture.bmp"))
+            shipFleet.Init(&shipMesh, 12, 5, 3.0f);
+    }, TaskGraph::MAIN_THREAD, { shipParse });
+
+    // 방 밖 바닥을 덮는 모프 점 구름 (방이 열리는 연출부터 보임)
+    bool morphLoaded = false;
+    int morphLoad = graph.add("morph targets", [&] {
+        morphLoaded = morphTargets.load("../Data/Sphere.txt") && morphTargets.load("../Data/Torus.txt") && morphTargets.load("../Data/Tube.txt");
+    });
+    graph.add("morph swarm", [&] {
+        if (morphLoaded) morphSwarm.Init(&morphTargets, 40, 40, 3.0f, vec3(-58.5f, 2.0f, -78.5f), 2.0f);
+    }, TaskGraph::MAIN_THREAD, { morphLoad });
+
+    // 방 주변 지형 (256 x 256 월드, 방 바닥 밑으로는 눌러서 바닥을 뚫지 않게)
+    bool terrainLoaded = false;
+    int terrainLoad = graph.add("terrain field", [&] {
+        terrainLoaded = terrainField.load("../Data/Terrain.raw", 1024, -128.0f, -148.0f, 256.0f, 20.0f, -18.0f);
+        if (terrainLoaded) terrainField.flattenRect(-22.0f, -62.0f, 22.0f, 22.0f, -1.5f, 16.0f);
+    });
+    graph.add("terrain upload", [&] {
+        if (terrainLoaded) terrain.Init(&terrainField, 6, 12.0f);
+    }, TaskGraph::MAIN_THREAD, { terrainLoad });
+
+    // 지형 골짜기를 채우는 물 (Water.ini 가 없으면 기본 151 x 151)
+    int waterLoad = graph.add("water sim", [] {
+        waterConfig.load("../Data/Water.ini");
+        waterSim.Init(waterConfig.gridX, waterConfig.gridZ, 1.0f - waterConfig.density, 0);
+    });
+    graph.add("water upload", [] {
+        water.Init(&waterSim, waterConfig, vec3(-75.0f, -6.5f, -95.0f), 150.0f);
+    }, TaskGraph::MAIN_THREAD, { waterLoad });
+
+    // 방 위 하늘의 행성들 (밉 꼬리만 먼저, 더 세밀한 밉은 보이는 크기에 맞춰 스트리밍)
+    mipStreamer.Start(2);
+    planets.Init(&mipStreamer);
+    vector<string> jupiterFiles, moonFiles, plutoFiles;
+    jupiterFiles.push_back("../Data/Planets/Jupiter2_1k.jpg");
+    jupiterFiles.push_back("../Data/Planets/Jupiter2_2k.jpg");
+    jupiterFiles.push_back("../Data/Planets/Jupiter2_4k.jpg");
+    moonFiles.push_back("../Data/Planets/Moon_1k.jpg");
+    moonFiles.push_back("../Data/Planets/Moon_2k.jpg");
+    plutoFiles.push_back("../Data/Planets/Pluto_1k.jpg");
+    plutoFiles.push_back("../Data/Planets/Pluto_2k.jpg");
+    MipStreamer::Tail jupiterTail, moonTail, plutoTail;
+    int jupiterDecode = graph.add("jupiter tail", [&] { MipStreamer::PrepareTail(jupiterFiles, jupiterTail); });
+    int moonDecode = graph.add("moon tail", [&] { MipStreamer::PrepareTail(moonFiles, moonTail); });
+    int plutoDecode = graph.add("pluto tail", [&] { MipStreamer::PrepareTail(plutoFiles, plutoTail); });
+    graph.add("planet upload", [&] {
+        planets.Add(mipStreamer.Add(jupiterTail), vec3(-24.0f, 38.0f, -40.0f), 9.0f, 6.0f, 3.0f);
+        planets.Add(mipStreamer.Add(moonTail), vec3(22.0f, 34.0f, -6.0f), 4.0f, -4.0f, 6.5f);
+        planets.Add(mipStreamer.Add(plutoTail), vec3(20.0f, 44.0f, -36.0f), 2.5f, 9.0f, 17.0f);
+    }, TaskGraph::MAIN_THREAD, { jupiterDecode, moonDecode, plutoDecode });
+
+    graph.run();
+
+    // 작업별 시간 (시작 시각 기준 정렬, main = GL 스레드)
+    vector<TaskGraph::Timing> timings = graph.timings();
+    sort(timings.begin(), timings.end(), [](const TaskGraph::Timing& a, const TaskGraph::Timing& b) { return a.startMs < b.startMs; });
+    cout << "[Startup] InitObjects " << graph.wallMs() << " ms (tasks " << graph.busyMs() << " ms, "
+        << graph.busyMs() / std::max(graph.wallMs(), 0.001) << "x parallel)" << endl;
+    for (auto& t : timings)
+        cout << "  " << (t.mainThread ? "main " : "pool ") << t.name << ": +" << t.startMs << " ms, " << t.ms << " ms" << endl;
     srand(time(NULL));
 }
 
@@ -1005,22 +5014,13 @@ void UpdateGame() {
     }
 }
 
+// 상태(조명 X, 깊이 쓰기 X, 하늘 텍스처 REPLACE) 는 렌더 큐가 맞춤 -> SubmitSkybox
 void DrawSkybox(vec3 pos) {
-    if (skyTextureID == 0) return;
-
     glPushMatrix();
 
     // 전달받은 위치로 스카이박스 이동 (항상 카메라 중심)
     glTranslatef(pos.x, pos.y, pos.z);
 
-    // 2. 렌더링 설정 끄기 (조명 X, 깊이 쓰기 X)
-    glDisable(GL_LIGHTING);
-    glDepthMask(GL_FALSE);
-
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, skyTextureID);
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
-
     float s = 40.0f; // [중요] 크기를 zFar(100.0)보다 작게 설정 (잘림 방지)
 
     // 3. 정육면체 그리기 (안쪽을 바라보도록 텍스처 매핑)
@@ -1057,15 +5057,25 @@ void DrawSkybox(vec3 pos) {
     glTexCoord2f(0.0f, 1.0f); glVertex3f(-s, s, -s);
     glEnd();
 
-    // 4. 설정 복구
-    glDisable(GL_TEXTURE_2D);
-    glDepthMask(GL_TRUE); // 깊이 쓰기 다시 켜기
-    glEnable(GL_LIGHTING);
-
     glPopMatrix();
 }
 
+// 하늘 패스는 다른 모든 것보다 먼저 (깊이를 쓰지 않으므로 뒤에 그린 것이 덮음)
+void SubmitSkybox(RenderQueue& queue, vec3 pos) {
+    if (skyTextureID == 0) return;
+    RenderState state;
+    state.lighting = false;
+    state.depthWrite = false;
+    state.texture = skyTextureID;
+    state.envMode = GL_REPLACE;
+    queue.Add(PASS_SKY, state, 0.0f, [pos] { DrawSkybox(pos); });
+}
+
 void DrawScene() {
+    // 백그라운드에서 디코딩이 끝난 텍스처 업로드
+    if (textureStreamer.Pump() > 0 && textureStreamer.IsIdle()) textureRegistry.PrintStats();
+    mipStreamer.Update();
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glMatrixMode(GL_MODELVIEW); glLoadIdentity();
 
@@ -1100,81 +5110,7 @@ void DrawScene() {
             endCamUp.x, endCamUp.y, endCamUp.z);
     }
 
-    // [수정] 결정된 카메라 위치를 전달하여 그림
-    DrawSkybox(renderPos);
-
-    // [드로잉] Room 1 객체들
-    // [수정] Room 1이 폭발하지 않았을 때만 그림
-    if (!isRoom1Exploded) {
-        floorObj->Draw();
-        backWall->Draw();
-        ceilingObj->Draw();
-        frontWallLeft->Draw();
-        frontWallRight->Draw();
-        frontDoorTop->Draw();
-
-        if (!isLevelClear) exitDoor->Draw();
-
-        leftWall->Draw(); btnLeft->Draw();
-        rightWall->Draw(); btnRight->Draw();
-    }
-
-    // [Room 2 및 폭발 효과]
-    // 폭발 상태가 아니면(일반, 이동중) 방을 그림
-    if (!isRoom2Exploded) {
-        room2Floor->Draw();
-        room2Back->Draw();
-        room2Left->Draw();
-        room2RightHole->Draw(); // 구멍 벽
-        room2Top->Draw();
-        if (!isPuzzleClear) {
-            // [클리어 전] 퍼즐 조각들만 보임 (박스 안 보임)
-            myPuzzle.Draw();
-        }
-        else {
-            // [클리어 후] 진짜 큐브(박스)만 보임 (퍼즐 안 보임)
-            if (rotatedBox) rotatedBox->Draw();
-        }
-    }
-
-    // 2. 버튼과 기폭제 큐브 그리기
-    // 폭발 전까지만 그리기
-    if (currentState != STATE_EXPLODED) {
-        btnRoom2->Draw();
-    }
-
-    // 3. 폭발 효과 (파티클 & 파편) 그리기
-    if (fuel > 0 && currentState == STATE_EXPLODED) {
-        // --- 파티클 그리기 ---
-        glPushMatrix();
-        glDisable(GL_LIGHTING); glDisable(GL_DEPTH_TEST);
-        glPointSize(3.0f);
-        glBegin(GL_POINTS);
-        for (int i = 0; i < NUM_PARTICLES; i++) {
-            glColor3fv(particles[i].color);
-            glVertex3fv(particles[i].position);
-        }
-        glEnd();
-
-        // --- 파편 그리기 ---
-        glEnable(GL_LIGHTING); glEnable(GL_DEPTH_TEST);
-        for (int i = 0; i < NUM_DEBRIS; i++) {
-            glColor3fv(debris[i].color);
-            glPushMatrix();
-            glTranslatef(debris[i].position[0], debris[i].position[1], debris[i].position[2]);
-            glRotatef(debris[i].orientation[0], 1, 0, 0);
-            glRotatef(debris[i].orientation[1], 0, 1, 0);
-            glRotatef(debris[i].orientation[2], 0, 0, 1);
-            glScalef(debris[i].scale[0], debris[i].scale[1], debris[i].scale[2]);
-            glBegin(GL_TRIANGLES);
-            glNormal3f(0.0, 0.0, 1.0);
-            glVertex3f(0.0, 0.5, 0.0); glVertex3f(-0.25, 0.0, 0.0); glVertex3f(0.25, 0.0, 0.0);
-            glEnd();
-            glPopMatrix();
-        }
-        glPopMatrix();
-    }
-
+    // 잡은 물체 위치/크기 갱신 (컬링 경계에 이번 프레임 값이 들어가도록 그리기 전에)
     if (heldObject && currentState == STATE_NORMAL) {
         float minDist = 10000.0f;
 
@@ -1274,29 +5210,138 @@ void DrawScene() {
         heldObject->velocity = vec3(0);
     }
 
-    // [그림자 준비]
-    float lightPos[] = { 0.0f, 30.0f, 0.0f, 1.0f }; // 조명 위치
-    float floorPlane[] = { 0.0f, 1.0f, 0.0f, 0.0f }; // 바닥 평면 (y=0)
-    float shadowMat[16];
-    SetShadowMatrix(shadowMat, lightPos, floorPlane);
+    // 이번 프레임에 그릴 것을 렌더 큐에 모은 뒤 상태별로 정렬해서 한 번에 그림 (아래 Execute)
+    // 셰이더/텍스처를 스스로 다루는 시스템은 custom 항목
+    float seconds = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
+    RenderQueue& queue = renderQueue;
+    queue.Begin();
+    sphereMesh.BeginFrame();
 
-    // [그림자 그리기]
-    // 바닥과 겹침 방지(Z-Fighting)를 위해 아주 살짝 띄움 (Y축 +0.01)
-    glPushMatrix();
-    glTranslatef(0.0f, 0.01f, 0.0f);
+    // [수정] 결정된 카메라 위치를 전달하여 그림
+    SubmitSkybox(queue, renderPos);
+    queue.AddCustom(PASS_OPAQUE, RenderState(), 0.0f, [renderPos] { terrain.Draw(renderPos); });
+    queue.AddCustom(PASS_OPAQUE, RenderState(), 0.0f, [seconds] { shipFleet.Draw(seconds); });
+    if (currentState != STATE_NORMAL) queue.AddCustom(PASS_OPAQUE, RenderState(), 0.0f, [seconds] { morphSwarm.Draw(seconds); });
+    if (currentState != STATE_NORMAL) queue.AddCustom(PASS_OPAQUE, RenderState(), 0.0f, [renderPos, seconds] { planets.Draw(renderPos, seconds); });
+
+    // [드로잉] 그릴 오브젝트 모으기 (구멍 벽은 조각 큐브 단위로)
+    static vector<GameObject*> objects;
+    objects.clear();
+    // [수정] Room 1이 폭발하지 않았을 때만 그림
+    if (!isRoom1Exploded) {
+        objects.push_back(floorObj);
+        objects.push_back(backWall);
+        objects.push_back(ceilingObj);
+        objects.push_back(frontWallLeft);
+        objects.push_back(frontWallRight);
+        objects.push_back(frontDoorTop);
+
+        if (!isLevelClear) objects.push_back(exitDoor);
+
+        for (Cube* c : leftWall->collisionCubes) objects.push_back(c);
+        for (Cube* c : rightWall->collisionCubes) objects.push_back(c);
+
+        // [수정] Room 1이 폭발하지 않았을 때만 큐브/구체 그림
+        objects.push_back(myCube);
+        objects.push_back(mySphere);
+        if (bunny) objects.push_back(bunny);
+        if (statue) objects.push_back(statue);
+    }
 
-    if (myCube) myCube->DrawShadow(shadowMat);
-    if (mySphere) mySphere->DrawShadow(shadowMat);
-    // [추가] 새 큐브 그림자 (폭발 전까지만)
-    if (isPuzzleClear && rotatedBox && !isRoom2Exploded) rotatedBox->DrawShadow(shadowMat);
-    // glDisable(GL_BLEND);
-    glPopMatrix();
+    // [Room 2 및 폭발 효과]
+    // 폭발 상태가 아니면(일반, 이동중) 방을 그림
+    if (!isRoom2Exploded) {
+        objects.push_back(room2Floor);
+        objects.push_back(room2Back);
+        objects.push_back(room2Left);
+        for (Cube* c : room2RightHole->collisionCubes) objects.push_back(c); // 구멍 벽
+        objects.push_back(room2Top);
+        // [클리어 후] 진짜 큐브(박스)만 보임 (퍼즐 안 보임)
+        if (isPuzzleClear && rotatedBox) objects.push_back(rotatedBox);
+    }
+
+    // [컬링] 움직인 것만 경계를 다시 쓰고 전체를 한 번에 절두체 검사 -> 보이는 것만 큐에
+    sceneCuller.Begin();
+    for (GameObject* obj : objects) obj->UpdateBounds();
+    btnLeft->UpdateBounds(); btnRight->UpdateBounds(); btnRoom2->UpdateBounds();
+    myPuzzle.UpdateBounds();
+    Frustum frustum;
+    frustum.FromCurrentMatrices();
+    // 문이 닫혀 있으면 (exitDoor) 포털도 닫힘
+    sceneCuller.SetPortalOpen(doorPortal, isLevelClear);
+    sceneCuller.Run(frustum, renderPos);
+
+    static vector<GameObject*> drawn;
+    drawn.clear();
+    for (GameObject* obj : objects) {
+        if (!sceneCuller.Test(obj->cullSlot)) continue;
+        obj->Submit(queue, renderPos);
+        drawn.push_back(obj);
+    }
 
-    // [수정] Room 1이 폭발하지 않았을 때만 큐브/구체 그림
     if (!isRoom1Exploded) {
-        myCube->Draw();
-        mySphere->Draw();
+        if (sceneCuller.Test(btnLeft->cullSlot)) btnLeft->Submit(queue, renderPos);
+        if (sceneCuller.Test(btnRight->cullSlot)) btnRight->Submit(queue, renderPos);
+    }
+
+    if (!isRoom2Exploded) {
+        // 버니 무리는 수가 많아 평면 그림자는 생략 (자체 LOD/컬링). Room 2 셀이 안 보이면 통째로 건너뜀
+        if (sceneCuller.CellVisible(room2Cell)) {
+            bunnyField.Update(renderPos, windowHeight, 45.0f);
+            queue.AddCustom(PASS_OPAQUE, RenderState(), 0.0f, [] { bunnyField.Draw(); });
+        }
+
+        // [클리어 전] 퍼즐 조각들만 보임 (박스 안 보임)
+        if (!isPuzzleClear) myPuzzle.Submit(queue, renderPos);
+    }
+
+    // 2. 버튼과 기폭제 큐브 그리기
+    // 폭발 전까지만 그리기
+    if (currentState != STATE_EXPLODED && sceneCuller.Test(btnRoom2->cullSlot)) {
+        btnRoom2->Submit(queue, renderPos);
+    }
+
+    // 3. 폭발 효과 (파티클 & 파편) 그리기
+    if (fuel > 0 && currentState == STATE_EXPLODED) {
+        // 파티클은 깊이 테스트 없이 더하기 합성이라 맨 위 (오버레이 패스)
+        RenderState overlay;
+        overlay.lighting = false;
+        overlay.depthTest = false;
+        queue.AddCustom(PASS_OVERLAY, overlay, 0.0f, [] { particleStream.Draw(); });
+        queue.AddCustom(PASS_OPAQUE, RenderState(), 0.0f, [] { debrisField.Draw(); });
+    }
+
+    // [그림자 준비]
+    float lightPos[] = { 0.0f, 30.0f, 0.0f, 1.0f }; // 조명 위치
+    static vector<GameObject*> casters;
+    casters.clear();
+    if (myCube) casters.push_back(myCube);
+    if (mySphere) casters.push_back(mySphere);
+    // [추가] 새 큐브 그림자 (폭발 전까지만)
+    if (isPuzzleClear && rotatedBox && !isRoom2Exploded) casters.push_back(rotatedBox);
+    if (bunny && !isRoom1Exploded) casters.push_back(bunny);
+    if (statue && !isRoom1Exploded) casters.push_back(statue);
+
+    if (shadowMapper.Ready()) {
+        // 구멍 벽도 드리움 (정적 층이라 한 번만). 조명이 천장 위에 있으므로 바닥/천장/앞벽은 받기만 함
+        if (!isRoom1Exploded) { casters.push_back(leftWall); casters.push_back(rightWall); }
+        if (!isRoom2Exploded) casters.push_back(room2RightHole);
+        // 두 방 바닥과 벽 아래쪽이 받는 영역
+        shadowMapper.SetLight(lightPos, vec3(-21.0f, 0.0f, -61.0f), vec3(21.0f, 8.0f, 21.0f));
+        shadowMapper.Update(casters);
+        shadowMapper.SubmitReceivers(queue, drawn);
     }
+    else {
+        float floorPlane[] = { 0.0f, 1.0f, 0.0f, 0.0f }; // 바닥 평면 (y=0)
+        float shadowMat[16];
+        SetShadowMatrix(shadowMat, lightPos, floorPlane);
+        for (GameObject* obj : casters) obj->SubmitShadow(queue, shadowMat);
+    }
+
+    // 반투명 물은 불투명한 것들 다음에 (반투명 패스에서 가장 가까운 것으로 취급해 잔상보다 뒤)
+    queue.AddCustom(PASS_TRANSPARENT, RenderState(), 0.0f, [] { water.Draw(); });
+
+    queue.Execute();
 
     // UI 드로잉
     glMatrixMode(GL_PROJECTION); glPushMatrix(); glLoadIdentity(); glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
@@ -1307,6 +5352,13 @@ void DrawScene() {
     glEnable(GL_DEPTH_TEST); glEnable(GL_LIGHTING); glMatrixMode(GL_PROJECTION); glPopMatrix(); glMatrixMode(GL_MODELVIEW);
 
     glutSwapBuffers();
+
+    // 시작부터 첫 화면까지 (InitObjects 의 작업별 시간은 시작 로그에)
+    if (!firstFrameLogged) {
+        firstFrameLogged = true;
+        float ms = chrono::duration<float, milli>(chrono::steady_clock::now() - programStart).count();
+        cout << "[Startup] first frame " << ms << " ms" << endl;
+    }
 }
 
 
@@ -1314,6 +5366,7 @@ void MyTimer(int val) {
     UpdateGame();
     // [추가] 파티클 물리 업데이트
     UpdateParticles();
+    water.Update();
 
     if (heldObject != myCube) {
         myCube->UpdatePhysics(0.02f, GetFloorHeightAt(myCube->position, myCube->scale));
@@ -1444,6 +5497,12 @@ void MyKeyboard(unsigned char key, int x, int y) {
     case 's': mainCamera.ProcessKey(1, isLevelClear); break;
     case 'a': mainCamera.ProcessKey(2, isLevelClear); break;
     case 'd': mainCamera.ProcessKey(3, isLevelClear); break;
+    case 'l': bunnyField.PrintStats(); break;
+    case 'm': mipStreamer.PrintStats(); break;
+    case 'r': renderQueue.PrintStats(); break;
+    case 'c': sceneCuller.PrintStats(); break;
+    case 'h': shadowMapper.PrintStats(); break;
+    case 'p': particleStream.Benchmark(1000000, 10); break;
     case 27: exit(0); break;
     }
 }
@@ -1457,6 +5516,7 @@ void MyReshape(int w, int h) {
 }
 
 int main(int argc, char** argv) {
+    programStart = chrono::steady_clock::now();
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(windowWidth, windowHeight);
@@ -1467,6 +5527,14 @@ int main(int argc, char** argv) {
     glEnable(GL_LIGHTING); glEnable(GL_LIGHT0); glEnable(GL_COLOR_MATERIAL);
     GLfloat pos[] = { 0, 30, 0, 1 }; glLightfv(GL_LIGHT0, GL_POSITION, pos);
 
+    // Data 폴더를 묶은 팩이 있으면 이후 모든 매핑 로드는 팩에서 (없으면 기존처럼 파일별로)
+    if (assetPack.open("../Data/Assets.pak")) {
+        AssetPack::Mount(&assetPack);
+        cout << "[AssetPack] ../Data/Assets.pak: " << assetPack.header().entryCount << " files" << endl;
+    }
+
+    textureStreamer.Start();
+    textureStreamer.onResident = [](GLuint id, size_t bytes) { textureRegistry.OnResident(id, bytes); };
     InitObjects();
 
     glutSetCursor(GLUT_CURSOR_NONE);
@@ -0,0 +1,286 @@
+//-----------------------------------------------------------------------------
+//           Name: baker_main.cpp
+//    Description: Data 폴더의 이미지를 BC1/BC3 밉 체인 캐시(.txc)로 굽는 오프라인 도구
+//-----------------------------------------------------------------------------
+// 사용법: TextureBaker [dataDir=../Data] [-f]
+//   dataDir/Cache/<원본 파일명>.txc 로 저장. 캐시가 원본보다 새것이면 건너뜀 (-f: 전부 다시 굽기)
+//   알파가 있는 이미지는 BC3, 나머지는 BC1. 그레이 알파 전용 TGA(GL_ALPHA)는 원본 그대로 둠.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <direct.h>
+#else
+#include <dirent.h>
+#endif
+
+#include "bmp_view.h"
+#include "tga.h"
+#include "ppm.h"
+#include "bc_encoder.h"
+#include "texture_cache.h"
+
+static std::string ToLower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+static std::vector<std::string> ListImages(const std::string& dir)
+{
+    std::vector<std::string> names;
+#ifdef _WIN32
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA((dir + "\\*").c_str(), &fd);
+    if (h != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) names.push_back(fd.cFileName);
+        } while (FindNextFileA(h, &fd));
+        FindClose(h);
+    }
+#else
+    DIR* d = opendir(dir.c_str());
+    if (d)
+    {
+        while (dirent* e = readdir(d))
+            if (e->d_name[0] != '.') names.push_back(e->d_name);
+        closedir(d);
+    }
+#endif
+
+    std::vector<std::string> files;
+    for (auto& name : names)
+    {
+        size_t dot = name.find_last_of('.');
+        if (dot == std::string::npos) continue;
+        std::string ext = ToLower(name.substr(dot));
+        if (ext == ".bmp" || ext == ".tga" || ext == ".ppm" || ext == ".pgm") files.push_back(name);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static bool GetModifiedTime(const std::string& path, time_t& t)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    t = st.st_mtime;
+    return true;
+}
+
+static void MakeDir(const std::string& path)
+{
+#ifdef _WIN32
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+}
+
+// 원본 이미지를 bottom-up RGBA8 로 디코딩
+// 반환: 0 성공, 1 실패, 2 굽지 않는 포맷
+static int DecodeRGBA(const std::string& path, std::vector<unsigned char>& rgba, int& width, int& height, bool& hasAlpha)
+{
+    std::string ext = ToLower(path.substr(path.find_last_of('.')));
+    hasAlpha = false;
+
+    if (ext == ".tga")
+    {
+        tgaImageFile tga;
+        if (tga.load(path.c_str()) != tgaImageFile::TGA_NO_ERROR) return 1;
+        if (tga.m_texFormat == GL_ALPHA) return 2;
+
+        width = tga.m_nImageWidth;
+        height = tga.m_nImageHeight;
+        int channels = tga.m_nImageBits / 8;
+        rgba.resize((size_t)width * height * 4);
+        for (size_t i = 0; i < (size_t)width * height; i++)
+        {
+            const unsigned char* s = tga.m_nImageData + i * channels;
+            unsigned char* d = &rgba[i * 4];
+            d[0] = s[0]; d[1] = s[1]; d[2] = s[2];
+            d[3] = (channels == 4) ? s[3] : 255;
+            if (d[3] != 255) hasAlpha = true;
+        }
+        return 0;
+    }
+
+    if (ext == ".ppm" || ext == ".pgm")
+    {
+        ppmImageFile ppm;
+        if (ppm.load(path.c_str()) != ppmImageFile::PPM_NO_ERROR) return 1;
+        width = ppm.m_nImageWidth;
+        height = ppm.m_nImageHeight;
+        rgba.resize((size_t)width * height * 4);
+        for (size_t i = 0; i < (size_t)width * height; i++)
+        {
+            memcpy(&rgba[i * 4], ppm.m_nImageData + i * 3, 3);
+            rgba[i * 4 + 3] = 255;
+        }
+        return 0;
+    }
+
+    BmpView bmp;
+    if (bmp.open(path.c_str()) != BmpView::BMP_NO_ERROR) return 1;
+    bmp.normalize();
+    width = bmp.width();
+    height = bmp.height();
+    int channels = bmp.bitsPerPixel() / 8;
+    rgba.resize((size_t)width * height * 4);
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char* s = bmp.row(y);
+        unsigned char* d = &rgba[(size_t)y * width * 4];
+        for (int x = 0; x < width; x++, s += channels, d += 4)
+        {
+            d[0] = s[2]; d[1] = s[1]; d[2] = s[0];
+            d[3] = bmp.hasAlpha() ? s[3] : 255;
+            if (d[3] != 255) hasAlpha = true;
+        }
+    }
+    return 0;
+}
+
+// 밉 체인(1x1 까지)을 만들어 인코딩 후 캐시 파일로 기록. 반환: 기록한 바이트 수 (실패 시 0)
+static size_t Bake(const std::vector<unsigned char>& rgba, int width, int height, bool bc3, const std::string& outPath)
+{
+    std::vector<TexCacheLevel> levels;
+    std::vector<std::vector<unsigned char> > blocks;
+
+    std::vector<unsigned char> level = rgba;
+    int w = width, h = height;
+    for (;;)
+    {
+        blocks.push_back(BCEncoder::EncodeImage(level.data(), w, h, bc3));
+        TexCacheLevel info;
+        info.width = w;
+        info.height = h;
+        info.offset = 0;
+        info.size = (txc_uint32)blocks.back().size();
+        levels.push_back(info);
+
+        if ((w == 1 && h == 1) || (int)levels.size() == TEXCACHE_MAX_MIPS) break;
+        int nw, nh;
+        level = BCEncoder::Downsample(level.data(), w, h, nw, nh);
+        w = nw;
+        h = nh;
+    }
+
+    TexCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "TXC1", 4);
+    header.version = TEXCACHE_VERSION;
+    header.format = bc3 ? TEXCACHE_BC3 : TEXCACHE_BC1;
+    header.width = width;
+    header.height = height;
+    header.mipCount = (txc_uint32)levels.size();
+
+    // 레벨 데이터는 16바이트 경계에서 시작 (블록 크기가 8/16 이라 이후도 정렬 유지)
+    size_t offset = sizeof(TexCacheHeader) + sizeof(TexCacheLevel) * levels.size();
+    offset = (offset + 15) & ~(size_t)15;
+    size_t dataStart = offset;
+    for (auto& l : levels)
+    {
+        l.offset = (txc_uint32)offset;
+        offset += l.size;
+    }
+
+    FILE* fp = fopen(outPath.c_str(), "wb");
+    if (!fp) return 0;
+    static const unsigned char zeros[16] = { 0 };
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite(levels.data(), sizeof(TexCacheLevel), levels.size(), fp) == levels.size();
+    size_t pad = dataStart - sizeof(TexCacheHeader) - sizeof(TexCacheLevel) * levels.size();
+    if (ok && pad) ok = fwrite(zeros, 1, pad, fp) == pad;
+    for (size_t i = 0; ok && i < blocks.size(); i++)
+        ok = fwrite(blocks[i].data(), 1, blocks[i].size(), fp) == blocks[i].size();
+    fclose(fp);
+
+    if (!ok)
+    {
+        remove(outPath.c_str());
+        return 0;
+    }
+    return offset;
+}
+
+int main(int argc, char** argv)
+{
+    std::string dataDir = "../Data";
+    bool force = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0) force = true;
+        else dataDir = argv[i];
+    }
+
+    std::vector<std::string> images = ListImages(dataDir);
+    if (images.empty())
+    {
+        printf("no images in %s\n", dataDir.c_str());
+        return 1;
+    }
+    MakeDir(dataDir + "/Cache");
+
+    int baked = 0, skipped = 0, failed = 0;
+    size_t rawTotal = 0, bakedTotal = 0;
+    for (auto& name : images)
+    {
+        std::string src = dataDir + "/" + name;
+        std::string dst = TextureCacheFile::CachePathFor(src.c_str());
+
+        time_t srcTime, dstTime;
+        if (!force && GetModifiedTime(src, srcTime) && GetModifiedTime(dst, dstTime) && dstTime >= srcTime)
+        {
+            skipped++;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<unsigned char> rgba;
+        int width = 0, height = 0;
+        bool hasAlpha = false;
+        int err = DecodeRGBA(src, rgba, width, height, hasAlpha);
+        if (err == 2)
+        {
+            printf("  %-24s skipped (alpha-only)\n", name.c_str());
+            skipped++;
+            continue;
+        }
+        size_t bytes = (err == 0) ? Bake(rgba, width, height, hasAlpha, dst) : 0;
+        if (bytes == 0)
+        {
+            printf("  %-24s FAILED\n", name.c_str());
+            failed++;
+            continue;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        size_t raw = (size_t)width * height * (hasAlpha ? 4 : 3);
+        printf("  %-24s %5dx%-5d %s %8zu -> %8zu bytes (%.1f ms)\n",
+               name.c_str(), width, height, hasAlpha ? "BC3" : "BC1", raw, bytes, ms);
+        rawTotal += raw;
+        bakedTotal += bytes;
+        baked++;
+    }
+
+    printf("baked %d, up to date/skipped %d, failed %d", baked, skipped, failed);
+    if (baked) printf("  (%.1f MB raw level 0 -> %.1f MB with mips)", rawTotal / 1048576.0, bakedTotal / 1048576.0);
+    printf("\n");
+    return failed ? 1 : 0;
+}